@@ -0,0 +1,205 @@
+#include "batch.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "implementations/number_system.h"
+#include "util.h"
+
+/* number of lines that are read (and then calculated in parallel) at once */
+#define BATCH_CHUNK_LINES 1024
+
+#define BATCH_SEPARATORS " \t\r\n"
+
+/**
+ * A line of the input. The buffers are kept for the lines of the following chunks, so that they
+ * are only reallocated if a line is longer than all lines before.
+ */
+typedef struct batch_line {
+    char *text;  // the line (the operands and the operator point into it)
+    size_t text_capacity;
+    const char *z1;  // NULL if the line is empty
+    char op;
+    const char *z2;
+    uint64_t exponent;  // the value of z2 if op is '^'
+    const char *error;  // NULL if the line is valid
+    char *result;
+    size_t result_capacity;
+} batch_line;
+
+/**
+ * The lines of a chunk are distributed dynamically among the threads. The workers wait at the start
+ * barrier until the main thread has read the next chunk and at the end barrier until all lines of
+ * the chunk are calculated.
+ */
+typedef struct batch {
+    Implementation impl;
+    int base;
+    const char *alph;
+    batch_line lines[BATCH_CHUNK_LINES];
+    size_t line_count;
+    atomic_size_t next_line;
+    bool done;
+    pthread_barrier_t start;
+    pthread_barrier_t end;
+} batch;
+
+static const char *check_operand(const digit_tables *tables, int base, const char *z) {
+    if (base > 0 && *z == '-') z++;
+
+    size_t length = strlen(z);
+    if (length == 0) return "Missing digits of an operand.";
+    if (find_invalid_digit(tables, z, length) < length) {
+        return "An operand contains characters that are not contained in the alphabet.";
+    }
+    return NULL;
+}
+
+static const char *parse_line(batch *b, batch_line *line) {
+    char *save;
+    line->z1 = strtok_r(line->text, BATCH_SEPARATORS, &save);
+    if (line->z1 == NULL) return NULL;
+
+    const char *op = strtok_r(NULL, BATCH_SEPARATORS, &save);
+    line->z2 = strtok_r(NULL, BATCH_SEPARATORS, &save);
+    if (line->z2 == NULL || strtok_r(NULL, BATCH_SEPARATORS, &save) != NULL) {
+        return "Expected a line of the form \"z1 op z2\".";
+    }
+
+    line->op = *op;
+    if (op[1] != '\0' ||
+        !(line->op == '+' || line->op == '-' || line->op == '*' || line->op == '^')) {
+        return "Invalid operator.";
+    }
+
+    const number_system *system = get_number_system(b->base, b->alph);
+    const char *error = check_operand(&system->tables, b->base, line->z1);
+    if (error == NULL) error = check_operand(&system->tables, b->base, line->z2);
+    if (error == NULL && line->op == '^') {
+        exponent_status status = parse_exponent(system, line->z2, UINT64_MAX, &line->exponent);
+        if (status == EXPONENT_NEGATIVE) {
+            error = "The exponent must not be negative.";
+        } else if (status == EXPONENT_TOO_BIG) {
+            error = "The exponent is too big.";
+        } else if (max_needed_chars_pow(line->z1, line->exponent) == 0) {
+            error = "The power is too big.";
+        }
+    }
+    return error;
+}
+
+static void calculate_line(batch *b, batch_line *line) {
+    line->error = parse_line(b, line);
+    if (line->z1 == NULL || line->error != NULL) return;
+
+    size_t size;
+    if (line->op == '^') {
+        size = max_needed_chars_pow(line->z1, line->exponent);
+    } else if (line->op == '*') {
+        size = max_needed_chars_mul(line->z1, line->z2);
+    } else {
+        size = max_needed_chars_add_sub(line->z1, line->z2);
+    }
+    size++;
+    if (size > line->result_capacity) {
+        free(line->result);
+        line->result = malloc(size);
+        check_alloc(line->result, size, "result buffer");
+        line->result_capacity = size;
+    }
+
+    b->impl.func(b->base, b->alph, line->z1, line->z2, line->op, line->result);
+}
+
+static void calculate_lines(batch *b) {
+    size_t i;
+    while ((i = atomic_fetch_add(&b->next_line, 1)) < b->line_count) {
+        calculate_line(b, &b->lines[i]);
+    }
+}
+
+static void *batch_worker(void *arg) {
+    batch *b = arg;
+
+    while (true) {
+        pthread_barrier_wait(&b->start);
+        if (b->done) break;
+        calculate_lines(b);
+        pthread_barrier_wait(&b->end);
+    }
+
+    release_thread_resources();
+    return NULL;
+}
+
+bool run_batch(FILE *input, Implementation impl, int base, const char *alph, size_t thread_count) {
+    batch *b = calloc(1, sizeof(batch));
+    check_alloc(b, sizeof(batch), "batch");
+    b->impl = impl;
+    b->base = base;
+    b->alph = alph;
+
+    // the main thread calculates lines as well
+    size_t worker_count = thread_count - 1;
+    pthread_t *workers = malloc(thread_count * sizeof(pthread_t));
+    check_alloc(workers, thread_count * sizeof(pthread_t), "batch workers");
+    if (worker_count > 0) {
+        pthread_barrier_init(&b->start, NULL, thread_count);
+        pthread_barrier_init(&b->end, NULL, thread_count);
+        for (size_t i = 0; i < worker_count; i++) {
+            if (pthread_create(&workers[i], NULL, batch_worker, b) != 0) {
+                abort_err("Could not create a batch worker thread.\n");
+            }
+        }
+    }
+
+    bool success = true;
+    size_t line_number = 0;
+    do {
+        b->line_count = 0;
+        while (b->line_count < BATCH_CHUNK_LINES) {
+            batch_line *line = &b->lines[b->line_count];
+            if (getline(&line->text, &line->text_capacity, input) == -1) break;
+            b->line_count++;
+        }
+
+        atomic_store(&b->next_line, 0);
+        if (worker_count > 0) pthread_barrier_wait(&b->start);
+        calculate_lines(b);
+        if (worker_count > 0) pthread_barrier_wait(&b->end);
+
+        // the results are printed in the order of the lines
+        for (size_t i = 0; i < b->line_count; i++) {
+            batch_line *line = &b->lines[i];
+            line_number++;
+            if (line->error != NULL) {
+                fflush(stdout);
+                fprintf(stderr, "Line %zu: %s\n", line_number, line->error);
+                success = false;
+            } else if (line->z1 != NULL) {
+                fprintf(stdout, "%s %c %s = %s\n", line->z1, line->op, line->z2, line->result);
+            }
+        }
+    } while (b->line_count == BATCH_CHUNK_LINES);
+
+    if (worker_count > 0) {
+        b->done = true;
+        pthread_barrier_wait(&b->start);
+        for (size_t i = 0; i < worker_count; i++) {
+            pthread_join(workers[i], NULL);
+        }
+        pthread_barrier_destroy(&b->start);
+        pthread_barrier_destroy(&b->end);
+    }
+
+    for (size_t i = 0; i < BATCH_CHUNK_LINES; i++) {
+        free(b->lines[i].text);
+        free(b->lines[i].result);
+    }
+    free(workers);
+    free(b);
+
+    return success;
+}
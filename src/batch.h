@@ -0,0 +1,26 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "implementations.h"
+
+/**
+ * @brief Calculates one operation per line of the input and prints the results in order
+ *
+ * Every line has the form "z1 op z2" (separated by spaces), empty lines are skipped. The result of
+ * a line is printed like the result of a single calculation, invalid lines are reported on stderr.
+ * The number system and all buffers are reused for all lines.
+ *
+ * @param input         The input stream
+ * @param impl          The implementation
+ * @param base          The base.           base > 1 || base < -1
+ * @param alph          The alphabet.       Must not contain '-' if base > 0 or any duplicate
+ *                                          values. len(alph) == abs(base)
+ * @param thread_count  The number of threads that calculate the lines (at least 1)
+ * @return              false if there were invalid lines
+ */
+bool run_batch(FILE *input, Implementation impl, int base, const char *alph, size_t thread_count);
+
+#endif
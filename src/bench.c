@@ -1,7 +1,27 @@
 #include "bench.h"
 
+#include <stdint.h>
+#include <string.h>
 #include <time.h>
 
+#include "implementations/impl_auto/impl_auto.h"
+#include "implementations/impl_limb/impl_limb.h"
+#include "implementations/impl_naive/impl_naive.h"
+#include "util.h"
+
+#define BENCH_SUITE_TIME_LIMIT 0.1L  // longer operands are skipped once a calculation takes longer
+#define BENCH_SUITE_CELL_TIME 1.0L   // the measurements of one length stop after about a second
+#define BENCH_SUITE_MIN_REPETITIONS 3
+
+#define BENCH_TUNE_MAX_LENGTH 4096  // longer operands are never calculated by the naive implementation
+#define BENCH_TUNE_REPETITIONS 15
+#define BENCH_TUNE_CONFIRMATIONS 2  // the following lengths whose measurements have to agree
+#define BENCH_TUNE_EXPONENT 4       // the exponent of the measured powers
+
+static const int suite_bases[] = {2, 10, 16, 64, -2, -10};
+static const char suite_operators[] = {'+', '-', '*'};
+static const char suite_alph[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz+/";
+
 static long double current_time() {
     struct timespec t;
     clock_gettime(CLOCK_MONOTONIC, &t);
@@ -20,3 +40,308 @@ long double bench(Implementation impl, size_t iterations, int base, const char *
 
     return (current_time() - t);
 }
+
+/**
+ * splitmix64, the operands are the same on every run
+ */
+static uint64_t next_random(uint64_t *state) {
+    uint64_t z = (*state += 0x9E3779B97F4A7C15);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+    return z ^ (z >> 31);
+}
+
+/**
+ * @brief Fill z with a random number of length digits without leading zeros
+ */
+static void random_operand(char *z, size_t length, const char *alph, size_t base_abs,
+                           uint64_t *state) {
+    z[0] = alph[1 + next_random(state) % (base_abs - 1)];
+    for (size_t i = 1; i < length; i++) {
+        z[i] = alph[next_random(state) % base_abs];
+    }
+    z[length] = '\0';
+}
+
+static int compare_times(const void *a, const void *b) {
+    long double x = *(const long double *) a;
+    long double y = *(const long double *) b;
+    return (x > y) - (x < y);
+}
+
+typedef struct suite_result {
+    size_t repetitions;
+    long double min, median, p99;
+} suite_result;
+
+/**
+ * @brief Measure one calculation after an untimed warm-up call
+ *
+ * @return The time of the warm-up call. The measurements are skipped if it took longer than
+ *         BENCH_SUITE_TIME_LIMIT.
+ */
+static long double measure(implementation_t func, size_t max_repetitions, int base,
+                           const char *alph, const char *z1, const char *z2, char op, char *result,
+                           long double *times, suite_result *r) {
+    long double t = current_time();
+    func(base, alph, z1, z2, op, result);
+    long double warm_up = current_time() - t;
+    if (warm_up > BENCH_SUITE_TIME_LIMIT) {
+        return warm_up;
+    }
+
+    long double total = 0;
+    size_t n = 0;
+    while (n < max_repetitions &&
+           (n < BENCH_SUITE_MIN_REPETITIONS || total < BENCH_SUITE_CELL_TIME)) {
+        t = current_time();
+        func(base, alph, z1, z2, op, result);
+        times[n] = current_time() - t;
+        total += times[n++];
+    }
+
+    qsort(times, n, sizeof(long double), compare_times);
+    r->repetitions = n;
+    r->min = times[0];
+    r->median = n % 2 == 1 ? times[n / 2] : (times[n / 2 - 1] + times[n / 2]) / 2;
+    // nearest rank
+    size_t rank = (99 * n + 99) / 100;
+    r->p99 = times[rank - 1];
+    return warm_up;
+}
+
+static void print_result(FILE *out, bool json, bool first, const char *name, int base, char op,
+                         size_t length, const suite_result *r) {
+    long double digits_per_second = (2 * length) / r->median;
+    if (json) {
+        fprintf(out,
+                "%s  {\"implementation\": \"%s\", \"base\": %d, \"operator\": \"%c\", "
+                "\"digits\": %zu, \"repetitions\": %zu, \"min_ms\": %.6Lf, \"median_ms\": %.6Lf, "
+                "\"p99_ms\": %.6Lf, \"digits_per_second\": %.0Lf}",
+                first ? "" : ",\n", name, base, op, length, r->repetitions, r->min * 1000,
+                r->median * 1000, r->p99 * 1000, digits_per_second);
+    } else {
+        fprintf(out, "%s,%d,%c,%zu,%zu,%.6Lf,%.6Lf,%.6Lf,%.0Lf\n", name, base, op, length,
+                r->repetitions, r->min * 1000, r->median * 1000, r->p99 * 1000,
+                digits_per_second);
+    }
+    fflush(out);
+}
+
+void bench_suite(const bench_suite_options *options, FILE *out) {
+    size_t max_length = options->max_length;
+    size_t repetitions = options->repetitions < 1 ? 1 : options->repetitions;
+
+    char *z1 = malloc(max_length + 1);
+    check_alloc(z1, max_length + 1, "bench suite operand");
+    char *z2 = malloc(max_length + 1);
+    check_alloc(z2, max_length + 1, "bench suite operand");
+    char *result = malloc(2 * max_length + 2);
+    check_alloc(result, 2 * max_length + 2, "bench suite result");
+    long double *times = malloc(repetitions * sizeof(long double));
+    check_alloc(times, repetitions * sizeof(long double), "bench suite times");
+    char alph[sizeof(suite_alph)];
+
+    size_t base_count = options->base != 0 ? 1 : sizeof(suite_bases) / sizeof(int);
+    bool first = true;
+
+    if (options->json) {
+        fprintf(out, "[\n");
+    } else {
+        fprintf(out,
+                "implementation,base,operator,digits,repetitions,min_ms,median_ms,p99_ms,"
+                "digits_per_second\n");
+    }
+
+    for (size_t i = 0; i < IMPLEMENTATIONS_COUNT; i++) {
+        if (options->implementation != -1 && (size_t) options->implementation != i) continue;
+        implementation_t func = implementations[i].func;
+
+        for (size_t b = 0; b < base_count; b++) {
+            int base = options->base != 0 ? options->base : suite_bases[b];
+            size_t base_abs = abs(base);
+            if (options->base != 0) {
+                strcpy(alph, options->alph);
+            } else {
+                memcpy(alph, suite_alph, base_abs);
+                alph[base_abs] = '\0';
+            }
+
+            for (size_t o = 0; o < sizeof(suite_operators); o++) {
+                char op = suite_operators[o];
+                if (options->op != '\0' && options->op != op) continue;
+
+                // the same operands for every implementation
+                uint64_t state = 0x5EED;
+                // 10, 30, 100, 300, ...
+                for (size_t decade = 10; decade <= max_length; decade *= 10) {
+                    size_t length = decade;
+                    long double time = 0;
+                    for (size_t step = 0; step < 2 && length <= max_length; step++) {
+                        random_operand(z1, length, alph, base_abs, &state);
+                        random_operand(z2, length, alph, base_abs, &state);
+
+                        suite_result r;
+                        time = measure(func, repetitions, base, alph, z1, z2, op, result, times,
+                                       &r);
+                        if (time > BENCH_SUITE_TIME_LIMIT) break;
+                        print_result(out, options->json, first, implementations[i].name, base, op,
+                                     length, &r);
+                        first = false;
+                        length = 3 * decade;
+                    }
+                    if (time > BENCH_SUITE_TIME_LIMIT) break;
+                }
+            }
+        }
+    }
+
+    if (options->json) {
+        fprintf(out, "%s]\n", first ? "" : "\n");
+    }
+
+    free(times);
+    free(result);
+    free(z2);
+    free(z1);
+}
+
+/**
+ * @brief The median time of a calculation (the time of the warm-up call if it took too long)
+ */
+static long double tune_time(implementation_t func, int base, const char *alph, const char *z1,
+                             const char *z2, char op, char *result, long double *times) {
+    suite_result r;
+    long double warm_up =
+            measure(func, BENCH_TUNE_REPETITIONS, base, alph, z1, z2, op, result, times, &r);
+    return warm_up > BENCH_SUITE_TIME_LIMIT ? warm_up : r.median;
+}
+
+/**
+ * @brief Write the (small) exponent in the base into z
+ */
+static void write_exponent(int exponent, int base, const char *alph, char *z) {
+    char digits[64];
+    size_t count = 0;
+    do {
+        int remainder = exponent % base;
+        exponent /= base;
+        // the digits of negative bases must not be negative either
+        if (remainder < 0) {
+            remainder += abs(base);
+            exponent++;
+        }
+        digits[count++] = alph[remainder];
+    } while (exponent != 0);
+    for (size_t i = 0; i < count; i++) {
+        z[i] = digits[count - 1 - i];
+    }
+    z[count] = '\0';
+}
+
+/**
+ * @brief Find the shortest length from which the limb implementation is faster than the naive one
+ *
+ * The lengths grow by a quarter. A length is only accepted if the limb implementation is also
+ * faster for the BENCH_TUNE_CONFIRMATIONS following lengths, so that a single noisy measurement
+ * does not move the crossover.
+ *
+ * @return The crossover length in digits (the length of the power for '^'), SIZE_MAX if the naive
+ *         implementation is faster up to BENCH_TUNE_MAX_LENGTH digits
+ */
+static size_t tune_threshold(int base, const char *alph, char op, char *z1, char *z2, char *result,
+                             long double *times) {
+    size_t base_abs = abs(base);
+    uint64_t state = 0x5EED;
+    size_t crossover = SIZE_MAX;
+    size_t wins = 0;
+
+    for (size_t length = 2; length <= BENCH_TUNE_MAX_LENGTH; length += length / 4 + 1) {
+        if (op == '^') {
+            random_operand(z1, (length + BENCH_TUNE_EXPONENT - 1) / BENCH_TUNE_EXPONENT, alph,
+                           base_abs, &state);
+            write_exponent(BENCH_TUNE_EXPONENT, base, alph, z2);
+        } else {
+            random_operand(z1, length, alph, base_abs, &state);
+            random_operand(z2, length, alph, base_abs, &state);
+        }
+
+        long double naive = tune_time(impl_naive, base, alph, z1, z2, op, result, times);
+        long double limb = tune_time(arith_op_any_base__limb__subquadratic, base, alph, z1, z2, op,
+                                     result, times);
+        if (limb >= naive) {
+            wins = 0;
+            crossover = SIZE_MAX;
+        } else if (wins++ == 0) {
+            crossover = length;
+        }
+        if (wins > BENCH_TUNE_CONFIRMATIONS) break;
+    }
+
+    return wins > BENCH_TUNE_CONFIRMATIONS ? crossover : SIZE_MAX;
+}
+
+void bench_tune(FILE *out) {
+    char *z1 = malloc(BENCH_TUNE_MAX_LENGTH + 1);
+    check_alloc(z1, BENCH_TUNE_MAX_LENGTH + 1, "tuning operand");
+    char *z2 = malloc(BENCH_TUNE_MAX_LENGTH + 1);
+    check_alloc(z2, BENCH_TUNE_MAX_LENGTH + 1, "tuning operand");
+    // the measured powers may be up to BENCH_TUNE_EXPONENT - 1 digits longer
+    char *result = malloc(2 * BENCH_TUNE_MAX_LENGTH + 2 * BENCH_TUNE_EXPONENT);
+    check_alloc(result, 2 * BENCH_TUNE_MAX_LENGTH + 2 * BENCH_TUNE_EXPONENT, "tuning result");
+    long double *times = malloc(BENCH_TUNE_REPETITIONS * sizeof(long double));
+    check_alloc(times, BENCH_TUNE_REPETITIONS * sizeof(long double), "tuning times");
+
+    // one base (and its negative) represents every class of abs(base)
+    const int class_bases[AUTO_BASE_CLASS_COUNT] = AUTO_BASE_CLASS_BASES;
+    size_t thresholds[AUTO_OPERATOR_COUNT][AUTO_BASE_CLASS_COUNT][2];
+    for (size_t c = 0; c < AUTO_BASE_CLASS_COUNT; c++) {
+        char alph[sizeof(suite_alph)];
+        memcpy(alph, suite_alph, class_bases[c]);
+        alph[class_bases[c]] = '\0';
+        for (size_t o = 0; o < AUTO_OPERATOR_COUNT; o++) {
+            for (size_t negative = 0; negative < 2; negative++) {
+                thresholds[o][c][negative] =
+                        tune_threshold(negative ? -class_bases[c] : class_bases[c], alph,
+                                       AUTO_OPERATORS[o], z1, z2, result, times);
+            }
+        }
+    }
+
+    fprintf(out,
+            "/* Generated by make tune (./main -T): the crossover lengths in digits of the auto "
+            "implementation */\n"
+            "#ifndef AUTO_THRESHOLDS_H\n"
+            "#define AUTO_THRESHOLDS_H\n"
+            "\n"
+            "#include <stdint.h>\n"
+            "\n"
+            "/*\n"
+            " * rows: '+', '-', '*', '^', per row the classes abs(base) <= 4, <= 16 and > 16,\n"
+            " * per class positive bases and negative bases\n"
+            " */\n"
+            "#define AUTO_THRESHOLDS \\\n"
+            "    {");
+    for (size_t o = 0; o < AUTO_OPERATOR_COUNT; o++) {
+        fprintf(out, "%s{", o == 0 ? "" : ", \\\n     ");
+        for (size_t c = 0; c < AUTO_BASE_CLASS_COUNT; c++) {
+            fprintf(out, "%s{", c == 0 ? "" : ", ");
+            for (size_t negative = 0; negative < 2; negative++) {
+                if (negative) fprintf(out, ", ");
+                if (thresholds[o][c][negative] == SIZE_MAX) {
+                    fprintf(out, "SIZE_MAX");
+                } else {
+                    fprintf(out, "%zu", thresholds[o][c][negative]);
+                }
+            }
+            fprintf(out, "}");
+        }
+        fprintf(out, "}");
+    }
+    fprintf(out, "}\n\n#endif\n");
+
+    free(times);
+    free(result);
+    free(z2);
+    free(z1);
+}
@@ -1,6 +1,9 @@
 #ifndef BENCH_H
 #define BENCH_H
 
+#include <stdbool.h>
+#include <stdio.h>
+
 #include "implementations.h"
 
 /**
@@ -23,4 +26,43 @@
 long double bench(Implementation impl, size_t iterations, int base, const char *alph,
                   const char *z1, const char *z2, char op, char *result);
 
+/**
+ * The parameters of the benchmark suite. An implementation, base or operator of -1/0/'\0' means
+ * that all implementations, the default bases or all operators are measured.
+ */
+typedef struct bench_suite_options {
+    size_t max_length;   // operands of 10, 30, 100, 300, ... digits up to max_length are measured
+    size_t repetitions;  // the maximum number of measurements per operand length
+    int implementation;
+    int base;
+    const char *alph;  // the alphabet of base (only if base is given)
+    char op;
+    bool json;  // JSON instead of CSV
+} bench_suite_options;
+
+/**
+ * @brief Measures the implementations on random operands of growing length
+ *
+ * Every measurement is preceded by an untimed warm-up call. For every implementation, base,
+ * operator and length the minimum, median and 99th percentile of the times and the throughput
+ * (input digits per second, based on the median) are written as CSV or JSON. Longer operands are
+ * skipped as soon as a single calculation takes longer than BENCH_SUITE_TIME_LIMIT seconds.
+ *
+ * @param options   The parameters of the suite
+ * @param out       The stream the results are written to
+ */
+void bench_suite(const bench_suite_options *options, FILE *out);
+
+/**
+ * @brief Measures the crossover lengths of the auto implementation on this machine
+ *
+ * For every operator and every class of abs(base) (see auto_base_class) the naive and the
+ * subquadratic limb implementation are compared in the base of the class (AUTO_BASE_CLASS_BASES)
+ * and its negative on random operands of growing length. The crossover lengths are written as the
+ * header auto_thresholds.h (see make tune).
+ *
+ * @param out   The stream the header is written to
+ */
+void bench_tune(FILE *out);
+
 #endif
@@ -0,0 +1,194 @@
+#include "expression.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "implementations/number_system.h"
+#include "test.h"
+
+/**
+ * The expression is evaluated by a recursive descent parser on the grammar
+ *
+ *     sum     := product (('+' | '-') product)*
+ *     product := factor ('*' factor)*
+ *     factor  := '-' factor | '(' sum ')' | number
+ *
+ * Every rule returns the value of the parsed part of the expression or NULL if it is invalid.
+ */
+typedef struct parser {
+    const number_system *system;
+    const char *expression;
+    size_t position;
+} parser;
+
+static number *parse_sum(parser *p);
+
+bool is_expression_symbol(char c) {
+    return c == '+' || c == '-' || c == '*' || c == '(' || c == ')' || c == ' ';
+}
+
+static char peek(parser *p) {
+    while (p->expression[p->position] == ' ') p->position++;
+    return p->expression[p->position];
+}
+
+/* calculates a op b and deletes both operands */
+static number *combine(number *a, number *b, char op) {
+    number *result = number_operation(a, b, op);
+    delete_number(a);
+    delete_number(b);
+    return result;
+}
+
+static number *parse_factor(parser *p) {
+    char c = peek(p);
+
+    if (c == '-') {
+        p->position++;
+        number *value = parse_factor(p);
+        if (value != NULL) negate_number(value);
+        return value;
+    }
+
+    if (c == '(') {
+        p->position++;
+        number *value = parse_sum(p);
+        if (value == NULL) return NULL;
+        if (peek(p) != ')') {
+            delete_number(value);
+            return NULL;
+        }
+        p->position++;
+        return value;
+    }
+
+    // a number is the longest sequence of digits
+    const char *z = p->expression + p->position;
+    size_t length = 0;
+    while (z[length] != '\0' && p->system->tables.valid[(unsigned char) z[length]] &&
+           !is_expression_symbol(z[length])) {
+        length++;
+    }
+
+    number *value = parse_number_of_length(p->system, z, length);
+    if (value != NULL) p->position += length;
+    return value;
+}
+
+static number *parse_product(parser *p) {
+    number *value = parse_factor(p);
+
+    while (value != NULL && peek(p) == '*') {
+        p->position++;
+        number *factor = parse_factor(p);
+        if (factor == NULL) {
+            delete_number(value);
+            return NULL;
+        }
+        value = combine(value, factor, '*');
+    }
+
+    return value;
+}
+
+static number *parse_sum(parser *p) {
+    number *value = parse_product(p);
+
+    char op;
+    while (value != NULL && ((op = peek(p)) == '+' || op == '-')) {
+        p->position++;
+        number *summand = parse_product(p);
+        if (summand == NULL) {
+            delete_number(value);
+            return NULL;
+        }
+        value = combine(value, summand, op);
+    }
+
+    return value;
+}
+
+number *evaluate_expression(const number_system *system, const char *expression,
+                            size_t *error_position) {
+    parser p = {system, expression, 0};
+
+    number *value = parse_sum(&p);
+    if (value != NULL && peek(&p) != '\0') {
+        delete_number(value);
+        value = NULL;
+    }
+
+    if (value == NULL) *error_position = p.position;
+    return value;
+}
+
+#define EXPRESSION_TEST_BUFFER_SIZE 128
+
+typedef struct Testcase_expression {
+    int base;
+    const char *alph;
+    const char *expression;
+    const char *expected;  // NULL if the expression is invalid
+    size_t error_position;
+} Testcase_expression;
+
+static bool test_expression_executor(char *buffer, Testcase_expression *t) {
+    number_system *system = create_checked_number_system(t->base, t->alph);
+    if (system == NULL) return false;
+
+    size_t error_position = 0;
+    number *result = evaluate_expression(system, t->expression, &error_position);
+
+    bool success;
+    if (t->expected == NULL) {
+        strcpy(buffer, "invalid");
+        success = result == NULL && error_position == t->error_position;
+    } else {
+        success = result != NULL &&
+                  format_number(result, system, buffer, EXPRESSION_TEST_BUFFER_SIZE) &&
+                  strcmp(buffer, t->expected) == 0;
+    }
+
+    delete_number(result);
+    delete_number_system(system);
+
+    return success;
+}
+
+void expression_test(void) {
+    TestResult tr = test_init("expression", "evaluation of expressions");
+
+    Testcase_expression test_cases[] = {
+            {10, "0123456789", "12*34+5", "413", 0},
+            {10, "0123456789", "2 * 3 + 4 * 5", "26", 0},
+            {10, "0123456789", " -(3 - 10) * 2 ", "14", 0},
+            {10, "0123456789", "1-2-3", "-4", 0},
+            {10, "0123456789", "--7*-((2))", "-14", 0},
+            {10, "0123456789", "99999999999999999999*99999999999999999999-1",
+             "9999999999999999999800000000000000000000", 0},
+            {16, "0123456789abcdef", "ff*(ff+1)-ff00", "0", 0},
+            {-2, "01", "1+1", "110", 0},
+            {-2, "01", "-(1)", "11", 0},
+            {-10, "0123456789", "19*19+1", "2", 0},
+            {-10, "0123456789", "(18+1)*(0-1)", "1", 0},
+            {10, "0123456789", "", NULL, 0},
+            {10, "0123456789", "1+", NULL, 2},
+            {10, "0123456789", "(1", NULL, 2},
+            {10, "0123456789", "1)", NULL, 1},
+            {10, "0123456789", "1 2", NULL, 2},
+            {10, "0123456789", "1+a", NULL, 2},
+            {10, "0123456789", "2*(3+)", NULL, 5},
+    };
+
+    int count = sizeof(test_cases) / sizeof(test_cases[0]);
+
+    char buffer[EXPRESSION_TEST_BUFFER_SIZE];
+
+    for (int i = 0; i < count; i++) {
+        test_run_with_env(buffer, &test_cases[i], (void *) test_expression_executor, &tr,
+                          "\"%s\" with base %i", "got %s", test_cases[i].expression,
+                          test_cases[i].base, buffer);
+    }
+
+    test_finalize(tr);
+}
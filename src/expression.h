@@ -0,0 +1,37 @@
+#ifndef EXPRESSION_H
+#define EXPRESSION_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "library.h"
+
+/**
+ * @brief Check if a char is an operator, a parenthesis or a space of an expression
+ *
+ * These chars must not be contained in the alphabet of an expression.
+ */
+bool is_expression_symbol(char c);
+
+/**
+ * @brief Evaluate an arithmetic expression
+ *
+ * The expression consists of numbers of the number system, the binary operators '+', '-' and '*'
+ * (with the usual precedence, evaluated from left to right), the unary operator '-', parentheses
+ * and spaces. All intermediate results stay in binary, only the result is formatted.
+ *
+ * @param system            The number system of the numbers
+ * @param expression        The expression
+ * @param error_position    Set to the position of the first invalid char if the expression is invalid
+ * @return                  The result (delete it with delete_number) or NULL if the expression is
+ *                          invalid
+ */
+number *evaluate_expression(const number_system *system, const char *expression,
+                            size_t *error_position);
+
+/**
+ * @brief Runs the tests of the expression evaluation
+ */
+void expression_test(void);
+
+#endif
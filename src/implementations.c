@@ -1,8 +1,12 @@
 #include "implementations.h"
 
+#include "implementations/impl_auto/impl_auto.h"
 #include "implementations/impl_binary_conversion/binary_conversion_tests.h"
 #include "implementations/impl_binary_conversion/impl_binary_conversion.h"
+#include "implementations/impl_limb/impl_limb.h"
+#include "implementations/impl_limb/limb_tests.h"
 #include "implementations/impl_naive/impl_naive.h"
+#include "implementations/number_system.h"
 
 const Implementation implementations[] = {
         { // default
@@ -25,7 +29,34 @@ const Implementation implementations[] = {
                 "This implementation calculates the result without conversion into another base.",
                 impl_naive, impl_naive_test
         },
+        {
+                "Limb Implementation (Schoolbook)",
+                "This implementation calculates the result of the arithmetic operation by first converting\n"
+                "the numbers into binary numbers that are stored in 64-bit limbs, then performing the\n"
+                "operation with carry-chain (ADC/SBB) kernels and then converting the result back to the\n"
+                "original base. Products are calculated with the schoolbook algorithm.",
+                arith_op_any_base__limb__schoolbook, limb_tests_schoolbook
+        },
+        {
+                "Limb Implementation (Subquadratic)",
+                "This implementation works like the limb implementation, but large products are calculated\n"
+                "with the subquadratic Karatsuba and Toom-3 multiplication algorithms.",
+                arith_op_any_base__limb__subquadratic, limb_tests_subquadratic
+        },
+        {
+                "Auto Implementation",
+                "This implementation selects the fastest implementation for the operator, the length of\n"
+                "the operands and the base: the naive implementation for additions, subtractions and\n"
+                "short operands and the subquadratic limb implementation for longer products and\n"
+                "powers. The crossover lengths can be measured on the machine with make tune.",
+                impl_auto, impl_auto_test
+        },
 
 };
 
-const size_t IMPLEMENTATIONS_COUNT = sizeof(implementations) / sizeof(Implementation);
\ No newline at end of file
+const size_t IMPLEMENTATIONS_COUNT = sizeof(implementations) / sizeof(Implementation);
+
+void release_thread_resources(void) {
+    release_operation_arena();
+    clear_number_system_cache();
+}
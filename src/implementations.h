@@ -16,7 +16,8 @@
  * @param z1        The first operand.  May start with '-' if base is positive. Any following
  *                                      characters must be contained in alph.
  * @param z2        The second operand. Same rules apply as for z1.
- * @param op        The operator.       Must be any of ['+', '-', '*'].
+ * @param op        The operator.       Must be any of ['+', '-', '*', '^']. The exponent z2 of
+ *                                      '^' must not be negative.
  * @param result    The result buffer.  The result will be stored as a NULL terminated string. Must
  *                                      be large enough to be able to accommodate the result.
  */
@@ -36,4 +37,11 @@ struct Implementation {
 extern const Implementation implementations[];
 extern const size_t IMPLEMENTATIONS_COUNT;
 
+/**
+ * @brief Release everything the implementations cache per thread
+ *
+ * Threads that call the implementations have to call this before they exit.
+ */
+void release_thread_resources(void);
+
 #endif
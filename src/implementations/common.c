@@ -1,7 +1,146 @@
 #include "common.h"
 
+#include <smmintrin.h>
+#include <string.h>
+
 void generate_lut(unsigned char lut[UCHAR_MAX + 1], unsigned int alph_len, const char *alph) {
     for (unsigned int i = 0; i < alph_len; i++) {
         lut[(unsigned char) alph[i]] = i;
     }
-}
\ No newline at end of file
+}
+
+void init_digit_tables(digit_tables *tables, unsigned int alph_len, const char *alph) {
+    memset(tables, 0, sizeof(digit_tables));
+    tables->base = alph_len;
+    tables->alph = alph;
+    generate_lut(tables->lut, alph_len, alph);
+
+    // there are only 8 rows of 16 ASCII chars
+    tables->ascii = alph_len <= 128;
+    tables->contiguous = true;
+    for (unsigned int i = 0; i < alph_len; i++) {
+        unsigned char c = alph[i];
+        tables->valid[c] = true;
+        if (c >= 128) tables->ascii = false;
+        if (c != (unsigned char) alph[0] + i) tables->contiguous = false;
+    }
+    if (!tables->ascii) return;
+
+    for (unsigned int i = 0; i < alph_len; i++) {
+        unsigned char c = alph[i];
+        tables->membership[c & 0x0F] |= 1 << (c >> 4);
+        tables->value_rows |= 1 << (c >> 4);
+        tables->values[c >> 4][c & 0x0F] = tables->lut[c];
+        tables->digits[i >> 4][i & 0x0F] = alph[i];
+    }
+}
+
+size_t find_invalid_digit(const digit_tables *tables, const char *z, size_t length) {
+    size_t i = 0;
+
+    if (tables->ascii) {
+        const __m128i membership = _mm_loadu_si128((const __m128i *) tables->membership);
+        // bit of every row, chars >= 128 (rows 8 to 15) are never digits
+        const __m128i row_bits = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, (char) 128, 0, 0, 0, 0, 0,
+                                               0, 0, 0);
+        const __m128i low_nibble = _mm_set1_epi8(0x0F);
+
+        for (; i + 16 <= length; i += 16) {
+            __m128i chars = _mm_loadu_si128((const __m128i *) (z + i));
+            __m128i low = _mm_and_si128(chars, low_nibble);
+            __m128i row = _mm_and_si128(_mm_srli_epi16(chars, 4), low_nibble);
+
+            __m128i found = _mm_and_si128(_mm_shuffle_epi8(membership, low),
+                                          _mm_shuffle_epi8(row_bits, row));
+            int invalid = _mm_movemask_epi8(_mm_cmpeq_epi8(found, _mm_setzero_si128()));
+            if (invalid != 0) return i + __builtin_ctz(invalid);
+        }
+    }
+
+    for (; i < length; i++) {
+        if (!tables->valid[(unsigned char) z[i]]) return i;
+    }
+    return length;
+}
+
+void digits_to_values(const digit_tables *tables, const char *z, size_t length, uint8_t *values) {
+    size_t i = 0;
+
+    if (tables->contiguous) {
+        // value = digit - alph[0], chars outside of the range get 0
+        const __m128i first = _mm_set1_epi8(tables->alph[0]);
+        const __m128i highest = _mm_set1_epi8((char) (tables->base - 1));
+
+        for (; i + 16 <= length; i += 16) {
+            __m128i value = _mm_sub_epi8(_mm_loadu_si128((const __m128i *) (z + i)), first);
+            __m128i in_range = _mm_cmpeq_epi8(_mm_min_epu8(value, highest), value);
+            _mm_storeu_si128((__m128i *) (values + i), _mm_and_si128(value, in_range));
+        }
+        for (; i < length; i++) {
+            uint8_t value = (uint8_t) (z[i] - tables->alph[0]);
+            values[i] = value < tables->base ? value : 0;
+        }
+        return;
+    }
+
+    if (tables->ascii) {
+        const __m128i low_nibble = _mm_set1_epi8(0x0F);
+
+        for (; i + 16 <= length; i += 16) {
+            __m128i chars = _mm_loadu_si128((const __m128i *) (z + i));
+            __m128i low = _mm_and_si128(chars, low_nibble);
+            __m128i row = _mm_and_si128(_mm_srli_epi16(chars, 4), low_nibble);
+
+            // look up the chars of every row that contains digits
+            __m128i value = _mm_setzero_si128();
+            for (int r = 0; r < 8; r++) {
+                if (!(tables->value_rows & (1 << r))) continue;
+                __m128i in_row = _mm_cmpeq_epi8(row, _mm_set1_epi8((char) r));
+                __m128i row_values = _mm_loadu_si128((const __m128i *) tables->values[r]);
+                value = _mm_or_si128(value,
+                                     _mm_and_si128(in_row, _mm_shuffle_epi8(row_values, low)));
+            }
+            _mm_storeu_si128((__m128i *) (values + i), value);
+        }
+    }
+
+    for (; i < length; i++) {
+        values[i] = tables->lut[(unsigned char) z[i]];
+    }
+}
+
+void values_to_digits(const digit_tables *tables, const uint8_t *values, size_t length, char *z) {
+    size_t i = 0;
+
+    if (tables->contiguous) {
+        // digit = alph[0] + value
+        const __m128i first = _mm_set1_epi8(tables->alph[0]);
+
+        for (; i + 16 <= length; i += 16) {
+            __m128i value = _mm_loadu_si128((const __m128i *) (values + i));
+            _mm_storeu_si128((__m128i *) (z + i), _mm_add_epi8(value, first));
+        }
+    } else if (tables->ascii) {
+        const __m128i low_nibble = _mm_set1_epi8(0x0F);
+        int rows = (int) (tables->base + 15) / 16;
+
+        for (; i + 16 <= length; i += 16) {
+            __m128i value = _mm_loadu_si128((const __m128i *) (values + i));
+            __m128i low = _mm_and_si128(value, low_nibble);
+            __m128i row = _mm_and_si128(_mm_srli_epi16(value, 4), low_nibble);
+
+            __m128i digit = _mm_setzero_si128();
+            for (int r = 0; r < rows; r++) {
+                __m128i in_row = _mm_cmpeq_epi8(row, _mm_set1_epi8((char) r));
+                __m128i row_digits = _mm_loadu_si128((const __m128i *) tables->digits[r]);
+                digit = _mm_or_si128(digit,
+                                     _mm_and_si128(in_row, _mm_shuffle_epi8(row_digits, low)));
+            }
+            _mm_storeu_si128((__m128i *) (z + i), digit);
+        }
+    }
+
+    for (; i < length; i++) {
+        z[i] = tables->alph[values[i]];
+    }
+}
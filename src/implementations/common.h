@@ -2,6 +2,9 @@
 #define COMMON_H
 
 #include <limits.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 
 /**
 * @brief Populate the given lookup table
@@ -15,4 +18,67 @@
 */
 void generate_lut(unsigned char lut[UCHAR_MAX + 1], unsigned int alph_len, const char *alph);
 
-#endif
\ No newline at end of file
+/**
+* @brief Tables of an alphabet for the (SIMD) translation between digits and their values
+*
+* The SIMD functions split every char into its high nibble (the row) and its low nibble (the
+* position in the row) and look up 16 chars at a time with shuffles in the 16-entry rows. Only ASCII
+* alphabets (at most 8 rows of chars) are supported by the shuffles, all others are translated with
+* the lookup table. If the alphabet is a contiguous range of chars (like the default 0-9), digits
+* and values are translated arithmetically.
+*/
+typedef struct digit_tables {
+    unsigned int base;                 // length of the alphabet (abs(base))
+    const char *alph;                  // the alphabet
+    unsigned char lut[UCHAR_MAX + 1];  // value of every digit (0 for all other chars)
+    bool valid[UCHAR_MAX + 1];         // the char is a digit
+    bool ascii;                        // all digits are ASCII chars (< 128)
+    bool contiguous;                   // alph[i] == alph[0] + i
+    uint8_t membership[16];            // bit r of membership[l]: the char r * 16 + l is a digit
+    uint8_t value_rows;                // bit r: at least one digit is in row r
+    uint8_t values[8][16];             // values[r][l]: value of the char r * 16 + l
+    uint8_t digits[8][16];             // digits[v / 16][v % 16]: digit of the value v
+} digit_tables;
+
+/**
+* @brief Populate the translation tables of an alphabet
+*
+* @param tables    The tables to populate
+* @param alph_len  The length of the alphabet (abs(base))
+* @param alph      The alphabet (it has to outlive the tables)
+*/
+void init_digit_tables(digit_tables *tables, unsigned int alph_len, const char *alph);
+
+/**
+* @brief Find the first char of z that is not a digit of the alphabet
+*
+* @param tables    The tables of the alphabet
+* @param z         The chars to check
+* @param length    Number of chars in z
+* @return          The index of the first invalid char or length if all chars are digits
+*/
+size_t find_invalid_digit(const digit_tables *tables, const char *z, size_t length);
+
+/**
+* @brief Translate digits to their values
+*
+* Chars that are not in the alphabet get the value 0.
+*
+* @param tables    The tables of the alphabet
+* @param z         The digits
+* @param length    Number of digits
+* @param values    The buffer for the values (length bytes, may be the same memory as z)
+*/
+void digits_to_values(const digit_tables *tables, const char *z, size_t length, uint8_t *values);
+
+/**
+* @brief Translate values (< abs(base)) to their digits
+*
+* @param tables    The tables of the alphabet
+* @param values    The values
+* @param length    Number of values
+* @param z         The buffer for the digits (length chars, may be the same memory as values)
+*/
+void values_to_digits(const digit_tables *tables, const uint8_t *values, size_t length, char *z);
+
+#endif
@@ -0,0 +1,17 @@
+/* Generated by make tune (./main -T): the crossover lengths in digits of the auto implementation */
+#ifndef AUTO_THRESHOLDS_H
+#define AUTO_THRESHOLDS_H
+
+#include <stdint.h>
+
+/*
+ * rows: '+', '-', '*', '^', per row the classes abs(base) <= 4, <= 16 and > 16,
+ * per class positive bases and negative bases
+ */
+#define AUTO_THRESHOLDS \
+    {{{SIZE_MAX, SIZE_MAX}, {SIZE_MAX, SIZE_MAX}, {SIZE_MAX, SIZE_MAX}}, \
+     {{SIZE_MAX, SIZE_MAX}, {SIZE_MAX, SIZE_MAX}, {SIZE_MAX, SIZE_MAX}}, \
+     {{14, 47}, {14, 47}, {11, 74}}, \
+     {{18, 59}, {14, 47}, {11, 59}}}
+
+#endif
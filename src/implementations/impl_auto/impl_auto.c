@@ -0,0 +1,177 @@
+#include "impl_auto.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../test.h"
+#include "../impl_limb/impl_limb.h"
+#include "../impl_naive/impl_naive.h"
+#include "../number_system.h"
+#include "auto_thresholds.h"
+
+size_t auto_thresholds[AUTO_OPERATOR_COUNT][AUTO_BASE_CLASS_COUNT][2] = AUTO_THRESHOLDS;
+
+size_t auto_base_class(int base) {
+    unsigned int base_abs = abs(base);
+    if (base_abs <= 4) return 0;
+    return base_abs <= 16 ? 1 : 2;
+}
+
+/**
+ * @brief Get the number of digits of z (without the sign)
+ */
+static size_t digit_count(int base, const char *z) {
+    if (base > 0 && *z == '-') z++;
+    return strlen(z);
+}
+
+implementation_t auto_select_implementation(int base, const char *alph, const char *z1,
+                                            const char *z2, char op) {
+    const char *row = strchr(AUTO_OPERATORS, op);
+    if (op == '\0' || row == NULL) return impl_naive;
+    size_t threshold = auto_thresholds[row - AUTO_OPERATORS][auto_base_class(base)][base < 0];
+    if (threshold == SIZE_MAX) return impl_naive;
+
+    size_t length_1 = digit_count(base, z1);
+    size_t length;
+    if (op == '^') {
+        // the squarings of the last steps dominate, so the length of the power counts (an exponent
+        // that does not fit is invalid or results in an enormous power)
+        uint64_t exponent;
+        if (length_1 == 0 ||
+            parse_exponent(get_number_system(base, alph), z2, SIZE_MAX / length_1, &exponent) ==
+                    EXPONENT_VALID) {
+            length = length_1 * exponent;
+        } else {
+            length = SIZE_MAX;
+        }
+    } else {
+        size_t length_2 = digit_count(base, z2);
+        length = length_1 > length_2 ? length_1 : length_2;
+    }
+
+    return length >= threshold ? arith_op_any_base__limb__subquadratic : impl_naive;
+}
+
+void impl_auto(int base, const char *alph, const char *z1, const char *z2, char op, char *result) {
+    auto_select_implementation(base, alph, z1, z2, op)(base, alph, z1, z2, op, result);
+}
+
+typedef struct Testcase_auto_select {
+    int base;
+    size_t length_1;
+    size_t length_2;  // the exponent of '^'
+    char op;
+    size_t threshold;
+    bool limb;  // whether the limb implementation is expected
+} Testcase_auto_select;
+
+static const char auto_test_alph[] =
+        "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ+/";
+
+static bool test_auto_select_executor(Testcase_auto_select *t) {
+    char alph[sizeof(auto_test_alph)];
+    size_t base_abs = abs(t->base);
+    memcpy(alph, auto_test_alph, base_abs);
+    alph[base_abs] = '\0';
+
+    char z1[64];
+    char z2[64];
+    memset(z1, alph[base_abs - 1], t->length_1);
+    z1[t->length_1] = '\0';
+    if (t->op == '^') {
+        z2[0] = alph[t->length_2];
+        z2[1] = '\0';
+    } else {
+        memset(z2, alph[1], t->length_2);
+        z2[t->length_2] = '\0';
+    }
+
+    size_t *entry = &auto_thresholds[strchr(AUTO_OPERATORS, t->op) - AUTO_OPERATORS]
+                                    [auto_base_class(t->base)][t->base < 0];
+    size_t threshold = *entry;
+    *entry = t->threshold;
+
+    implementation_t expected = t->limb ? arith_op_any_base__limb__subquadratic : impl_naive;
+    bool success = auto_select_implementation(t->base, alph, z1, z2, t->op) == expected;
+
+    // both implementations have to calculate the same result
+    char result[200];
+    char naive_result[200];
+    impl_auto(t->base, alph, z1, z2, t->op, result);
+    impl_naive(t->base, alph, z1, z2, t->op, naive_result);
+    success &= strcmp(result, naive_result) == 0;
+
+    *entry = threshold;
+    return success;
+}
+
+/**
+ * Tests that the implementation is selected by the operator, the length and the class and sign of
+ * the base.
+ */
+static void test_auto_select(Implementation impl) {
+    TestResult tr = test_init_impl(impl, "selection of the implementation");
+
+    Testcase_auto_select test_cases[] = {
+            {10, 9, 3, '*', 10, false},      {10, 10, 3, '*', 10, true},
+            {10, 3, 10, '*', 10, true},      {-10, 10, 10, '*', 10, true},
+            {-10, 9, 9, '*', 10, false},     {10, 20, 20, '+', 10, true},
+            {10, 20, 20, '-', SIZE_MAX, false}, {-10, 20, 20, '+', SIZE_MAX, false},
+            {10, 5, 2, '^', 20, false},      {10, 5, 4, '^', 20, true},
+            {10, 4, 0, '^', 1, false},       {-10, 10, 2, '^', 40, false},
+            {10, 19, 3, '^', 40, true},      {10, 2, 1, '^', SIZE_MAX, false},
+            {2, 12, 12, '*', 12, true},      {-3, 11, 5, '*', 12, false},
+            {4, 6, 3, '^', 18, true},        {-4, 6, 2, '^', 18, false},
+            {16, 8, 8, '*', 8, true},        {-64, 20, 20, '*', 30, false},
+            {36, 20, 20, '*', 20, true},     {-64, 7, 3, '^', 21, true},
+    };
+
+    int count = sizeof(test_cases) / sizeof(test_cases[0]);
+
+    for (int i = 0; i < count; i++) {
+        test_run(&test_cases[i], (bool (*)(void *)) test_auto_select_executor, &tr,
+                 "%zu %c %zu digits in base %d (threshold %zu)", "wrong implementation",
+                 test_cases[i].length_1, test_cases[i].op, test_cases[i].length_2,
+                 test_cases[i].base, test_cases[i].threshold);
+    }
+
+    test_finalize(tr);
+}
+
+typedef struct Testcase_auto_base_class {
+    int base;
+    size_t base_class;
+} Testcase_auto_base_class;
+
+static bool test_auto_base_class_executor(Testcase_auto_base_class *t) {
+    return auto_base_class(t->base) == t->base_class;
+}
+
+/**
+ * Tests the boundaries of the classes of abs(base).
+ */
+static void test_auto_base_class(Implementation impl) {
+    TestResult tr = test_init_impl(impl, "classes of the base");
+
+    Testcase_auto_base_class test_cases[] = {
+            {2, 0},  {-2, 0},  {4, 0},  {-4, 0},  {5, 1},   {-5, 1},
+            {10, 1}, {16, 1},  {-16, 1}, {17, 2}, {-17, 2}, {64, 2},
+            {93, 2}, {-93, 2},
+    };
+
+    int count = sizeof(test_cases) / sizeof(test_cases[0]);
+
+    for (int i = 0; i < count; i++) {
+        test_run(&test_cases[i], (bool (*)(void *)) test_auto_base_class_executor, &tr,
+                 "class of base %d", "wrong class", test_cases[i].base);
+    }
+
+    test_finalize(tr);
+}
+
+void impl_auto_test(Implementation impl) {
+    test_auto_base_class(impl);
+    test_auto_select(impl);
+}
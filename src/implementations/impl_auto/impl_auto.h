@@ -0,0 +1,77 @@
+#ifndef IMPL_AUTO_H
+#define IMPL_AUTO_H
+
+#include <stdbool.h>
+
+#include "../../implementations.h"
+
+/* the operators in the order of the rows of auto_thresholds */
+#define AUTO_OPERATORS "+-*^"
+#define AUTO_OPERATOR_COUNT 4
+
+/* the classes of abs(base) with their own crossover lengths: up to 4, up to 16 and above 16 */
+#define AUTO_BASE_CLASS_COUNT 3
+/* the bases of the classes that make tune measures */
+#define AUTO_BASE_CLASS_BASES {3, 10, 64}
+
+/*
+ * tunable crossover lengths (in digits) from which the subquadratic limb implementation is used
+ * instead of the naive one, indexed by the operator (in the order of AUTO_OPERATORS), the class of
+ * abs(base) (see auto_base_class) and the sign of the base (0 positive, 1 negative). The defaults
+ * are taken from auto_thresholds.h (see make tune).
+ */
+extern size_t auto_thresholds[AUTO_OPERATOR_COUNT][AUTO_BASE_CLASS_COUNT][2];
+
+/**
+ * @brief Get the class of abs(base) that indexes auto_thresholds
+ *
+ * The crossover lengths in digits do not only depend on the sign of the base: the crossovers of
+ * negative bases grow with abs(base) (products of 47 digits in base -10, of 74 digits in base -64),
+ * and powers in the smallest bases cross slightly later than in the other classes (18 digits in
+ * base 3, 14 in base 10). A threshold in bits does not fit either, so similar bases share a class.
+ *
+ * @param base  The base.           base > 1 || base < -1
+ * @return      0 if abs(base) <= 4, 1 if abs(base) <= 16, 2 otherwise
+ */
+size_t auto_base_class(int base);
+
+/**
+ * @brief Select the implementation that is fastest for the given operation
+ *
+ * The naive implementation has no conversions, so it is the fastest one for short operands and
+ * all additions and subtractions. Products and powers are calculated by the subquadratic limb
+ * implementation once the length of their operands (the length of the power for '^') reaches the
+ * crossover length in auto_thresholds for the class and the sign of the base.
+ *
+ * @param base  The base.           base > 1 || base < -1
+ * @param alph  The alphabet.       len(alph) == abs(base)
+ * @param z1    The first operand.
+ * @param z2    The second operand.
+ * @param op    The operator.       Must be any of ['+', '-', '*', '^'].
+ * @return      The implementation that calculates the operation
+ */
+implementation_t auto_select_implementation(int base, const char *alph, const char *z1,
+                                            const char *z2, char op);
+
+/**
+ * \brief Auto implementation
+ *
+ * This implementation calculates the result with the implementation that auto_select_implementation
+ * selects for the operator, the length of the operands and the base.
+ *
+ * @param base      The base.           base > 1 || base < -1
+ * @param alph      The alphabet.       Must not contain '-' if base > 0 or any duplicate values.
+ * len(alph) == abs(base)
+ * @param z1        The first operand.  May start with '-' if base is positive. Any following
+ * characters must be contained in alph.
+ * @param z2        The second operand. Same rules apply as for z1.
+ * @param op        The operator.       Must be any of ['+', '-', '*', '^'], the exponent of '^'
+ * must not be negative.
+ * @param result    The result buffer.  The result will be stored as a NULL terminated string. Must
+ * be large enough to be able to accommodate the result.
+ */
+void impl_auto IMPL_SIGNATURE;
+
+void impl_auto_test(Implementation impl);
+
+#endif
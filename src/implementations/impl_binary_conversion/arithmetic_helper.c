@@ -1,3 +1,6 @@
+#include "arithmetic_helper.h"
+
+#include <math.h>
 #include <stdint.h>
 #include <stdlib.h>
 
@@ -14,6 +17,21 @@ int binary_logarithm_8bit_abs_ceil(int16_t value) {
     return -1;
 }
 
+/**
+ * Returns an upper bound of log_2(value) (value > 0) as fixed point number. The rounding error of
+ * log2 is far below the last fractional bit, so rounding up and adding one unit is enough.
+ */
+uint64_t binary_logarithm_fixed_point_ceil(unsigned int value) {
+    return (uint64_t) ceil(log2(value) * (1ULL << FIXED_POINT_BITS)) + 1;
+}
+
+/**
+ * Returns an upper bound of log_base(2) (base > 1) as fixed point number.
+ */
+uint64_t logarithm_of_two_fixed_point_ceil(unsigned int base) {
+    return (uint64_t) ceil((1ULL << FIXED_POINT_BITS) / log2(base)) + 1;
+}
+
 /**
  * Returns the maximum of two size_t values.
  */
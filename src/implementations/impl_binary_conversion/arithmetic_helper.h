@@ -1,10 +1,18 @@
 #ifndef ARITHMETIC_HELPER_H
 #define ARITHMETIC_HELPER_H
 
+#include <stdint.h>
 #include <stdlib.h>
 
 int binary_logarithm_8bit_abs_ceil(int16_t value);
 
+/* fixed point numbers with FIXED_POINT_BITS fractional bits */
+#define FIXED_POINT_BITS 32
+
+uint64_t binary_logarithm_fixed_point_ceil(unsigned int value);
+
+uint64_t logarithm_of_two_fixed_point_ceil(unsigned int base);
+
 size_t max(size_t a, size_t b);
 
 size_t min(size_t a, size_t b);
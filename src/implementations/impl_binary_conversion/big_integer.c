@@ -8,7 +8,9 @@
 
 #include "../../util.h"
 #include "arithmetic_helper.h"
+#include "instrumentation.h"
 #include "logger.h"
+#include "wide_simd.h"
 
 /*
  *
@@ -22,12 +24,17 @@
 
     Definition of an arbitrary precision (big) integer.
     bool "sign" is the sign bit of the number. When set to true, the number is negative and vice
-    versa. "length" specifies how many bytes the big_integer stores. "mem" is the pointer to the
-    memory location where the bytes are stored. mem[0] stores the least significant byte.
+    versa. "length" specifies how many bytes the big_integer stores. "used" is the number of bytes
+    that may be non-zero: every byte at an index >= used is zero (the byte at used - 1 can be zero
+    as well, used is only an upper bound that is tightened by big_integer_used_bytes). All
+    arithmetic functions only process the used bytes, so they have to keep it up to date. "mem" is
+    the pointer to the memory location where the bytes are stored. mem[0] stores the least
+    significant byte.
 
     typedef struct big_integer {
         bool sign;
         size_t length;
+        size_t used;
         void* mem;
     } big_integer;
 
@@ -47,6 +54,8 @@
  * @return The pointer to the created big_integer. Make sure to free this memory.
  */
 big_integer *create_big_integer(size_t bytes, bool sign) {
+    count_event(COUNTER_BIG_INTEGERS, 1);
+    count_event(COUNTER_BYTES_ALLOCATED, bytes);
 
     // Initialize big_integer struct (initialized memory).
     big_integer *bigint = (big_integer *) calloc(1, sizeof(big_integer));
@@ -60,9 +69,10 @@ big_integer *create_big_integer(size_t bytes, bool sign) {
     // Check for NULL-Pointer in memory
     check_alloc(bigint, bytes, "big_integer->mem");
 
-    // Assign sign and length of the big_integer
+    // Assign sign and length of the big_integer (no byte is used yet)
     bigint->sign = sign;
     bigint->length = bytes;
+    bigint->used = 0;
 
     return bigint;
 }
@@ -82,18 +92,164 @@ big_integer *create_big_integer_of_bytes(size_t length, uint8_t bytes[length], b
     return val;
 }
 
+/*
+ * =====================================================================
+ * Arena (scratch pool) allocation of big integers
+ * =====================================================================
+ *
+ * An arena hands out memory for the temporary big_integers of one operation from one big block (a
+ * bump allocator), instead of two calloc calls per big_integer. Nothing is freed individually: the
+ * whole arena is reset after the operation and can be reused by the next one. If a block is full,
+ * another block is chained. On the next reset, the chained blocks are merged into one block that is
+ * big enough for all of them, so a repeated operation only uses a single block.
+ *
+ * Functions that take an arena argument accept NULL, then the big_integers are allocated on the
+ * heap (create_big_integer) and deleted as usual.
+ */
+
+// alignment of all allocations in an arena (SSE registers)
+#define BIG_INTEGER_ARENA_ALIGNMENT 16
+
+/**
+ * Allocates an arena block that can hold capacity bytes.
+ */
+static big_integer_arena_block *create_big_integer_arena_block(size_t capacity) {
+    big_integer_arena_block *block = malloc(sizeof(big_integer_arena_block) + capacity);
+    check_alloc(block, sizeof(big_integer_arena_block) + capacity, "big_integer_arena_block");
+
+    block->next = NULL;
+    block->capacity = capacity;
+    block->used = 0;
+
+    return block;
+}
+
+/**
+ * Creates an arena with one block of the given capacity (in bytes).
+ * @return The pointer to the created arena. Make sure to free it with delete_big_integer_arena.
+ */
+big_integer_arena *create_big_integer_arena(size_t capacity) {
+    big_integer_arena *arena = malloc(sizeof(big_integer_arena));
+    check_alloc(arena, sizeof(big_integer_arena), "big_integer_arena");
+
+    arena->blocks = create_big_integer_arena_block(capacity);
+    arena->total_capacity = capacity;
+
+    return arena;
+}
+
+/**
+ * Returns zero-initialized memory of the given size from the arena. The memory is valid until the
+ * arena is reset or deleted.
+ */
+void *big_integer_arena_alloc(big_integer_arena *arena, size_t bytes) {
+    // round up to the alignment
+    bytes = (bytes + BIG_INTEGER_ARENA_ALIGNMENT - 1) & ~(size_t) (BIG_INTEGER_ARENA_ALIGNMENT - 1);
+
+    big_integer_arena_block *block = arena->blocks;
+    if (block->capacity - block->used < bytes) {
+        // chain a new block that is at least twice as big as the current one
+        size_t capacity = max(bytes, 2 * block->capacity);
+        big_integer_arena_block *new_block = create_big_integer_arena_block(capacity);
+        new_block->next = block;
+        arena->blocks = new_block;
+        arena->total_capacity += capacity;
+        block = new_block;
+    }
+
+    void *memory = block->data + block->used;
+    block->used += bytes;
+
+    memset(memory, 0, bytes);
+    return memory;
+}
+
+/**
+ * Creates a zero-initialized big_integer (see create_big_integer) whose struct and memory are both
+ * taken from the arena. If arena is NULL, the big_integer is allocated on the heap.
+ */
+big_integer *create_big_integer_in_arena(big_integer_arena *arena, size_t bytes, bool sign) {
+    if (arena == NULL) {
+        return create_big_integer(bytes, sign);
+    }
+    count_event(COUNTER_BIG_INTEGERS, 1);
+    count_event(COUNTER_BYTES_ALLOCATED, bytes);
+
+    big_integer *bigint = big_integer_arena_alloc(arena, sizeof(big_integer));
+    bigint->mem = big_integer_arena_alloc(arena, bytes);
+    bigint->sign = sign;
+    bigint->length = bytes;
+    bigint->used = 0;
+
+    return bigint;
+}
+
+/**
+ * Creates a new big_integer in the arena which has exactly the same value as the given one (see
+ * clone_big_integer). If arena is NULL, the big_integer is allocated on the heap.
+ */
+big_integer *clone_big_integer_in_arena(big_integer_arena *arena, big_integer *og_big_integer) {
+    big_integer *new_big_integer =
+            create_big_integer_in_arena(arena, og_big_integer->length, og_big_integer->sign);
+    memcpy(new_big_integer->mem, og_big_integer->mem, og_big_integer->used);
+    new_big_integer->used = og_big_integer->used;
+    return new_big_integer;
+}
+
+/**
+ * Deletes a big_integer that was created with create_big_integer_in_arena. big_integers of an arena
+ * are only freed when the arena is reset, so this only deletes heap big_integers (arena is NULL).
+ */
+void delete_big_integer_in_arena(big_integer_arena *arena, big_integer *value) {
+    if (arena == NULL) {
+        delete_big_integer(value);
+    }
+}
+
+/**
+ * Releases all big_integers of the arena at once, so that the arena can be reused. Chained blocks
+ * are merged into a single block.
+ */
+void big_integer_arena_reset(big_integer_arena *arena) {
+    if (arena->blocks->next != NULL) {
+        big_integer_arena_block *block = arena->blocks;
+        while (block != NULL) {
+            big_integer_arena_block *next = block->next;
+            free(block);
+            block = next;
+        }
+        arena->blocks = create_big_integer_arena_block(arena->total_capacity);
+    }
+
+    arena->blocks->used = 0;
+}
+
+/**
+ * Deletes the arena with all of its blocks (and therefore all big_integers in it).
+ */
+void delete_big_integer_arena(big_integer_arena *arena) {
+    big_integer_arena_block *block = arena->blocks;
+    while (block != NULL) {
+        big_integer_arena_block *next = block->next;
+        free(block);
+        block = next;
+    }
+    free(arena);
+}
+
 /**
  * Returns the minimum size of bytes a big_integer should have which can hold the result of the
  * exponentiation of the given base and exponent.
  * @param base The base of the numeral system as 16-bit signed integer: values in range [-128; 128].
  * @param exponent The exponent.
  */
-size_t get_big_integer_min_size_exponentiation(int16_t base, int exponent) {
-    // value base^exponent needs ceil(log_2(abs(base^exponent))) bits which can be computed by
-    // exponent * ceil(log_2(abs(base))) using logarithmic algebraic laws.
-
-    int bytes_needed = ((binary_logarithm_8bit_abs_ceil(base) * exponent) / 8) + 1;
-    return bytes_needed;
+size_t get_big_integer_min_size_exponentiation(int16_t base, size_t exponent) {
+    // value base^exponent needs floor(log_2(abs(base^exponent))) + 1 bits which can be computed by
+    // exponent * log_2(abs(base)) using logarithmic algebraic laws (an upper bound of the logarithm
+    // as fixed point number keeps it exact instead of rounding up every digit to whole bits).
+    unsigned __int128 bits = ((unsigned __int128) exponent *
+                              binary_logarithm_fixed_point_ceil(abs(base))) >> FIXED_POINT_BITS;
+    return (size_t) (bits / 8) + 1;
 }
 
 /**
@@ -118,12 +274,61 @@ size_t get_big_integer_min_size(int16_t base, size_t length) {
     return get_big_integer_min_size_exponentiation(base, length);
 }
 
+/**
+ * Returns the minimum size of bytes a big_integer should have which can hold the power z^exponent
+ * of any number z with the given amount of digits and the given value of its most significant
+ * digit. abs(z) < (leading_value + 1) * abs(base)^(length - 1), because the less significant digits
+ * are worth less than one unit of the most significant digit (in negative bases as well). This is
+ * smaller than get_big_integer_min_size_exponentiation(base, length * exponent) by up to
+ * log_2(abs(base) / (leading_value + 1)) * exponent bits.
+ * @param base The base/radix of the system, base is element ( [-128;128] \ {-1;0;1} ).
+ * @param length Length of digits of z.
+ * @param leading_value The value of the most significant digit of z.
+ * @param exponent The exponent (1 for the size of z itself).
+ */
+size_t get_big_integer_min_size_of_power(int16_t base, size_t length, uint8_t leading_value,
+                                         uint64_t exponent) {
+    if (length == 0) return 1;
+    unsigned __int128 logarithm =
+            (unsigned __int128) (length - 1) * binary_logarithm_fixed_point_ceil(abs(base)) +
+            binary_logarithm_fixed_point_ceil(leading_value + 1);
+    unsigned __int128 bits = (logarithm * exponent >> FIXED_POINT_BITS) + 1;
+    return (size_t) ((bits + 7) / 8);
+}
+
+/**
+ * Returns the maximum number of digits in the given base of a value below 2^bits, which is
+ * floor(bits * log_base(2)) + 1.
+ * @param base_abs The absolute value of the base (base_abs > 1).
+ * @param bits The number of bits of the value.
+ */
+size_t get_max_digit_count(unsigned int base_abs, size_t bits) {
+    return (size_t) (((unsigned __int128) bits * logarithm_of_two_fixed_point_ceil(base_abs)) >>
+                     FIXED_POINT_BITS) + 1;
+}
+
 /*
  * =====================================================================
  * Big integer util
  * =====================================================================
  */
 
+/**
+ * Returns the number of significant bytes of a 64-bit value (zero for the value zero).
+ */
+static size_t significant_bytes_of_uint64(uint64_t value) {
+    return value == 0 ? 0 : (64 - __builtin_clzll(value) + 7) / 8;
+}
+
+/**
+ * Raises the used bytes of the big_integer after a write of significant_bytes bytes at index.
+ */
+static void update_used_bytes(big_integer *big_int, size_t index, size_t significant_bytes) {
+    if (significant_bytes != 0 && index + significant_bytes > big_int->used) {
+        big_int->used = index + significant_bytes;
+    }
+}
+
 /**
  * Sets the byte value of the specified big_integer at the specified index to the specified value.
  * @param big_int The big_integer to change.
@@ -133,6 +338,7 @@ size_t get_big_integer_min_size(int16_t base, size_t length) {
  */
 void set_byte_value_of_big_integer(big_integer *big_int, size_t index, uint8_t value) {
     big_int->mem[index] = value;
+    update_used_bytes(big_int, index, value != 0);
 }
 
 /**
@@ -182,6 +388,7 @@ void set_7_bytes__of_big_integer(big_integer *big_int, size_t index, uint64_t va
                   big_int->length);
     }
     memcpy(big_int->mem + index, &value, 7);
+    update_used_bytes(big_int, index, significant_bytes_of_uint64(value & 0x00FFFFFFFFFFFFFF));
 }
 
 __m128i get_15_bytes__of_big_integer(big_integer *big_int, size_t index) {
@@ -201,6 +408,15 @@ void set_15_bytes__of_big_integer(big_integer *big_int, size_t index, __m128i va
                   big_int->length);
     }
     memcpy(big_int->mem + index, &value, 15);
+
+    // only the lower 7 bytes of the upper half are written
+    uint64_t upper = (uint64_t) _mm_extract_epi64(value, 1) & 0x00FFFFFFFFFFFFFF;
+    uint64_t lower = (uint64_t) _mm_cvtsi128_si64(value);
+    if (upper != 0) {
+        update_used_bytes(big_int, index + 8, significant_bytes_of_uint64(upper));
+    } else {
+        update_used_bytes(big_int, index, significant_bytes_of_uint64(lower));
+    }
 }
 
 /**
@@ -213,6 +429,20 @@ bool get_most_significant_bit(big_integer *value) {
     return get_byte_value_of_big_integer(value, value->length - 1) & 0x80;
 }
 
+/**
+ * Returns the number of significant bytes of the big_integer (the index of the most significant
+ * non-zero byte + 1, zero if the value is zero). The used bytes of the big_integer are shrunk to
+ * this number, so the leading zero bytes are only scanned once.
+ */
+size_t big_integer_used_bytes(big_integer *value) {
+    size_t used = value->used;
+    while (used > 0 && value->mem[used - 1] == 0) {
+        used--;
+    }
+    value->used = used;
+    return used;
+}
+
 /**
  * Creates a new big_integer which has exactly the same value as the given one.
  * @param og_big_integer The big_integer to copy the values from.
@@ -221,7 +451,8 @@ bool get_most_significant_bit(big_integer *value) {
 big_integer *clone_big_integer(big_integer *og_big_integer) {
     big_integer *new_big_integer = create_big_integer(og_big_integer->length, og_big_integer->sign);
     // Copy the byte values of the og big integer to the newly created one.
-    memcpy(new_big_integer->mem, og_big_integer->mem, og_big_integer->length);
+    memcpy(new_big_integer->mem, og_big_integer->mem, og_big_integer->used);
+    new_big_integer->used = og_big_integer->used;
     return new_big_integer;
 }
 
@@ -230,9 +461,9 @@ big_integer *clone_big_integer(big_integer *og_big_integer) {
  * @param value
  */
 void set_zero(big_integer *value) {
-    for (size_t i = 0; i < value->length; i++) {
-        set_byte_value_of_big_integer(value, i, 0);
-    }
+    // all bytes above the used ones are already zero
+    memset(value->mem, 0, value->used);
+    value->used = 0;
     value->sign = false;
 }
 
@@ -247,7 +478,9 @@ void copy_big_integer_value_into_another(big_integer *source, big_integer *desti
     set_zero(destination);
     destination->sign = source->sign;
 
-    memcpy(destination->mem, source->mem, min(source->length, destination->length));
+    size_t used = min(source->used, destination->length);
+    memcpy(destination->mem, source->mem, used);
+    destination->used = used;
 }
 
 /**
@@ -262,7 +495,8 @@ big_integer *clone_big_integer_add_size(big_integer *og_big_integer, size_t add_
     big_integer *new_big_integer =
             create_big_integer(og_big_integer->length + add_size, og_big_integer->sign);
     // Copy the byte values of the og big integer to the newly created one.
-    memcpy(new_big_integer->mem, og_big_integer->mem, og_big_integer->length);
+    memcpy(new_big_integer->mem, og_big_integer->mem, og_big_integer->used);
+    new_big_integer->used = og_big_integer->used;
 
     return new_big_integer;
 }
@@ -352,21 +586,23 @@ void delete_big_integer(big_integer *value) {
 
 /**
  * Util function that returns true if the value of the given big_integer is (+/-) zero.
- * Complexity: Θ(n)
+ * Complexity: O(1) if the used bytes are tight, otherwise the leading zero bytes are skipped once.
  */
 bool big_integer_is_zero(big_integer *value, bool simd) {
-    if (simd) return big_integer_is_zero_simd(value);
-
-    for (size_t i = 0; i < value->length; i++) {
-        uint8_t byte = get_byte_value_of_big_integer(value, i);
-        if (byte != 0) return false;
-    }
-    return true;
+    (void) simd;
+    return big_integer_used_bytes(value) == 0;
 }
 
+/**
+ * Checks the used bytes of the big_integer for zero with SIMD, without tightening the used bytes.
+ */
 bool big_integer_is_zero_simd(big_integer *value) {
-    int i = 0;
-    int length = (int) value->length;
+    int length = (int) value->used;
+
+    // whole AVX2/AVX-512 vectors first (if supported)
+    size_t checked;
+    if (!wide_simd_is_zero(value->mem, length, &checked)) return false;
+    int i = (int) checked;
 
     // 15 bytes at a time (SIMD 120 bit)
     for (; (i + 14) < length; i += 15) {
@@ -397,20 +633,9 @@ bool big_integer_is_equal(big_integer *a, big_integer *b) {
     if (a->sign != b->sign) {
         return false;
     }
-    if (big_integer_is_zero_simd(a) && big_integer_is_zero_simd(b)) {
-        return true;
-    }
-    for (size_t i = 0; i < a->length || i < b->length; i++) {
-        if (i < a->length && i < b->length) {
-            if (get_byte_value_of_big_integer(a, i) != get_byte_value_of_big_integer(b, i)) {
-                return false;
-            }
-        } else {
-            if (i < a->length && get_byte_value_of_big_integer(a, i) != 0) return false;
-            if (i < b->length && get_byte_value_of_big_integer(b, i) != 0) return false;
-        }
-    }
-    return true;
+    // the significant bytes of equal values have the same number and the same values
+    size_t used = big_integer_used_bytes(a);
+    return used == big_integer_used_bytes(b) && memcmp(a->mem, b->mem, used) == 0;
 }
 
 /**
@@ -9,9 +9,22 @@
 typedef struct big_integer {
     bool sign;
     size_t length;
+    size_t used;
     uint8_t *mem;
 } big_integer;
 
+typedef struct big_integer_arena_block {
+    struct big_integer_arena_block *next;
+    size_t capacity;
+    size_t used;
+    uint8_t data[];
+} big_integer_arena_block;
+
+typedef struct big_integer_arena {
+    big_integer_arena_block *blocks;
+    size_t total_capacity;
+} big_integer_arena;
+
 /* Initialization of big_integers */
 big_integer *create_big_integer(size_t bytes, bool sign);
 
@@ -23,11 +36,31 @@ void copy_big_integer_value_into_another(big_integer *source, big_integer *desti
 
 big_integer *clone_big_integer_add_size(big_integer *og_big_integer, size_t add_size);
 
+/* arena (scratch pool) allocation of big_integers */
+big_integer_arena *create_big_integer_arena(size_t capacity);
+
+void *big_integer_arena_alloc(big_integer_arena *arena, size_t bytes);
+
+big_integer *create_big_integer_in_arena(big_integer_arena *arena, size_t bytes, bool sign);
+
+big_integer *clone_big_integer_in_arena(big_integer_arena *arena, big_integer *og_big_integer);
+
+void delete_big_integer_in_arena(big_integer_arena *arena, big_integer *value);
+
+void big_integer_arena_reset(big_integer_arena *arena);
+
+void delete_big_integer_arena(big_integer_arena *arena);
+
 /* size calculations */
-size_t get_big_integer_min_size_exponentiation(int16_t base, int exponent);
+size_t get_big_integer_min_size_exponentiation(int16_t base, size_t exponent);
 
 size_t get_big_integer_min_size(int16_t base, size_t length);
 
+size_t get_big_integer_min_size_of_power(int16_t base, size_t length, uint8_t leading_value,
+                                         uint64_t exponent);
+
+size_t get_max_digit_count(unsigned int base_abs, size_t bits);
+
 /* getters and setters */
 void set_byte_value_of_big_integer(big_integer *big_int, size_t index, uint8_t value);
 
@@ -45,6 +78,8 @@ void set_15_bytes__of_big_integer(big_integer *big_int, size_t index, __m128i va
 
 bool get_most_significant_bit(big_integer *value);
 
+size_t big_integer_used_bytes(big_integer *value);
+
 void set_zero(big_integer *value);
 
 /* deletion */
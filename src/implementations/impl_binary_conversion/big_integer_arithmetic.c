@@ -1,20 +1,28 @@
 #include "big_integer_arithmetic.h"
 
+#include <immintrin.h>
+#include <math.h>
 #include <smmintrin.h>
 #include <stdbool.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "../../util.h"
+#include "../thread_pool.h"
 #include "arithmetic_helper.h"
+#include "instrumentation.h"
 #include "logger.h"
+#include "wide_simd.h"
 
 static void big_integer_addition_sisd(big_integer *value_a, big_integer *value_b);
 
 static void big_integer_addition_simd(big_integer *value_a, big_integer *value_b);
 
-static void big_integer_subtraction_sisd(big_integer *value_a, big_integer *value_b);
+static void big_integer_subtraction_sisd(big_integer *result, big_integer *minuend,
+                                         big_integer *subtrahend);
 
-static void big_integer_subtraction_simd(big_integer *value_a, big_integer *value_b);
+static void big_integer_subtraction_simd(big_integer *result, big_integer *minuend,
+                                         big_integer *subtrahend);
 
 /**
  * Adds two big integers and stores the result in the first operand. (In-Place addition)
@@ -31,22 +39,9 @@ void big_integer_addition(big_integer *value_a, big_integer *value_b, bool simd)
     // (The idea is to make every sign positive before calculating, because we cannot handle
     // negative numbers with arbitrary sized integers) (Addition/subtraction is here only defined on
     // positive numbers)
-    if (a_sign && !b_sign) {
-        // a negative; b positive (-a + b) => - (a - b)
-        value_a->sign = false;
-        big_integer_subtraction(value_a, value_b, simd);
-
-        // change sign of result (invert sign)
-        value_a->sign = !value_a->sign;
-        return;
-
-    } else if (!a_sign && b_sign) {
-        // a positive; b negative (a + -b) => a - b
-        value_b->sign = false;
-        big_integer_subtraction(value_a, value_b, simd);
-
-        // restore b sign
-        value_b->sign = true;
+    if (a_sign != b_sign) {
+        // (-a + b) => -(|a| - |b|) and (a + -b) => |a| - |b|
+        big_integer_magnitude_subtraction(value_a, value_b, a_sign, simd);
         return;
     }
 
@@ -63,9 +58,13 @@ void big_integer_addition(big_integer *value_a, big_integer *value_b, bool simd)
 }
 
 static void big_integer_addition_sisd(big_integer *value_a, big_integer *value_b) {
+    count_event(COUNTER_ADDITIONS, 1);
+
     // Assuming both numbers are positive or both numbers are negative -> now add them together
-    size_t a_length = value_a->length;  // number of bytes in the big_integer
-    size_t b_length = value_b->length;  // number of bytes in the big_integer
+    // Only the used bytes (and one more byte for the carry) have to be processed.
+    size_t used = max(value_a->used, value_b->used);
+    size_t a_length = min(value_a->length, used + 1);    // number of bytes to process in a
+    size_t b_length = min(value_b->length, value_b->used);  // number of used bytes in b
 
     bool carry = 0;  // carry from byte to byte
     for (size_t i = 0; i < a_length; i++) {
@@ -94,18 +93,27 @@ static void big_integer_addition_sisd(big_integer *value_a, big_integer *value_b
         *(a_byte) = res;
     }
 
+    // the carry byte is only used if the carry reached it
+    value_a->used = (a_length > used && value_a->mem[used] == 0) ? used : a_length;
+
     if (carry == 1) {
         warn("[Binary Addition: SISD] An Overflow occurred while adding two big integers!");
     }
 }
 
 static void big_integer_addition_simd(big_integer *value_a, big_integer *value_b) {
+    count_event(COUNTER_ADDITIONS, 1);
+
     // Assuming both numbers are positive or both numbers are negative -> now add them together
-    size_t a_length = value_a->length;  // number of bytes in the big_integer
-    size_t b_length = value_b->length;  // number of bytes in the big_integer
+    // Only the used bytes (and one more byte for the carry) have to be processed.
+    size_t used = max(value_a->used, value_b->used);
+    size_t a_length = min(value_a->length, used + 1);    // number of bytes to process in a
+    size_t b_length = min(value_b->length, value_b->used);  // number of used bytes in b
 
     bool carry = 0;  // carry from byte to byte
-    size_t i = 0;
+
+    // whole AVX2/AVX-512 vectors first (if supported)
+    size_t i = wide_simd_addition(value_a->mem, value_b->mem, min(a_length, b_length), &carry);
 
     // 15 bytes at a time (SIMD 120 bit)
     for (; (i + 14) < a_length && (i + 14) < b_length; i += 15) {
@@ -205,6 +213,9 @@ static void big_integer_addition_simd(big_integer *value_a, big_integer *value_b
         *(a_byte) = res;
     }
 
+    // the carry byte is only used if the carry reached it
+    value_a->used = (a_length > used && value_a->mem[used] == 0) ? used : a_length;
+
     if (carry == 1) {
         warn("[Binary Addition: SIMD] An Overflow occurred while adding two big integers!");
     }
@@ -220,114 +231,77 @@ void big_integer_subtraction(big_integer *value_a, big_integer *value_b, bool si
     bool a_sign = value_a->sign;
     bool b_sign = value_b->sign;
 
-    if (!a_sign && b_sign) {
-        // a positive; b negative (a - -b) => a + b
-        value_b->sign = false;
-        big_integer_addition(value_a, value_b, simd);
-
-        // restore sign of value b
-        value_b->sign = true;
-        return;
-
-    } else if (a_sign && !b_sign) {
-        // a negative; b positive (-a - b) => -(a + b)
-        value_a->sign = false;
-        big_integer_addition(value_a, value_b, simd);
-
-        // negate result
-        negate_big_integer(value_a);
-        return;
-    } else if (a_sign && b_sign) {
-        //-a - (-b) = -a + b = b - a
-
-        // make a,b positive for calculation
-        value_a->sign = false;
-
-        // make sure that b is big enough to hold the value
-        big_integer *b_copy =
-                clone_big_integer_add_size(value_b, max(0, value_a->length - value_b->length));
-        b_copy->sign = false;
-
-        // b - a
-        big_integer_subtraction(b_copy, value_a, simd);
-
-        // move result into a
-        copy_big_integer_value_into_another(b_copy, value_a);
-
-        delete_big_integer(b_copy);
+    if (a_sign != b_sign) {
+        // (a - -b) => a + b and (-a - b) => -(a + b): add the magnitudes, the sign of a stays
+        if (simd) {
+            big_integer_addition_simd(value_a, value_b);
+        } else {
+            big_integer_addition_sisd(value_a, value_b);
+        }
         return;
     }
 
-    // subtracting two positive values from each other
-
-    /*
-     * special case:
-     * a - b where a < b a:small, b:big
-     * => a - b = -b + a = -(b - a)
-     *
-     */
-    // check if b is greater than a
-    if (positive_big_integer_is_greater_than(value_b, value_a, simd)) {
-        // Save the old value b that will be overwritten by the subtraction method
-        big_integer *b_copy = clone_big_integer(value_b);
-
-        // subtract a from b (because b is big and a is small)
-        big_integer_subtraction(value_b, value_a, simd);  // big - small
+    // a - b and -a - (-b) = -(|a| - |b|)
+    big_integer_magnitude_subtraction(value_a, value_b, a_sign, simd);
+}
 
-        // negate the sign of the result
-        negate_big_integer(value_b);
+/**
+ * Computes sign * (|a| - |b|) and stores the result in the first operand without allocating any
+ * temporary big_integer. The magnitudes are compared once, then either |a| - |b| or |b| - |a| is
+ * written straight into a. The second operand is left untouched.
+ * Make sure that the first operand can hold the whole result value beforehand!
+ * @param value_a The first operand big_integer where the result gets stored to.
+ * @param value_b The second operand big_integer whose magnitude gets subtracted.
+ * @param sign The sign of the result if |a| >= |b| (true: negative). It is flipped otherwise.
+ */
+void big_integer_magnitude_subtraction(big_integer *value_a, big_integer *value_b, bool sign,
+                                       bool simd) {
+    int cmp = big_integer_compare_magnitude(value_a, value_b, simd);
 
-        // set result to original a big_integer (value_b -> value_a)
-        copy_big_integer_value_into_another(value_b, value_a);
-        // restore old value of b (b_copy -> value_b)
-        copy_big_integer_value_into_another(b_copy, value_b);
-
-        delete_big_integer(b_copy);
-        return;
-    }
+    // the greater magnitude is the minuend; a zero result is always positive
+    big_integer *minuend = cmp >= 0 ? value_a : value_b;
+    big_integer *subtrahend = cmp >= 0 ? value_b : value_a;
+    value_a->sign = cmp == 0 ? false : (cmp > 0 ? sign : !sign);
 
     // Choose either SISD or SIMD implementation
     if (simd) {
-        big_integer_subtraction_simd(value_a, value_b);
+        big_integer_subtraction_simd(value_a, minuend, subtrahend);
     } else {
-        big_integer_subtraction_sisd(value_a, value_b);
+        big_integer_subtraction_sisd(value_a, minuend, subtrahend);
     }
 }
 
 /**
- * Subtracts two big_integers from each other and stores the result in the first operand.
- * Note: This function needs the requirement that both values have the same sign and abs(a) is
- * greater than abs(b). Therefore it should not be called outside of this file.
+ * Subtracts the magnitude of the subtrahend from the magnitude of the minuend and stores it in the
+ * result (result = |minuend| - |subtrahend|). The result may be the same big_integer as one of the
+ * operands, because every byte is read before it gets overwritten.
+ * Note: This function needs the requirement that abs(minuend) is greater than or equal to
+ * abs(subtrahend). Therefore it should not be called outside of this file.
  */
-static void big_integer_subtraction_sisd(big_integer *value_a, big_integer *value_b) {
-    // Assuming a is greater than b and a and b are either both positive or both negative
+static void big_integer_subtraction_sisd(big_integer *result, big_integer *minuend,
+                                         big_integer *subtrahend) {
+    count_event(COUNTER_SUBTRACTIONS, 1);
 
-    size_t a_length = value_a->length;  // number of bytes in the big_integer a
-    size_t b_length = value_b->length;  // number of bytes in the big_integer b
+    size_t m_length = minuend->used;     // number of used bytes in the big_integer minuend
+    size_t s_length = subtrahend->used;  // number of used bytes in the big_integer subtrahend
 
-    bool borrow = 0;  // carry from byte to byte
-    for (size_t i = 0; i < a_length; i++) {
-        // pointer to i-th byte values of big_integers a and b
-        uint8_t *a_byte = ((uint8_t *) value_a->mem) + i;
-        uint16_t a = *a_byte;
+    // number of bytes to process in the big_integer result (the other bytes stay zero)
+    size_t r_length = min(result->length, max(m_length, s_length));
 
-        uint16_t res;
-        if (i < b_length) {
-            uint8_t *b_byte = ((uint8_t *) value_b->mem) + i;
-            uint16_t b = *b_byte;
+    bool borrow = 0;  // carry from byte to byte
+    for (size_t i = 0; i < r_length; i++) {
+        // i-th byte values of minuend and subtrahend (zero above their length)
+        uint16_t a = i < m_length ? minuend->mem[i] : 0;
+        uint16_t b = i < s_length ? subtrahend->mem[i] : 0;
 
-            // calculate sum of bytes and carry
-            res = a - b - borrow;
-            borrow = (res >> 15) & 0x1;  // Borrow when result is negative => get sign bit of result
-        } else {
-            // if a is longer than b, we still need to subtract the remaining borrow from a
-            res = a - borrow;
-            borrow = (res >> 15) & 0x1;
-        }
+        // calculate difference of bytes and borrow
+        uint16_t res = a - b - borrow;
+        borrow = (res >> 15) & 0x1;  // Borrow when result is negative => get sign bit of result
 
-        // assign result back to byte in a
-        *((uint8_t *) a_byte) = res;
+        // assign result byte
+        result->mem[i] = res;
     }
+    result->used = r_length;
 
     if (borrow == 1) {
         warn("[Binary Subtraction SISD] An Overflow occurred while subtracting two big integers!");
@@ -338,19 +312,29 @@ static void big_integer_subtraction_sisd(big_integer *value_a, big_integer *valu
  * SIMD-Optimization of big_integer subtraction.
  * First 15 bytes at a time, then 7 bytes at a time, then 1 byte at a time.
  */
-static void big_integer_subtraction_simd(big_integer *value_a, big_integer *value_b) {
-    // Assuming a is greater than b and a and b are either both positive or both negative
+static void big_integer_subtraction_simd(big_integer *result, big_integer *minuend,
+                                         big_integer *subtrahend) {
+    count_event(COUNTER_SUBTRACTIONS, 1);
 
-    size_t a_length = value_a->length;  // number of bytes in the big_integer a
-    size_t b_length = value_b->length;  // number of bytes in the big_integer b
+    size_t m_length = minuend->used;     // number of used bytes in the big_integer minuend
+    size_t s_length = subtrahend->used;  // number of used bytes in the big_integer subtrahend
+
+    // number of bytes to process in the big_integer result (the other bytes stay zero)
+    size_t r_length = min(result->length, max(m_length, s_length));
+
+    // the vectorized loops need all three big_integers to hold the processed bytes
+    size_t common_length = min(r_length, min(m_length, s_length));
 
     bool borrow = 0;  // carry from byte to byte
 
+    // whole AVX2/AVX-512 vectors first (if supported)
+    size_t i = wide_simd_subtraction(result->mem, minuend->mem, subtrahend->mem, common_length,
+                                     &borrow);
+
     // 15 bytes at a time (SIMD 120 bit)
-    size_t i = 0;
-    for (; (i + 14) < a_length && (i + 14) < b_length; i += 15) {
-        __m128i a_bytes = get_15_bytes__of_big_integer(value_a, i);
-        __m128i b_bytes = get_15_bytes__of_big_integer(value_b, i);
+    for (; (i + 14) < common_length; i += 15) {
+        __m128i a_bytes = get_15_bytes__of_big_integer(minuend, i);
+        __m128i b_bytes = get_15_bytes__of_big_integer(subtrahend, i);
 
         // add two 128-bit integers (not directly supported in one function)
         // => add packed 64-bit integers and do carry manually
@@ -367,8 +351,8 @@ static void big_integer_subtraction_simd(big_integer *value_a, big_integer *valu
         // previous borrow as a 128-bit number
         __m128i borrow_128 = _mm_set_epi32(0, 0, 0, (int) borrow);
 
-        __m128i result = _mm_sub_epi64(a_bytes, b_bytes);
-        result = _mm_sub_epi64(result, borrow_128);
+        __m128i difference = _mm_sub_epi64(a_bytes, b_bytes);
+        difference = _mm_sub_epi64(difference, borrow_128);
 
         // if result is greater than a => borrow
         // subtract 2^63 from lower_result, a_lower and b_lower
@@ -377,7 +361,7 @@ static void big_integer_subtraction_simd(big_integer *value_a, big_integer *valu
         // convert unsigned values to signed values for comparison
         __m128i a_lower_signed = _mm_sub_epi64(a_lower, sub_mask);
 
-        __m128i first_result_lower = _mm_and_si128(result, lower64_mask);
+        __m128i first_result_lower = _mm_and_si128(difference, lower64_mask);
         __m128i lower_result_signed = _mm_sub_epi64(first_result_lower, sub_mask);
 
         // has lower half set to all ones when a borrow happens
@@ -392,53 +376,44 @@ static void big_integer_subtraction_simd(big_integer *value_a, big_integer *valu
         if (borrow_happens) {
             // sub 1 from higher 56 bit
             __m128i higher_1 = _mm_set_epi64x(1, 0);
-            result = _mm_sub_epi64(result, higher_1);
+            difference = _mm_sub_epi64(difference, higher_1);
         }
         // get 0th byte (from the left) to extract borrow bit
-        uint16_t highest_bytes = _mm_extract_epi16(result, 7);
+        uint16_t highest_bytes = _mm_extract_epi16(difference, 7);
         borrow = (highest_bytes >> 15) & 0x01;
 
-        // write result back into a
-        set_15_bytes__of_big_integer(value_a, i, result);
+        // write difference into the result
+        set_15_bytes__of_big_integer(result, i, difference);
     }
 
     // 7 bytes at a time (SIMD 56 bit)
-    for (; (i + 6) < a_length && (i + 6) < b_length; i += 7) {
-        uint64_t a_qword = get_7_bytes__of_big_integer(value_a, i);
-        uint64_t b_qword = get_7_bytes__of_big_integer(value_b, i);
+    for (; (i + 6) < common_length; i += 7) {
+        uint64_t a_qword = get_7_bytes__of_big_integer(minuend, i);
+        uint64_t b_qword = get_7_bytes__of_big_integer(subtrahend, i);
 
         uint64_t res = a_qword - b_qword;
         res -= borrow;
         // get 0th byte (from the left) to extract carry bit
         borrow = (res >> 56) & 0x1;
 
-        // write result back into a
-        set_7_bytes__of_big_integer(value_a, i, res);
+        // write difference into the result
+        set_7_bytes__of_big_integer(result, i, res);
     }
 
     // 1 byte at a time (byte-wise SISD)
-    for (; i < a_length; i++) {
-        // pointer to i-th byte values of big_integers a and b
-        uint8_t *a_byte = ((uint8_t *) value_a->mem) + i;
-        uint16_t a = *a_byte;
+    for (; i < r_length; i++) {
+        // i-th byte values of minuend and subtrahend (zero above their length)
+        uint16_t a = i < m_length ? minuend->mem[i] : 0;
+        uint16_t b = i < s_length ? subtrahend->mem[i] : 0;
 
-        uint16_t res;
-        if (i < b_length) {
-            uint8_t *b_byte = ((uint8_t *) value_b->mem) + i;
-            uint16_t b = *b_byte;
+        // calculate difference of bytes and borrow
+        uint16_t res = a - b - borrow;
+        borrow = (res >> 15) & 0x1;  // Borrow when result is negative => get sign bit of result
 
-            // calculate sum of bytes and carry
-            res = a - b - borrow;
-            borrow = (res >> 15) & 0x1;  // Borrow when result is negative => get sign bit of result
-        } else {
-            // if a is longer than b, we still need to subtract the remaining borrow from a
-            res = a - borrow;
-            borrow = (res >> 15) & 0x1;
-        }
-
-        // assign result back to byte in a
-        *((uint8_t *) a_byte) = res;
+        // assign result byte
+        result->mem[i] = res;
     }
+    result->used = r_length;
 
     if (borrow == 1) {
         warn("[Binary Subtraction SIMD] An Underflow occurred while subtracting two big integers!");
@@ -451,7 +426,9 @@ static void big_integer_subtraction_simd(big_integer *value_a, big_integer *valu
  */
 void big_integer_increment(big_integer *value) {
     bool sign = value->sign;
-    for (size_t i = 0; i < value->length; i++) {
+    // a positive value can carry into the byte above the used bytes
+    size_t length = sign ? value->used : value->length;
+    for (size_t i = 0; i < length; i++) {
         // when positive: +1
         // when negative: -1
         uint8_t byte = get_byte_value_of_big_integer(value, i);
@@ -480,6 +457,7 @@ void big_integer_increment(big_integer *value) {
  * @param result The pointer to the big_integer where the result should be stored.
  */
 void big_integer_shl_bitwise_0_to_7(big_integer *value, uint8_t bit_count, bool simd) {
+    count_event(COUNTER_SHIFTS, 1);
     if (simd)
         big_integer_shl_bitwise_0_to_7__simd56(value, bit_count);
     else
@@ -487,7 +465,8 @@ void big_integer_shl_bitwise_0_to_7(big_integer *value, uint8_t bit_count, bool
 }
 
 void big_integer_shl_bitwise_0_to_7__sisd(big_integer *value, uint8_t bit_count) {
-    int length = (int) value->length;
+    // only the used bytes and the byte above them (shifted-in bits) are processed
+    int length = (int) min(value->length, value->used + 1);
 
     // one byte at a time (SISD)
     uint8_t carry = 0;
@@ -508,7 +487,15 @@ void big_integer_shl_bitwise_0_to_7__sisd(big_integer *value, uint8_t bit_count)
 }
 
 void big_integer_shl_bitwise_0_to_7__simd56(big_integer *value, uint8_t bit_count) {
-    int length = (int) value->length;
+    // only the used bytes and the byte above them (shifted-in bits) are processed
+    int length = (int) min(value->length, value->used + 1);
+
+    // AVX2/AVX-512 (if supported) shift all bytes at once
+    if (wide_simd_shift_left(value->mem, length, bit_count)) {
+        // the shifted bits can only reach the byte above the used ones
+        if ((size_t) length > value->used && value->mem[value->used] != 0) value->used = length;
+        return;
+    }
 
     // 7 bytes at a time (SIMD 56)
     // we put 7 bytes into 8 byte registers and then shift by [0;7], so we only need one byte more
@@ -549,63 +536,330 @@ void big_integer_shl_bitwise_0_to_7__simd56(big_integer *value, uint8_t bit_coun
  * @param count The number of bytes the big_integer should be shifted to left.
  */
 void big_integer_shl_byte_wise(big_integer *value, size_t count) {
-    // Copy the values from 0 to length-2 from the original value one byte up
-    // because the first <count> bytes should be set to zero.
+    big_integer_shl(value, count * 8);
+}
+
+/**
+ * Reads count (at most 8) bytes starting at index as a little-endian word.
+ */
+static uint64_t load_bytes(const uint8_t *mem, size_t index, size_t count) {
+    uint64_t word = 0;
+    memcpy(&word, mem + index, count);
+    return word;
+}
+
+static void store_bytes(uint8_t *mem, size_t index, size_t count, uint64_t word) {
+    memcpy(mem + index, &word, count);
+}
+
+/**
+ * Shifts the given big_integer left by any number of bits (in-place). Whole bytes are moved with
+ * memmove. Otherwise every word of the result is a funnel shift of a source word and the byte below
+ * it, from the most to the least significant word, so every source byte is read before it gets
+ * overwritten. Bits that are shifted beyond the length of the big_integer are cut.
+ * @param value The big_integer to shift.
+ * @param bit_count The number of bits the big_integer is shifted to the left.
+ */
+void big_integer_shl(big_integer *value, size_t bit_count) {
+    count_event(COUNTER_SHIFTS, 1);
+
+    size_t bytes = bit_count / 8;
+    uint8_t bits = bit_count % 8;
+    if (bytes >= value->length) {
+        // every byte is shifted out
+        set_zero(value);
+        return;
+    }
+
+    uint8_t *mem = value->mem;
+    if (bits == 0) {
+        // Move the used bytes <bytes> bytes up (the bytes above them are zero already)
+        size_t used = min(value->used, value->length - bytes);
+        if (used == 0) return;
+
+        memmove(mem + bytes, mem, used);
+        memset(mem, 0, bytes);
+        value->used = used + bytes;
+        return;
+    }
+
+    // the shifted bits can reach the byte above the used ones
+    size_t end = min(value->length, value->used + bytes + 1);
+    for (size_t top = end; top > bytes;) {
+        size_t start = top - bytes > 8 ? top - 8 : bytes;
+        size_t source = start - bytes;
 
-    for (int i = value->length - count - 1; i >= 0; i--) {
-        // length 8, shl 2: 8 - 2 - 1 = 5
-        set_byte_value_of_big_integer(value, i + count, get_byte_value_of_big_integer(value, i));
+        uint64_t word = load_bytes(mem, source, top - start) << bits;
+        if (source > 0) word |= mem[source - 1] >> (8 - bits);
+        store_bytes(mem, start, top - start, word);
+
+        top = start;
     }
-    for (size_t i = 0; i < count; i++) {
-        set_byte_value_of_big_integer(value, i, 0);
+    memset(mem, 0, bytes);
+
+    value->used = end;
+    if (mem[end - 1] == 0) value->used--;
+}
+
+/**
+ * Adds the whole words of source << bits to mem, the bytes [i, end) of mem are processed (source
+ * starts at byte index bytes of mem). Every word is a funnel shift of the source word and the word
+ * below it.
+ * @return The index of the first byte after the processed words.
+ */
+static size_t add_shifted_words(uint8_t *mem, const uint8_t *source, size_t i, size_t end,
+                                size_t bytes, uint8_t bits, bool *carry) {
+    size_t j = i - bytes;
+    // the bits that are shifted out of a word are shifted into the next one
+    uint64_t spilled = j >= 8 ? (load_bytes(source, j - 8, 8) >> 1) >> (63 - bits) : 0;
+    unsigned char c = *carry;
+    for (; i + 8 <= end; i += 8, j += 8) {
+        uint64_t word = load_bytes(source, j, 8);
+        unsigned long long sum;
+        c = _addcarry_u64(c, load_bytes(mem, i, 8), (word << bits) | spilled, &sum);
+        store_bytes(mem, i, 8, sum);
+        spilled = (word >> 1) >> (63 - bits);
+    }
+    *carry = c;
+    return i;
+}
+
+/**
+ * Adds the magnitude of value shifted left by bit_count bits to the magnitude of the accumulator
+ * (|accumulator| += |value| << bit_count) without materializing the shifted value. Only the bytes
+ * of the accumulator from bit_count / 8 up to the last carry are processed, the signs are not
+ * changed. The shifted value is built on the fly with funnel shifts (in AVX2/AVX-512 vectors and
+ * 8 bytes at a time with ADC if simd is set, otherwise one byte at a time).
+ * Make sure that the accumulator can hold the whole result (higher bits are cut)!
+ * @param accumulator The big_integer the shifted value gets added to.
+ * @param value The big_integer that is shifted. This must not be the same big_integer as the
+ * accumulator!
+ * @param bit_count The number of bits the value is shifted to the left.
+ * @param simd Flag if 8 bytes should be added at once.
+ */
+void big_integer_add_shifted(big_integer *accumulator, big_integer *value, size_t bit_count,
+                             bool simd) {
+    count_event(COUNTER_ADDITIONS, 1);
+
+    size_t bytes = bit_count / 8;
+    uint8_t bits = bit_count % 8;
+    size_t length = accumulator->length;
+    if (value->used == 0 || bytes >= length) return;
+
+    // the shifted value has one byte more if the bits reach it
+    size_t end = min(length, bytes + value->used + (bits != 0));
+    uint8_t *mem = accumulator->mem;
+
+    size_t i = bytes;
+    bool carry = false;
+    if (simd) {
+        // the whole words of the value: the first word, whole AVX2/AVX-512 vectors (they need the
+        // word below) and the rest of the words
+        size_t words_end = min(end, bytes + value->used);
+        i = add_shifted_words(mem, value->mem, i, min(words_end, bytes + 8), bytes, bits, &carry);
+        if (i == bytes + 8) {
+            i += wide_simd_add_shifted(mem + i, value->mem + 8, words_end - i, bits, &carry);
+        }
+        i = add_shifted_words(mem, value->mem, i, words_end, bytes, bits, &carry);
+    }
+    // the remaining bytes (all bytes in sisd), one byte at a time
+    const uint8_t *source = value->mem;
+    size_t used = value->used;
+    uint8_t below = i > bytes ? source[i - bytes - 1] : 0;
+    for (; i < end; i++) {
+        uint8_t byte = i - bytes < used ? source[i - bytes] : 0;
+        uint16_t sum = mem[i] + (uint8_t) ((byte << bits) | (below >> (8 - bits))) + carry;
+        mem[i] = (uint8_t) sum;
+        carry = sum >> 8;
+        below = byte;
+    }
+
+    // propagate the carry
+    for (; carry && i < length; i++) {
+        carry = ++mem[i] == 0;
+    }
+
+    // the bytes above the carry are untouched, the written ones may have become zero
+    while (i > accumulator->used && mem[i - 1] == 0) {
+        i--;
+    }
+    if (i > accumulator->used) accumulator->used = i;
+
+    if (carry == 1) {
+        warn("[Binary Shifted Addition] An Overflow occurred while adding two big integers!");
     }
 }
 
 /**
  * Multiplies a big_integer by the given 8 bit unsigned value and returns the big_integer containing
  * the result. (This is used for multiplying the weight of a digit with its digit value (which is
- * between 0 and incl. 255).
+ * between 0 and incl. 255). The value is added shifted by the position of every set bit of mul.
  * @param value The big_integer value to be multiplied. This must not be the same big_integer as
  * result!
  * @param mul The factor with which the first factor gets multiplied.
  * @param result The big_integer in which the result of the multiplication will be written to.
- * @param temp A big_integer that is big enough to store the value + 1 byte (!), that can be used as
- * a temporary value (caller-saved)
  * @param simd Flag if simd operations should be used or not.
  * The result of a big_integer multiplied by one byte fits into a big_integer of length of value + 1
  */
-void big_integer_multiply_uint8(big_integer *value, uint8_t mul, big_integer *result,
-                                big_integer *temp, bool simd) {
+void big_integer_multiply_uint8(big_integer *value, uint8_t mul, big_integer *result, bool simd) {
+    count_event(COUNTER_UINT8_MULTIPLICATIONS, 1);
+
     // Clear the big_integer where the result will be written into
     set_zero(result);
 
-    // Partial product is initialized as the copy of the value with 1 byte more space
-    // because the left bit-shift can otherwise shift the highest bits out of bounds.
-    copy_big_integer_value_into_another(value, temp);
-
-    int to_shift = 0;
-    // Multiply with uint8
     for (int i = 0; i < 8; i++) {
-        bool bit = (mul >> i) & 0x1;  // get i-th bit
-        if (bit) {                    // if (bit != 0)
+        if ((mul >> i) & 0x1) {
+            big_integer_add_shifted(result, value, i, simd);
+        }
+    }
+
+    // the result has the sign of the value (zero is positive)
+    result->sign = value->sign && big_integer_used_bytes(result) > 0;
+}
 
-            if (i != 0) {
-                // shift partial product left
-                big_integer_shl_bitwise_0_to_7(temp, 1 + to_shift, simd);
-                to_shift = 0;
+/**
+ * Adds the partial products of a and the bytes [start, end) of b to res: a is added shifted by the
+ * position of every set bit of the bytes.
+ */
+static void multiply_bytes(big_integer *a, big_integer *b, size_t start, size_t end,
+                           big_integer *res, bool simd) {
+    for (size_t i = start; i < end; i++) {
+        uint8_t byte = get_byte_value_of_big_integer(b, i);
+        for (size_t j = 0; byte != 0; j++, byte >>= 1) {
+            if (byte & 0x1) {
+                big_integer_add_shifted(res, a, 8 * i + j, simd);
             }
-            // add partial product to result
-            big_integer_addition(result, temp, simd);
+        }
+    }
+}
 
-        } else if (i != 0) {
-            to_shift++;
+/**
+ * Adds the partial products of the square of a that belong to the bytes [start, end) of a to res:
+ * For every byte a_p the cross products 2 * a_p * a_q of the bytes q > p (a_q * a_p is the same
+ * product, so it is only computed once) and the diagonal product a_p * a_p are added.
+ */
+static void square_bytes(big_integer *a, size_t start, size_t end, big_integer *res, bool simd) {
+    for (size_t p = start; p < end; p++) {
+        uint8_t byte = get_byte_value_of_big_integer(a, p);
+        if (byte == 0) continue;
+
+        // the bytes above p as a big_integer of their own: a_q * 256^(p + q) is that value shifted
+        // by 2p + 1 bytes, one more bit doubles the cross product
+        size_t above = a->used - p - 1;
+        big_integer upper = {false, above, above, a->mem + p + 1};
+        for (size_t j = 0; j < 8; j++) {
+            if ((byte >> j) & 0x1) {
+                big_integer_add_shifted(res, &upper, 8 * (2 * p + 1) + j + 1, simd);
+            }
         }
+
+        uint16_t product = byte * byte;
+        uint8_t diagonal_bytes[2] = {(uint8_t) product, (uint8_t) (product >> 8)};
+        big_integer diagonal = {false, 2, 2, diagonal_bytes};
+        big_integer_add_shifted(res, &diagonal, 16 * p, simd);
     }
 }
 
+/* minimum number of bytes of b per block of the parallel multiplication */
+#define MULTIPLICATION_BLOCK_MIN_BYTES 256
+
+/**
+ * A block of bytes of b whose partial products are summed up on their own.
+ */
+typedef struct multiplication_block {
+    big_integer *a;
+    big_integer *b;
+    size_t start;
+    size_t end;
+    big_integer *sum;
+    bool simd;
+} multiplication_block;
+
+static void multiply_block(void *context, size_t index) {
+    multiplication_block *block = (multiplication_block *) context + index;
+    multiply_bytes(block->a, block->b, block->start, block->end, block->sum, block->simd);
+}
+
+static void square_block(void *context, size_t index) {
+    multiplication_block *block = (multiplication_block *) context + index;
+    square_bytes(block->a, block->start, block->end, block->sum, block->simd);
+}
+
+/**
+ * Returns the number of blocks the bytes of a factor of the given length are split into (one per
+ * thread of the thread pool at most).
+ */
+static size_t multiplication_block_count(size_t length) {
+    size_t block_count = length / MULTIPLICATION_BLOCK_MIN_BYTES;
+    if (block_count > thread_pool_threads()) block_count = thread_pool_threads();
+    return block_count;
+}
+
+/**
+ * Sums up the partial products of the blocks in parallel (every block gets its own sum of the
+ * length of res) and adds the sums to res at the end.
+ */
+static void run_multiplication_blocks(multiplication_block *blocks, size_t block_count,
+                                      void (*run)(void *context, size_t index), big_integer *res,
+                                      bool simd) {
+    for (size_t i = 0; i < block_count; i++) {
+        blocks[i].sum = create_big_integer(res->length, false);
+    }
+
+    thread_pool_run(block_count, run, blocks);
+
+    // final carry pass over the sums of the blocks
+    for (size_t i = 0; i < block_count; i++) {
+        big_integer_addition(res, blocks[i].sum, simd);
+        delete_big_integer(blocks[i].sum);
+    }
+}
+
+/**
+ * Squares the big_integer a and stores the result in the big_integer which pointer is given as
+ * argument. Every cross product of two different bytes is computed only once and doubled, so only
+ * about half of the shifted additions of big_integer_multiplication(a, a, ...) are needed. If a is
+ * long enough, its bytes are split into blocks of about the same work (the lower bytes have more
+ * cross products) which are summed up in parallel.
+ * @param a The operand a.
+ * @param res The big_integer where the square will be written into. Make sure that this is big
+ * enough to hold the full value and that it is not the same big_integer as a. This function does
+ * not check the size.
+ * @param simd True when SIMD-implementation should be used.
+ */
+void big_integer_square(big_integer *a, big_integer *res, bool simd) {
+    size_t a_len = big_integer_used_bytes(a);
+    size_t block_count = multiplication_block_count(a_len);
+
+    if (block_count <= 1) {
+        square_bytes(a, 0, a_len, res, simd);
+    } else {
+        multiplication_block *blocks = malloc(block_count * sizeof(multiplication_block));
+        check_alloc(blocks, block_count * sizeof(multiplication_block), "multiplication blocks");
+        // the bytes [0, p) have a share of 1 - (1 - p / a_len)^2 of the work
+        size_t start = 0;
+        for (size_t i = 0; i < block_count; i++) {
+            size_t end = a_len;
+            if (i + 1 < block_count) {
+                end = (size_t) (a_len * (1 - sqrt(1 - (double) (i + 1) / block_count)));
+            }
+            multiplication_block block = {a, a, start, end, NULL, simd};
+            blocks[i] = block;
+            start = end;
+        }
+
+        run_multiplication_blocks(blocks, block_count, square_block, res, simd);
+        free(blocks);
+    }
+
+    res->sign = false;
+}
+
 /**
  * Multiplies the big_integers a and b byte-wise and stores the result in the big_integer which
- * pointer is given as argument.
+ * pointer is given as argument. If b is long enough, it is split into blocks of bytes (one per
+ * thread of the thread pool) whose partial products are summed up in parallel and added to the
+ * result at the end. Factors with the same magnitude are squared with big_integer_square.
  * @param a First operand a.
  * @param b Second operand b.
  * @param res The big_integer where the result of the multiplication will be written into. Make sure
@@ -613,47 +867,96 @@ void big_integer_multiply_uint8(big_integer *value, uint8_t mul, big_integer *re
  * @param simd True when SIMD-implementation should be used.
  */
 void big_integer_multiplication(big_integer *a, big_integer *b, big_integer *res, bool simd) {
-    size_t b_len = b->length;
+    // the bytes of b above the used ones are zero and do not contribute
+    size_t b_len = big_integer_used_bytes(b);
 
-    big_integer *pp = create_big_integer(res->length, false);
-    big_integer *temp = create_big_integer(a->length + 1, false);
-
-    // Multiply
-    // Start significant byte of b
-    for (size_t i = 0; i < b_len; i++) {
-        uint8_t byte = get_byte_value_of_big_integer(b, i);
-        if (byte == 0) continue;
+    if (a == b || (big_integer_used_bytes(a) == b_len && memcmp(a->mem, b->mem, b_len) == 0)) {
+        big_integer_square(a, res, simd);
+    } else {
+        size_t block_count = multiplication_block_count(b_len);
 
-        // Multiply current byte of b with whole of a
-        big_integer_multiply_uint8(a, byte, pp, temp, simd);
-        big_integer_shl_byte_wise(pp, i);
+        if (block_count <= 1) {
+            multiply_bytes(a, b, 0, b_len, res, simd);
+        } else {
+            multiplication_block *blocks = malloc(block_count * sizeof(multiplication_block));
+            check_alloc(blocks, block_count * sizeof(multiplication_block),
+                        "multiplication blocks");
+            for (size_t i = 0; i < block_count; i++) {
+                multiplication_block block = {a, b, b_len * i / block_count,
+                                              b_len * (i + 1) / block_count, NULL, simd};
+                blocks[i] = block;
+            }
 
-        big_integer_addition(res, pp, simd);
+            run_multiplication_blocks(blocks, block_count, multiply_block, res, simd);
+            free(blocks);
+        }
     }
 
-    delete_big_integer(pp);
-    delete_big_integer(temp);
-
     // Change sign accordingly
     // negative when either: -v * m = -r OR v * -m = -r
     res->sign = (a->sign && !b->sign) || (b->sign && !a->sign);
 }
 
+/**
+ * Calculates value^exponent with the left-to-right binary exponentiation (square-and-multiply):
+ * Starting with value, the power is squared for every bit of the exponent below the most
+ * significant one and multiplied by value if the bit is set. The intermediate powers alternate
+ * between res and temp, which one holds the first power is chosen so that the last one is in res.
+ * @param value The base of the power. This must not be the same big_integer as res or temp!
+ * @param exponent The exponent (value^0 is 1).
+ * @param res The big_integer where the power will be written into. Make sure that this is big
+ * enough to hold the full value (see get_big_integer_min_size_exponentiation). This function does
+ * not check the size.
+ * @param temp A big_integer with the same length as res for the intermediate powers.
+ * @param simd True when SIMD-implementation should be used.
+ */
+void big_integer_power(big_integer *value, uint64_t exponent, big_integer *res, big_integer *temp,
+                       bool simd) {
+    set_zero(res);
+    if (exponent == 0) {
+        set_byte_value_of_big_integer(res, 0, 1);
+        return;
+    }
+
+    // the number of squarings and multiplications after the first power
+    int top = 63 - __builtin_clzll(exponent);
+    int steps = top + __builtin_popcountll(exponent) - 1;
+
+    big_integer *power = steps % 2 == 0 ? res : temp;
+    big_integer *next = steps % 2 == 0 ? temp : res;
+    copy_big_integer_value_into_another(value, power);
+
+    for (int bit = top - 1; bit >= 0; bit--) {
+        set_zero(next);
+        big_integer_square(power, next, simd);
+        big_integer *swap = power;
+        power = next;
+        next = swap;
+
+        if ((exponent >> bit) & 0x1) {
+            // the short factor is the second one: a few long shifted additions
+            set_zero(next);
+            big_integer_multiplication(power, value, next, simd);
+            swap = power;
+            power = next;
+            next = swap;
+        }
+    }
+}
+
 /**
  * Multiply big_integer with signed 16-bit integer only in range [-256;256] (Wider range than radix).
  * (Used for multiplying a multiple of a base with the base itself i.e. calculating the power of a
  * base).
  * @param value The value to be multiplied. Doesn't get changed in this method.
  * @param mul The signed 16-bit integer.
- * @param temp A big_integer that is big enough to store the value that can be used as a temporary
- * value (caller-saved)
  * @param simd Flag if simd operations should be used or not.
  */
 void big_integer_multiply_int_neg256_to_256(big_integer *value, int16_t mul, big_integer *result,
-                                            big_integer *temp, bool simd) {
+                                            bool simd) {
     // Call big_integer multiplication uint8 with absolute value of mul (absolute of signed 16-bit
     // is unsigned 8-bit).
-    big_integer_multiply_uint8(value, abs(mul), result, temp, simd);
+    big_integer_multiply_uint8(value, abs(mul), result, simd);
 
     // If needed, change the sign from the result to negative.
     // either: -v * m = -r OR v * -m = -r
@@ -662,75 +965,55 @@ void big_integer_multiply_int_neg256_to_256(big_integer *value, int16_t mul, big
 
 /**
  * Divides the big_integer value by divisor (signed 16 bit integer in range [-128; 128]). The
- * big_integer will contain the result of the division.
+ * big_integer will contain the result of the division. The bytes are divided from the most to the
+ * least significant byte with a running remainder (short division), no memory is allocated.
  * @param value The value to be divided.
  * @param divisor The divisor with which the value gets divided.
- * @param temp_value A temp big_integer that should be big enough to hold the result of the
- * division.
- * @param temp_value2 A temporary big_integer that should be big enough to hold the value of the
- * remainder.
- * @return Returns the remainder (Euclidean mod) of the division of value and divisor.
+ * @param simd Flag if 7 bytes should be divided at once (with a single 64-bit division) instead of
+ * one byte at a time.
+ * @return Returns the remainder of the division of value and divisor, it has the sign of value.
  */
-int16_t big_integer_division_int9_t(big_integer *value, int16_t divisor, big_integer *temp_value,
-                                    big_integer *temp_value2, bool simd) {
-    // Using naive unsigned binary long division algorithm
+int16_t big_integer_division_int9_t(big_integer *value, int16_t divisor, bool simd) {
     if (divisor == 0) {
         abort_err("[FATAL] big_integer_division_int9_t: Division by zero.");
     }
+    count_event(COUNTER_DIVISIONS, 1);
 
     // perform unsigned division, change sign and remainder later
-    uint8_t div = abs(divisor);
+    uint64_t div = abs(divisor);
     bool value_sign = value->sign;
-    value->sign = false;
-
-    big_integer *quotient = temp_value;
-    set_zero(quotient);
-
-    // holds the remainder in the end, temporary values while calculating
-    big_integer *remainder = temp_value2;
-    set_zero(remainder);
-
-    big_integer *divisor_big = create_big_integer(2, false);  // used for later
-    set_byte_value_of_big_integer(divisor_big, 0, abs(divisor));
-
-    // i for every byte in value
-    // j for every bit in every byte (Decrementing because we start at the most significant
-    // byte/bit)
-    for (int i = value->length - 1; i >= 0; i--) {
-        for (int j = 7; j >= 0; j--) {
-            // shift the remainder left by one
-            big_integer_shl_bitwise_0_to_7(remainder, 1, simd);
-
-            // set the lowest bit of the remainder to the current (i-th) bit of the value
-            bool bit_i = (get_byte_value_of_big_integer(value, i) >> j) & 0x1;
-            set_byte_value_of_big_integer(remainder, 0,
-                                          get_byte_value_of_big_integer(remainder, 0) | bit_i);
-
-            bool b = big_integer_greater_equal_int16(remainder, div, simd);
-            if (b) {
-                // remainder -= divisor
-                big_integer_subtraction(remainder, divisor_big, simd);
-                set_bit_value_of_big_integer(quotient, i * 8 + j, 1);
-            }
+
+    // the quotient bytes above the used bytes stay zero
+    uint64_t remainder = 0;
+    size_t i = value->used;
+
+    if (simd) {
+        // remainder < div <= 256, therefore remainder * 2^56 + 7 bytes always fits into 64 bits
+        while (i >= 7) {
+            i -= 7;
+            uint64_t dividend = (remainder << 56) | get_7_bytes__of_big_integer(value, i);
+            set_7_bytes__of_big_integer(value, i, dividend / div);
+            remainder = dividend % div;
         }
     }
 
-    // copy result into value big_integer
-    copy_big_integer_value_into_another(quotient, value);
-    int16_t remainder16 = get_byte_value_of_big_integer(remainder, 0);
+    // divide the remaining bytes (all bytes in sisd)
+    while (i > 0) {
+        i--;
+        uint64_t dividend = (remainder << 8) | get_byte_value_of_big_integer(value, i);
+        set_byte_value_of_big_integer(value, i, dividend / div);
+        remainder = dividend % div;
+    }
 
     // change sign and remainder
-    if ((value_sign && divisor > 0) || (!value_sign && divisor < 0)) {
-        value->sign = true;
-    }
+    value->sign = value_sign != (divisor < 0);
+
+    int16_t remainder16 = (int16_t) remainder;
     if (value_sign) {
         // the remainder is always positive and only positive when the first operand is negative
         remainder16 *= -1;
     }
 
-    // clear memory
-    delete_big_integer(divisor_big);
-
     return remainder16;
 }
 
@@ -740,6 +1023,76 @@ int16_t big_integer_division_int9_t(big_integer *value, int16_t divisor, big_int
  * =====================================================================
  */
 
+/**
+ * Compares the bytes of a and b below length from the most significant one down, 8 bytes (one
+ * little endian word) at a time.
+ * @return -1 if a < b, 0 if a = b and 1 if a > b.
+ */
+static int compare_bytes_sisd(const uint8_t *a, const uint8_t *b, size_t length) {
+    size_t i = length;
+    for (; i >= 8; i -= 8) {
+        uint64_t a_word, b_word;
+        memcpy(&a_word, a + i - 8, 8);
+        memcpy(&b_word, b + i - 8, 8);
+        if (a_word != b_word) return a_word > b_word ? 1 : -1;
+    }
+    for (; i > 0; i--) {
+        if (a[i - 1] != b[i - 1]) return a[i - 1] > b[i - 1] ? 1 : -1;
+    }
+    return 0;
+}
+
+/**
+ * Compares the bytes of a and b below length from the most significant one down: the equal vectors
+ * are skipped (AVX2/AVX-512, then 16 bytes with SSE), only the most significant differing byte is
+ * compared.
+ * @return -1 if a < b, 0 if a = b and 1 if a > b.
+ */
+static int compare_bytes_simd(const uint8_t *a, const uint8_t *b, size_t length) {
+    size_t i = wide_simd_skip_equal(a, b, length);
+    for (; i >= 16; i -= 16) {
+        __m128i x = _mm_loadu_si128((const __m128i *) (a + i - 16));
+        __m128i y = _mm_loadu_si128((const __m128i *) (b + i - 16));
+        unsigned int different = ~_mm_movemask_epi8(_mm_cmpeq_epi8(x, y)) & 0xFFFF;
+        if (different != 0) {
+            size_t index = i - 16 + (31 - __builtin_clz(different));
+            return a[index] > b[index] ? 1 : -1;
+        }
+    }
+    return compare_bytes_sisd(a, b, i);
+}
+
+/**
+ * Compares the magnitudes (absolute values) of two big_integers, ignoring their signs. The numbers
+ * of significant bytes are compared first, equal numbers are scanned once from the most
+ * significant byte down.
+ * @return -1 if |a| < |b|, 0 if |a| = |b| and 1 if |a| > |b|.
+ */
+int big_integer_compare_magnitude(big_integer *a, big_integer *b, bool simd) {
+    size_t a_used = big_integer_used_bytes(a);
+    size_t b_used = big_integer_used_bytes(b);
+
+    // the value with more significant bytes is greater
+    if (a_used != b_used) return a_used > b_used ? 1 : -1;
+    if (a == b) return 0;
+
+    return simd ? compare_bytes_simd(a->mem, b->mem, a_used)
+                : compare_bytes_sisd(a->mem, b->mem, a_used);
+}
+
+/**
+ * Compares the signed values of two big_integers (+0 and -0 are equal).
+ * @return -1 if a < b, 0 if a = b and 1 if a > b.
+ */
+int big_integer_compare(big_integer *a, big_integer *b, bool simd) {
+    bool a_negative = a->sign && big_integer_used_bytes(a) > 0;
+    bool b_negative = b->sign && big_integer_used_bytes(b) > 0;
+    if (a_negative != b_negative) return a_negative ? -1 : 1;
+
+    int cmp = big_integer_compare_magnitude(a, b, simd);
+    return a_negative ? -cmp : cmp;
+}
+
 /**
  * Return whether a is greater than b. Only limited to positive big_integers!
  * @param a
@@ -752,47 +1105,7 @@ bool positive_big_integer_is_greater_than(big_integer *a, big_integer *b, bool s
                 "big_integers!");
     }
 
-    int a_len = (int) a->length;
-    int b_len = (int) b->length;
-    size_t max_length = max(a_len, b_len);
-
-    bool a_zero = big_integer_is_zero(a, simd);
-    bool b_zero = big_integer_is_zero(b, simd);
-
-    if (a_zero && b_zero) return false;  // a = b = 0
-    if (a_zero && !b->sign) return false;  // a = 0; b > 0 => a < b
-
-    // going from last (most significant) byte to lowest
-    for (int i = (int) max_length - 1; i >= 0; i--) {
-        uint8_t a_byte = 0;
-        uint8_t b_byte = 0;
-
-        if (i < a_len) {
-            a_byte = get_byte_value_of_big_integer(a, i);
-        }
-        if (i < b_len) {
-            b_byte = get_byte_value_of_big_integer(b, i);
-        }
-
-        // a/b has higher weight bytes than the other number that are not zero.
-        if (i >= b_len && i < a_len) {
-            if (a_byte != 0) {
-                // a is longer and has non null-bytes -> a is greater than b"
-                return true;
-            } else continue;
-        }
-        if (i >= a_len && i < b_len) {
-            if (b_byte != 0) {
-                // b is longer and has non null-bytes -> b is greater than a"
-                return false;
-            } else continue;
-        }
-        if (a_byte == b_byte) {
-            continue;
-        }
-        return a_byte > b_byte;
-    }
-    return false;
+    return big_integer_compare_magnitude(a, b, simd) > 0;
 }
 
 /**
@@ -802,79 +1115,12 @@ bool positive_big_integer_is_greater_than(big_integer *a, big_integer *b, bool s
  * @param b
  */
 bool big_integer_greater_equal_int16(big_integer *a, int16_t b, bool simd) {
-    size_t len = a->length;
-    bool a_negative = a->sign;
-
-    bool a_zero = big_integer_is_zero(a, simd);
-    bool b_zero = b == 0;
-
-    // check trivial cases: one/both zero, signs different
-    if (a_zero && b_zero) return true;  // a = b = 0
-
-    if (a_zero && b < 0) return true;   // a = 0; b < 0 => a > b
-    if (a_zero && b > 0) return false;  // a = 0; b > 0 => a < b
-
-    if (a_negative && b >= 0) return false;  // a < 0 <= b => a < b
-    if (!a_negative && b <= 0) return true;  // a > 0 >= b => a > b
-
-    // The following code compares the big_integer with the 9bit signed integer after the following
-    // rules:
-    /*
-     *  fb = first byte of a
-     *  both positive:
-     *     fb == b: equal (or potentially is a greater than b) => return true
-     *     fb > b: a definitely greater than b => return true
-     *     fb < b: check for each byte [1;n[, if byte is greater than zero => return true, else
-     * after all, return false
-     *
-     *  both negative:
-     *     fb == b: check for each byte [1;n[, if byte is greater than zero => return false, else
-     * after all, return true fb > b: a definitely smaller than b => return false fb < b: check for
-     * each byte [1;n[, if byte greater than zero => return false, else after all, return true
-     *
-     */
-
-    // compare first byte
-    uint8_t first_byte = get_byte_value_of_big_integer(a, 0);
-
-    // pos 1.
-    if (!a_negative && first_byte == b) {
-        // positive and first byte equal => a >= b
-        return true;
-    }
-    // pos 2.
-    if (!a_negative && first_byte > b) {
-        // both positive: a is definitely greater than b
-        return true;
-    }
-
-    // neg 2.
-    if (a_negative && first_byte > b) {
-        // negative: a must be smaller than b, a cannot be any bigger now, can only be smaller on
-        // higher bytes
-        return false;
-    }
-
-    // a is not zero
-    // signs are the same
-    for (size_t i = 1; i < len; i++) {
-        uint8_t byte = get_byte_value_of_big_integer(a, i);
-
-        // neg 1., 3.
-        if (a_negative && byte > 0) {
-            // cannot be bigger anymore/equal than b
-            return false;
-        }
+    (void) simd;
+    size_t used = big_integer_used_bytes(a);
 
-        // pos 3.
-        if (!a_negative && byte > 0) {
-            // positive and byte > 0
-            return true;
-        }
-    }
+    // |a| >= 2^16 > |b|, so the sign of a decides
+    if (used > 2) return !a->sign;
 
-    // pos 3.
-    if (!a_negative) return false;
-    // neg 1., 3.
-    return true;
+    int32_t value = used == 0 ? 0 : a->mem[0] | (used == 2 ? a->mem[1] << 8 : 0);
+    return (a->sign ? -value : value) >= b;
 }
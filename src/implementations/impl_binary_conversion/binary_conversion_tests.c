@@ -1,12 +1,16 @@
 #include "binary_conversion_tests.h"
 
 #include <stdlib.h>
+#include <string.h>
 
 #include "../../test.h"
 #include "../../util.h"
+#include "../thread_pool.h"
 #include "big_integer.h"
 #include "big_integer_arithmetic.h"
 #include "impl_binary_conversion.h"
+#include "instrumentation.h"
+#include "wide_simd.h"
 
 /**
  * All functions run a couple of tests that test a single component function of the
@@ -27,7 +31,8 @@ typedef struct Testcase_conversion {
 
 bool test_big_integer_conversion_to_any_base_executor(Testcase_conversion *t) {
     big_integer *value = create_big_integer_of_bytes(t->bytes_length, *t->bytes, t->sign);
-    convert_big_integer_to_any_base(value, t->base, t->alph, t->buffer, t->buffer_length, t->simd);
+    convert_big_integer_to_any_base(value, get_number_system(t->base, t->alph), t->buffer,
+                                    t->buffer_length, NULL, t->simd);
 
     bool success = true;
     for (size_t j = 0; j < t->buffer_length; j++) {
@@ -69,6 +74,9 @@ void test_big_integer_conversion_to_any_base(bool simd, Implementation impl) {
             {simd, 1, &(uint8_t[]) {3},                true,  -2, alph, malloc(5),  5, "1101"},
             // base (-3)
             {simd, 1, &(uint8_t[]) {12},               false, -3, alph, malloc(4),  4, "220"},
+            // base (-10): the digits of the magnitude get a carry of 1 or -1
+            {simd, 1, &(uint8_t[]) {10},               false, -10, alph, malloc(4), 4, "190"},
+            {simd, 1, &(uint8_t[]) {95},               true,  -10, alph, malloc(5), 5, "1905"},
             // base 75 (62.942 => lowest to heighest: 17, 14, 11 => H, E, B => right oder: BEH
             {simd, 2, &(uint8_t[]) {0xDE, 0xF5},       false, 75, alph, malloc(4),  4, "BEH"},
     };
@@ -376,6 +384,461 @@ void test_binary_arithmetic(bool simd, Implementation impl) {
     test_finalize(tr);
 }
 
+#define SIGNED_ARITHMETIC_LENGTH 20
+
+typedef struct Testcase_signed_arithmetic {
+    bool simd;
+
+    uint8_t a[SIGNED_ARITHMETIC_LENGTH];
+    bool sign_a;
+
+    uint8_t b[SIGNED_ARITHMETIC_LENGTH];
+    bool sign_b;
+
+    char op;
+
+    uint8_t exp[SIGNED_ARITHMETIC_LENGTH];
+    bool sign_exp;
+} Testcase_signed_arithmetic;
+
+bool test_binary_signed_arithmetic_executor(Testcase_signed_arithmetic *t) {
+    big_integer *a = create_big_integer_of_bytes(SIGNED_ARITHMETIC_LENGTH, t->a, t->sign_a);
+    big_integer *b = create_big_integer_of_bytes(SIGNED_ARITHMETIC_LENGTH, t->b, t->sign_b);
+    big_integer *expected =
+            create_big_integer_of_bytes(SIGNED_ARITHMETIC_LENGTH, t->exp, t->sign_exp);
+
+    if (t->op == '+') {
+        big_integer_addition(a, b, t->simd);
+    } else {
+        big_integer_subtraction(a, b, t->simd);
+    }
+
+    // the result has to match including its sign and the second operand must stay untouched
+    bool success = big_integer_is_equal(a, expected) && b->sign == t->sign_b &&
+                   memcmp(b->mem, t->b, SIGNED_ARITHMETIC_LENGTH) == 0;
+
+    delete_big_integer(a);
+    delete_big_integer(b);
+    delete_big_integer(expected);
+
+    return success;
+}
+
+/**
+ * Tests the sign handling of addition/subtraction (including |b| > |a| and zero results) with
+ * operands that are long enough for the SIMD loops. The second operand must not be modified.
+ */
+void test_binary_signed_arithmetic(bool simd, Implementation impl) {
+    TestResult tr = test_init_impl(impl, "signed arithmetic on big_integers");
+
+    // x = 7 * 2^128 + 5; y = 10 * 2^128 + 9
+#define X {[0] = 5, [16] = 7}
+#define Y {[0] = 9, [16] = 10}
+#define Y_MINUS_X {[0] = 4, [16] = 3}
+#define X_PLUS_Y {[0] = 14, [16] = 17}
+#define ZERO {0}
+    Testcase_signed_arithmetic test_cases[] = {
+            // x - y = -(y - x)
+            {simd, X, false, Y, false, '-', Y_MINUS_X, true},
+            // -x - (-y) = y - x
+            {simd, X, true, Y, true, '-', Y_MINUS_X, false},
+            // -y - (-x) = -(y - x)
+            {simd, Y, true, X, true, '-', Y_MINUS_X, true},
+            // x - (-y) = x + y
+            {simd, X, false, Y, true, '-', X_PLUS_Y, false},
+            // -x - y = -(x + y)
+            {simd, X, true, Y, false, '-', X_PLUS_Y, true},
+            // x + (-y) = -(y - x)
+            {simd, X, false, Y, true, '+', Y_MINUS_X, true},
+            // -x + y = y - x
+            {simd, X, true, Y, false, '+', Y_MINUS_X, false},
+            // y + (-x) = y - x
+            {simd, Y, false, X, true, '+', Y_MINUS_X, false},
+            // -y + x = -(y - x)
+            {simd, Y, true, X, false, '+', Y_MINUS_X, true},
+            // equal magnitudes result in a positive zero
+            {simd, X, false, X, false, '-', ZERO, false},
+            {simd, X, true, X, true, '-', ZERO, false},
+            {simd, X, true, X, false, '+', ZERO, false},
+            // 3 * 2^128 + 1 - 10 * 2^128 = -(6 * 2^128 + 2^128 - 1) (borrow through all SIMD bytes)
+            {simd, {[0] = 1, [16] = 3}, false, {[16] = 10}, false, '-',
+             {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+              0xFF, 0xFF, 6},
+             true},
+    };
+#undef X
+#undef Y
+#undef Y_MINUS_X
+#undef X_PLUS_Y
+#undef ZERO
+
+    int count = sizeof(test_cases) / sizeof(test_cases[0]);
+
+    for (int i = 0; i < count; i++) {
+        test_run(&test_cases[i], (bool (*)(void *)) test_binary_signed_arithmetic_executor, &tr,
+                 "signed testcase %i (%c)", "wrong result", i, test_cases[i].op);
+    }
+
+    test_finalize(tr);
+}
+
+#define USED_BYTES_LENGTH 40
+
+typedef struct Testcase_used_bytes {
+    bool simd;
+
+    uint8_t a[USED_BYTES_LENGTH];
+    uint8_t b[USED_BYTES_LENGTH];
+
+    // '+', '-', '*', '/' (by k), '<' (byte-wise shift by k) or 's' (bit-wise shift by k)
+    char op;
+    int16_t k;
+
+    size_t exp_used;
+} Testcase_used_bytes;
+
+/**
+ * Returns true if all bytes above the used bytes of the big_integer are zero.
+ */
+static bool used_bytes_are_valid(big_integer *value) {
+    if (value->used > value->length) return false;
+    for (size_t i = value->used; i < value->length; i++) {
+        if (value->mem[i] != 0) return false;
+    }
+    return true;
+}
+
+bool test_big_integer_used_bytes_executor(Testcase_used_bytes *t) {
+    big_integer *a = create_big_integer_of_bytes(USED_BYTES_LENGTH, t->a, false);
+    big_integer *b = create_big_integer_of_bytes(USED_BYTES_LENGTH, t->b, false);
+    big_integer *res = create_big_integer(USED_BYTES_LENGTH, false);
+
+    big_integer *value = a;
+    switch (t->op) {
+        case '+':
+            big_integer_addition(a, b, t->simd);
+            break;
+        case '-':
+            big_integer_subtraction(a, b, t->simd);
+            break;
+        case '*':
+            big_integer_multiplication(a, b, res, t->simd);
+            value = res;
+            break;
+        case '/':
+            big_integer_division_int9_t(a, t->k, t->simd);
+            break;
+        case '<':
+            big_integer_shl_byte_wise(a, t->k);
+            break;
+        case 's':
+            big_integer_shl_bitwise_0_to_7(a, t->k, t->simd);
+            break;
+        default:
+            abort_err("No valid operation specified.\n");
+    }
+
+    bool success = used_bytes_are_valid(value) && used_bytes_are_valid(b) &&
+                   big_integer_used_bytes(value) == t->exp_used;
+
+    delete_big_integer(a);
+    delete_big_integer(b);
+    delete_big_integer(res);
+
+    return success;
+}
+
+/**
+ * Tests that the arithmetic functions keep track of the used bytes of small values in big
+ * big_integers: all bytes above the used ones have to be zero.
+ */
+void test_big_integer_used_bytes(bool simd, Implementation impl) {
+    TestResult tr = test_init_impl(impl, "big_integer used bytes tracking");
+
+    Testcase_used_bytes test_cases[] = {
+            // 0xFFFF + 1 = 0x10000
+            {simd, {0xFF, 0xFF}, {1}, '+', 0, 3},
+            // 1 + 1 = 2 (no carry byte)
+            {simd, {1}, {1}, '+', 0, 1},
+            // 0x10000 - 1 = 0xFFFF
+            {simd, {0, 0, 1}, {1}, '-', 0, 2},
+            // 1 - 0x10000 = -0xFFFF
+            {simd, {1}, {0, 0, 1}, '-', 0, 2},
+            // x - x = 0
+            {simd, {5, 7}, {5, 7}, '-', 0, 0},
+            // 0xFFFF * 0xFFFF = 0xFFFE0001
+            {simd, {0xFF, 0xFF}, {0xFF, 0xFF}, '*', 0, 4},
+            // 0x100 / 3 = 0x55
+            {simd, {0, 1}, {0}, '/', 3, 1},
+            // 0x201 shl 20 bytes
+            {simd, {1, 2}, {0}, '<', 20, 22},
+            // 0x80 shl 7 bits = 0x4000
+            {simd, {0x80}, {0}, 's', 7, 2},
+            // long values that use the SIMD loops: 2^256 - 1 + 1 = 2^256
+            {simd, {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+                    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+                    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF},
+             {1}, '+', 0, 33},
+            // 2^256 - 1 = 0xFF...FF (32 bytes)
+            {simd, {[32] = 1}, {1}, '-', 0, 32},
+    };
+
+    int count = sizeof(test_cases) / sizeof(test_cases[0]);
+
+    for (int i = 0; i < count; i++) {
+        test_run(&test_cases[i], (bool (*)(void *)) test_big_integer_used_bytes_executor, &tr,
+                 "used bytes testcase %i (%c)", "wrong used bytes", i, test_cases[i].op);
+    }
+
+    test_finalize(tr);
+}
+
+typedef struct Testcase_wide_simd {
+    simd_width width;
+
+    // '+', '-', 'z' (zero check), 's' (bit-wise shift by k), 'a' (addition of a value with half of
+    // the bytes shifted by k bits) or 'c' (conversion to base k)
+    char op;
+    int16_t k;
+
+    size_t length;
+    uint64_t seed;
+} Testcase_wide_simd;
+
+/**
+ * Returns the next pseudo random byte (splitmix64).
+ */
+static uint8_t next_random_byte(uint64_t *state) {
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return (uint8_t) ((z ^ (z >> 31)) >> 56);
+}
+
+/**
+ * Creates a positive big_integer with random bytes. The used bytes are random as well (the bytes
+ * above them are zero), every 4th byte is 0x00 or 0xFF to produce long carry chains.
+ */
+static big_integer *create_random_big_integer(size_t length, uint64_t *state) {
+    big_integer *value = create_big_integer(length, false);
+    size_t used = length == 0 ? 0 : next_random_byte(state) % length + 1;
+    for (size_t i = 0; i < used; i++) {
+        uint8_t byte = next_random_byte(state);
+        if (i % 4 == 0) byte = byte & 0x1 ? 0xFF : 0x00;
+        set_byte_value_of_big_integer(value, i, byte);
+    }
+    return value;
+}
+
+/**
+ * Executes the operation with the SIMD implementation (with the kernels of the given vector width)
+ * and the SISD implementation and checks that both give the same result.
+ */
+bool test_wide_simd_executor(Testcase_wide_simd *t) {
+    const char *alph =
+            "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz!#$&'()*+,-./";
+    simd_width previous_width = get_simd_width();
+    set_simd_width(t->width);
+
+    uint64_t state = t->seed;
+    big_integer *a = create_random_big_integer(t->length, &state);
+    big_integer *b = create_random_big_integer(t->length, &state);
+    big_integer *a_sisd = clone_big_integer(a);
+
+    bool success = true;
+    switch (t->op) {
+        case '+':
+            big_integer_addition(a, b, true);
+            big_integer_addition(a_sisd, b, false);
+            break;
+        case '-':
+            big_integer_subtraction(a, b, true);
+            big_integer_subtraction(a_sisd, b, false);
+            break;
+        case 'z':
+            // a single non-zero byte at a random position (in a zero big_integer for k = 0)
+            set_zero(a);
+            if (t->k != 0) a->mem[next_random_byte(&state) % t->length] = 1;
+            a->used = a->length;
+            success = big_integer_is_zero_simd(a) == (t->k == 0);
+            copy_big_integer_value_into_another(a, a_sisd);
+            break;
+        case 's':
+            big_integer_shl_bitwise_0_to_7(a, t->k, true);
+            big_integer_shl_bitwise_0_to_7__sisd(a_sisd, t->k);
+            break;
+        case 'a': {
+            // all bytes of the half are used, so that it fills whole vectors
+            big_integer *half = create_random_big_integer(t->length / 2, &state);
+            if (t->length > 1) set_byte_value_of_big_integer(half, t->length / 2 - 1, 0x5A);
+            big_integer_add_shifted(a, half, t->k, true);
+            big_integer_add_shifted(a_sisd, half, t->k, false);
+            delete_big_integer(half);
+            break;
+        }
+        case 'c': {
+            size_t buffer_length = t->length * 8 + 3;
+            char *buffer = malloc(buffer_length);
+            char *buffer_sisd = malloc(buffer_length);
+            check_alloc(buffer, buffer_length, "buffer");
+            check_alloc(buffer_sisd, buffer_length, "buffer_sisd");
+            const number_system *system = get_number_system(t->k, alph);
+            convert_big_integer_to_any_base(a, system, buffer, buffer_length, NULL, true);
+            convert_big_integer_to_any_base(a_sisd, system, buffer_sisd, buffer_length, NULL,
+                                            false);
+            success = strcmp(buffer, buffer_sisd) == 0;
+            free(buffer);
+            free(buffer_sisd);
+            break;
+        }
+        default:
+            abort_err("No valid operation specified.\n");
+    }
+
+    success = success && used_bytes_are_valid(a) && big_integer_is_equal(a, a_sisd);
+
+    delete_big_integer(a);
+    delete_big_integer(b);
+    delete_big_integer(a_sisd);
+
+    set_simd_width(previous_width);
+    return success;
+}
+
+/**
+ * Tests the AVX2 and AVX-512 kernels against the SISD implementation with random values (only the
+ * vector widths that are supported by this CPU).
+ */
+void test_wide_simd(Implementation impl) {
+    TestResult tr = test_init_impl(impl, "AVX2/AVX-512 kernels");
+
+    char ops[] = {'+', '+', '-', '-', 'z', 'z', 's', 's', 'a', 'a', 'a', 'c', 'c', 'c'};
+    int16_t ks[] = {0, 0, 0, 0, 0, 1, 1, 7, 0, 13, 69, 10, 7, 75};
+    size_t lengths[] = {1, 31, 32, 63, 64, 65, 100, 257};
+
+    simd_width supported = get_supported_simd_width();
+    for (simd_width width = SIMD_WIDTH_128; width <= supported; width++) {
+        uint64_t seed = 1;
+        for (size_t o = 0; o < sizeof(ops); o++) {
+            for (size_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++, seed++) {
+                // the conversion is only tested with the short values
+                if (ops[o] == 'c' && lengths[l] > 100) continue;
+
+                Testcase_wide_simd test_case = {width, ops[o], ks[o], lengths[l], seed};
+                test_run(&test_case, (bool (*)(void *)) test_wide_simd_executor, &tr,
+                         "%s %c (k = %i) with %zu bytes", "different result than SISD",
+                         simd_width_name(width), ops[o], ks[o], lengths[l]);
+            }
+        }
+    }
+
+    test_finalize(tr);
+}
+
+typedef struct Testcase_compare {
+    bool simd;
+    simd_width width;
+    size_t length;
+    size_t position;  // the byte in which b differs from a (none if position == length)
+    bool sign_a;
+    bool sign_b;
+    uint64_t seed;
+} Testcase_compare;
+
+/**
+ * Compares a random value a with a value b that differs from a in a single byte (or not at all)
+ * and checks the result against the byte by byte comparison.
+ */
+bool test_big_integer_compare_executor(Testcase_compare *t) {
+    simd_width previous_width = get_simd_width();
+    set_simd_width(t->width);
+
+    uint64_t state = t->seed;
+    big_integer *a = create_big_integer(t->length, t->sign_a);
+    for (size_t i = 0; i < t->length; i++) {
+        set_byte_value_of_big_integer(a, i, next_random_byte(&state) | (i == t->length - 1));
+    }
+    big_integer *b = clone_big_integer(a);
+    b->sign = t->sign_b;
+    if (t->position < t->length) b->mem[t->position] ^= 1 << (next_random_byte(&state) % 8);
+
+    int expected_magnitude = 0;
+    for (size_t i = t->length; i > 0 && expected_magnitude == 0; i--) {
+        if (a->mem[i - 1] != b->mem[i - 1]) {
+            expected_magnitude = a->mem[i - 1] > b->mem[i - 1] ? 1 : -1;
+        }
+    }
+    int expected = t->sign_a != t->sign_b ? (t->sign_a ? -1 : 1)
+                                          : (t->sign_a ? -expected_magnitude : expected_magnitude);
+
+    bool success = big_integer_compare_magnitude(a, b, t->simd) == expected_magnitude &&
+                   big_integer_compare_magnitude(b, a, t->simd) == -expected_magnitude &&
+                   big_integer_compare(a, b, t->simd) == expected &&
+                   big_integer_compare(b, a, t->simd) == -expected &&
+                   big_integer_compare(a, a, t->simd) == 0;
+
+    delete_big_integer(a);
+    delete_big_integer(b);
+
+    set_simd_width(previous_width);
+    return success;
+}
+
+/**
+ * Checks that +0 and -0 are equal and smaller than 1 (also for the comparison with integers).
+ */
+bool test_big_integer_compare_zero_executor(bool *simd) {
+    big_integer *zero = create_big_integer(4, false);
+    big_integer *negative_zero = create_big_integer(8, true);
+    big_integer *one = create_big_integer(1, false);
+    set_byte_value_of_big_integer(one, 0, 1);
+
+    bool success = big_integer_compare(zero, negative_zero, *simd) == 0 &&
+                   big_integer_compare(negative_zero, one, *simd) == -1 &&
+                   big_integer_greater_equal_int16(negative_zero, 0, *simd) &&
+                   !big_integer_greater_equal_int16(negative_zero, 1, *simd) &&
+                   big_integer_greater_equal_int16(one, -256, *simd) &&
+                   !big_integer_greater_equal_int16(one, 256, *simd);
+
+    delete_big_integer(zero);
+    delete_big_integer(negative_zero);
+    delete_big_integer(one);
+    return success;
+}
+
+/**
+ * Tests the comparison of big_integers (with every supported vector width for SIMD) and that +0 and
+ * -0 are equal.
+ */
+void test_big_integer_compare(bool simd, Implementation impl) {
+    TestResult tr = test_init_impl(impl, "big_integer comparison");
+
+    const size_t lengths[] = {1, 7, 8, 9, 16, 17, 31, 33, 64, 65, 130, 257};
+    simd_width supported = simd ? get_supported_simd_width() : SIMD_WIDTH_128;
+    uint64_t seed = 1;
+
+    for (simd_width width = SIMD_WIDTH_128; width <= supported; width++) {
+        for (size_t l = 0; l < sizeof(lengths) / sizeof(size_t); l++) {
+            size_t length = lengths[l];
+            for (size_t position = 0; position <= length; position++) {
+                for (int signs = 0; signs < 4; signs++) {
+                    Testcase_compare test_case = {simd,         width, length, position,
+                                                  signs & 0x1, signs & 0x2, seed++};
+                    test_run(&test_case, (bool (*)(void *)) test_big_integer_compare_executor, &tr,
+                             "%s: %zu bytes, difference at byte %zu (signs %d)", "wrong result",
+                             simd_width_name(width), length, position, signs);
+                }
+            }
+        }
+    }
+
+    bool zero_simd = simd;
+    test_run(&zero_simd, (bool (*)(void *)) test_big_integer_compare_zero_executor, &tr,
+             "comparison of +0, -0 and 1", "wrong result");
+
+    test_finalize(tr);
+}
+
 typedef struct Testcase_division {
     bool simd;
 
@@ -397,10 +860,7 @@ bool test_big_integer_division_int9_executor(Testcase_division *t) {
     big_integer *a = create_big_integer_of_bytes(t->len_a, *t->a, t->sign_a);
     big_integer *expected = create_big_integer_of_bytes(t->len_exp, *t->exp, t->sign_exp);
 
-    big_integer *temp1 = create_big_integer(t->len_a, false);
-    big_integer *temp2 = create_big_integer(t->len_a, false);
-
-    int16_t remainder = big_integer_division_int9_t(a, t->div, temp1, temp2, t->simd);
+    int16_t remainder = big_integer_division_int9_t(a, t->div, t->simd);
 
     bool success = remainder == t->remainder_exp;
     for (size_t j = 0; j < t->len_exp; j++) {
@@ -413,8 +873,6 @@ bool test_big_integer_division_int9_executor(Testcase_division *t) {
 
     delete_big_integer(a);
     delete_big_integer(expected);
-    delete_big_integer(temp1);
-    delete_big_integer(temp2);
 
     return success;
 }
@@ -441,6 +899,27 @@ void test_big_integer_division_int9(bool simd, Implementation impl) {
             {simd, 1, &(uint8_t[]) {17},  true,  -8, 1, &(uint8_t[]) {2},  false, -1},
             //-200 / -20 = 10
             {simd, 1, &(uint8_t[]) {200}, true,  20, 1, &(uint8_t[]) {10}, true,  0},
+            // multi-byte values (7 byte chunks and remaining bytes)
+            // 0x123456789ABCDEFFEDCBA9876543210 / 10 = 0x1D208A5A912E31997C790F3F086B68 R0
+            {simd, 16, &(uint8_t[]) {0x10, 0x32, 0x54, 0x76, 0x98, 0xBA, 0xDC, 0xFE, 0xEF, 0xCD, 0xAB, 0x89, 0x67, 0x45, 0x23, 0x01},
+             false, 10, 16, &(uint8_t[]) {0x68, 0x6B, 0x08, 0x3F, 0x0F, 0x79, 0x7C, 0x99, 0x31, 0x2E, 0x91, 0x5A, 0x8A, 0x20, 0x1D, 0x00},
+             false, 0},
+            // -0x123456789ABCDEFFEDCBA9876543210 / -7 = 0x299C335CCF668FFFD663CCA3309970 R0
+            {simd, 16, &(uint8_t[]) {0x10, 0x32, 0x54, 0x76, 0x98, 0xBA, 0xDC, 0xFE, 0xEF, 0xCD, 0xAB, 0x89, 0x67, 0x45, 0x23, 0x01},
+             true, -7, 16, &(uint8_t[]) {0x70, 0x99, 0x30, 0xA3, 0xCC, 0x63, 0xD6, 0xFF, 0x8F, 0x66, 0xCF, 0x5C, 0x33, 0x9C, 0x29, 0x00},
+             false, 0},
+            // 0x123456789ABCDEFFEDCBA9876543210 / 128 = 0x2468ACF13579BDFFDB97530ECA864 R16
+            {simd, 16, &(uint8_t[]) {0x10, 0x32, 0x54, 0x76, 0x98, 0xBA, 0xDC, 0xFE, 0xEF, 0xCD, 0xAB, 0x89, 0x67, 0x45, 0x23, 0x01},
+             false, 128, 16, &(uint8_t[]) {0x64, 0xA8, 0xEC, 0x30, 0x75, 0xB9, 0xFD, 0xDF, 0x9B, 0x57, 0x13, 0xCF, 0x8A, 0x46, 0x02, 0x00},
+             false, 16},
+            // -0xFFFFFFFFFFFFFFFF / 3 = -0x5555555555555555 R0
+            {simd, 8, &(uint8_t[]) {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF},
+             true, 3, 8, &(uint8_t[]) {0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55},
+             true, 0},
+            // 0x123456789ABCDEFFEDCBA9876543210 / -125 = -0x25485F2C3EF372AFFB7C3C79A4608 R40
+            {simd, 16, &(uint8_t[]) {0x10, 0x32, 0x54, 0x76, 0x98, 0xBA, 0xDC, 0xFE, 0xEF, 0xCD, 0xAB, 0x89, 0x67, 0x45, 0x23, 0x01},
+             false, -125, 16, &(uint8_t[]) {0x08, 0x46, 0x9A, 0xC7, 0xC3, 0xB7, 0xFF, 0x2A, 0x37, 0xEF, 0xC3, 0xF2, 0x85, 0x54, 0x02, 0x00},
+             true, 40},
 
     };
 
@@ -526,16 +1005,483 @@ void test_big_integer_shl(bool simd, Implementation impl) {
     test_finalize(tr);
 }
 
+typedef struct Testcase_shifted {
+    bool simd;
+    char op;  // '<': shift, '+': add shifted
+    size_t length;
+    size_t bit_count;
+    uint64_t seed;
+} Testcase_shifted;
+
+/**
+ * Returns |value| << bit_count in a new big_integer of the given length (bit by bit, higher bits
+ * are cut).
+ */
+static big_integer *reference_shl(big_integer *value, size_t bit_count, size_t length) {
+    big_integer *shifted = create_big_integer(length, false);
+    for (size_t i = 0; i < value->used * 8; i++) {
+        bool bit = (value->mem[i / 8] >> (i % 8)) & 0x1;
+        if (bit && i + bit_count < length * 8) {
+            set_bit_value_of_big_integer(shifted, i + bit_count, true);
+        }
+    }
+    return shifted;
+}
+
+/**
+ * Shifts a random value (or adds it shifted to another random value) and compares the result to
+ * the bit by bit reference.
+ */
+bool test_big_integer_shifted_executor(Testcase_shifted *t) {
+    uint64_t state = t->seed;
+    bool success;
+
+    if (t->op == '<') {
+        // the shifted bits may be cut
+        big_integer *a = create_random_big_integer(t->length, &state);
+        big_integer *expected = reference_shl(a, t->bit_count, t->length);
+        big_integer_shl(a, t->bit_count);
+        success = used_bytes_are_valid(a) && big_integer_is_equal(a, expected);
+
+        delete_big_integer(a);
+        delete_big_integer(expected);
+    } else {
+        // b << bit_count has less than length - 1 bytes and the top byte of a is zero, so the sum
+        // fits into length bytes
+        big_integer *a = create_random_big_integer(t->length, &state);
+        big_integer *b = create_random_big_integer(t->length / 2, &state);
+        a->mem[t->length - 1] = 0;
+        big_integer_used_bytes(a);
+
+        big_integer *expected = reference_shl(b, t->bit_count, t->length);
+        big_integer_addition(expected, a, false);
+        big_integer_add_shifted(a, b, t->bit_count, t->simd);
+        success = used_bytes_are_valid(a) && big_integer_is_equal(a, expected);
+
+        delete_big_integer(a);
+        delete_big_integer(b);
+        delete_big_integer(expected);
+    }
+
+    return success;
+}
+
+/**
+ * Tests the shifts by any number of bits and the addition of shifted values with random values.
+ */
+void test_big_integer_shifted(bool simd, Implementation impl) {
+    TestResult tr = test_init_impl(impl, "big_integer shifts by any number of bits");
+
+    const size_t lengths[] = {1, 2, 7, 8, 9, 16, 17, 33, 100, 300};
+    uint64_t seed = 1;
+
+    for (size_t l = 0; l < sizeof(lengths) / sizeof(size_t); l++) {
+        size_t length = lengths[l];
+        for (size_t bit_count = 0; bit_count <= 8 * length + 9; bit_count++) {
+            Testcase_shifted shift = {simd, '<', length, bit_count, seed++};
+            test_run(&shift, (bool (*)(void *)) test_big_integer_shifted_executor, &tr,
+                     "shl by %zu bits (%zu bytes)", "wrong result", bit_count, length);
+
+            // b has length / 2 bytes
+            if (length >= 4 && bit_count + 8 * (length / 2) < 8 * (length - 1)) {
+                Testcase_shifted add = {simd, '+', length, bit_count, seed++};
+                test_run(&add, (bool (*)(void *)) test_big_integer_shifted_executor, &tr,
+                         "add shifted by %zu bits (%zu bytes)", "wrong result", bit_count, length);
+            }
+        }
+    }
+
+    test_finalize(tr);
+}
+
+typedef struct Testcase_square {
+    bool simd;
+    size_t length;
+    size_t threads;
+    uint64_t seed;
+} Testcase_square;
+
+/**
+ * Squares a random value a (with length bytes) and compares the square to the product
+ * a * (a - 1) + a of two different factors.
+ */
+bool test_big_integer_square_executor(Testcase_square *t) {
+    uint64_t state = t->seed;
+    thread_pool_set_threads(t->threads);
+
+    // all bytes are used and a - 1 is not negative
+    big_integer *a = create_random_big_integer(t->length, &state);
+    set_byte_value_of_big_integer(a, 0, get_byte_value_of_big_integer(a, 0) | 0x1);
+    set_byte_value_of_big_integer(a, t->length - 1, 0x5A);
+    big_integer *one = create_big_integer(1, false);
+    set_byte_value_of_big_integer(one, 0, 1);
+    big_integer *predecessor = clone_big_integer(a);
+    big_integer_subtraction(predecessor, one, t->simd);
+
+    big_integer *square = create_big_integer(2 * t->length, false);
+    big_integer *expected = create_big_integer(2 * t->length, false);
+    big_integer_square(a, square, t->simd);
+    big_integer_multiplication(a, predecessor, expected, t->simd);
+    big_integer_addition(expected, a, t->simd);
+
+    bool success = used_bytes_are_valid(square) && big_integer_is_equal(square, expected);
+
+    // negative factors with the same magnitude are squared, too
+    big_integer *negative = clone_big_integer(a);
+    negative->sign = true;
+    big_integer *product = create_big_integer(2 * t->length, false);
+    big_integer_multiplication(a, negative, product, t->simd);
+    product->sign = false;
+    success = success && big_integer_is_equal(product, expected);
+
+    thread_pool_set_threads(1);
+    delete_big_integer(a);
+    delete_big_integer(one);
+    delete_big_integer(predecessor);
+    delete_big_integer(square);
+    delete_big_integer(expected);
+    delete_big_integer(negative);
+    delete_big_integer(product);
+
+    return success;
+}
+
+/**
+ * Tests the squaring of random values (the long ones are split across several threads).
+ */
+void test_big_integer_square(bool simd, Implementation impl) {
+    TestResult tr = test_init_impl(impl, "big_integer squaring");
+
+    const size_t lengths[] = {1, 2, 7, 8, 9, 16, 17, 33, 100, 300, 1000, 2000};
+    uint64_t seed = 1;
+
+    for (size_t l = 0; l < sizeof(lengths) / sizeof(size_t); l++) {
+        for (size_t threads = 1; threads <= 4; threads += 3) {
+            for (int i = 0; i < 5; i++) {
+                Testcase_square t = {simd, lengths[l], threads, seed++};
+                test_run(&t, (bool (*)(void *)) test_big_integer_square_executor, &tr,
+                         "square of %zu bytes (%zu threads)", "wrong result", lengths[l], threads);
+            }
+        }
+    }
+
+    test_finalize(tr);
+}
+
+typedef struct Testcase_power_of_two {
+    bool simd;
+    int base;
+    size_t length;
+    uint64_t seed;
+} Testcase_power_of_two;
+
+/**
+ * Converts a random number of the base +-2^k into binary and back (every number has exactly one
+ * representation without leading zeros, so z + 0 gives back z).
+ */
+bool test_power_of_two_base_executor(Testcase_power_of_two *t) {
+    uint64_t state = t->seed;
+    unsigned int base_abs = abs(t->base);
+
+    // the ASCII alphabets use the SIMD digit tables, base 128 gets the chars from 128 on
+    const char *ascii = "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ+/";
+    char alph[129];
+    for (unsigned int i = 0; i < base_abs; i++) {
+        alph[i] = base_abs <= 64 ? ascii[i] : (char) (128 + i);
+    }
+    alph[base_abs] = '\0';
+    const char zero[2] = {alph[0], '\0'};
+
+    char *z = malloc(t->length + 2);
+    char *result = malloc(t->length + 4);
+    check_alloc(z, t->length + 2, "number");
+    check_alloc(result, t->length + 4, "result");
+
+    size_t start = t->base > 0 && next_random_byte(&state) % 2 == 0 ? 1 : 0;
+    z[0] = '-';
+    for (size_t i = start; i < start + t->length; i++) {
+        unsigned int value = next_random_byte(&state) % base_abs;
+        z[i] = alph[i == start && value == 0 ? 1 : value];
+    }
+    z[start + t->length] = '\0';
+
+    arith_op_any_base__binary_conversion(t->base, alph, z, zero, '+', result, t->simd);
+    bool success = strcmp(z, result) == 0;
+
+    free(z);
+    free(result);
+
+    return success;
+}
+
+/**
+ * Tests the conversions of the bases +-2^k that copy the digits bit field by bit field.
+ */
+void test_power_of_two_bases(bool simd, Implementation impl) {
+    TestResult tr = test_init_impl(impl, "conversions of power of two bases");
+
+    const size_t lengths[] = {1, 2, 3, 7, 8, 9, 31, 100, 1000};
+    uint64_t seed = 1;
+
+    for (int k = 1; k <= 7; k++) {
+        for (int sign = -1; sign <= 1; sign += 2) {
+            int base = sign * (1 << k);
+            for (size_t l = 0; l < sizeof(lengths) / sizeof(size_t); l++) {
+                for (int i = 0; i < 4; i++) {
+                    Testcase_power_of_two t = {simd, base, lengths[l], seed++};
+                    test_run(&t, (bool (*)(void *)) test_power_of_two_base_executor, &tr,
+                             "%zu digits in base %i", "wrong result", lengths[l], base);
+                }
+            }
+        }
+    }
+
+    test_finalize(tr);
+}
+
+typedef struct Testcase_sizes {
+    bool simd;
+    int base;
+    size_t length;
+    uint8_t leading;
+} Testcase_sizes;
+
+/**
+ * Converts the greatest number with the given length and leading digit ((leading + 1) *
+ * base^(length - 1) - 1) into binary and back: its binary value must fit into the calculated size,
+ * which may only be one byte bigger than the value, and it must be written into a buffer of exactly
+ * its length (plus NULL-byte).
+ */
+bool test_big_integer_sizes_executor(Testcase_sizes *t) {
+    unsigned int base_abs = abs(t->base);
+    char alph[129];
+    for (unsigned int i = 0; i < base_abs; i++) {
+        alph[i] = (char) (128 + i);
+    }
+    alph[base_abs] = '\0';
+
+    // in negative bases the digits base_abs - 1 and 0 alternate for the greatest magnitude
+    char *z = malloc(t->length + 1);
+    check_alloc(z, t->length + 1, "number");
+    z[0] = alph[t->leading];
+    for (size_t i = 1; i < t->length; i++) {
+        z[i] = alph[t->base > 0 || i % 2 == 0 ? base_abs - 1 : 0];
+    }
+    z[t->length] = '\0';
+
+    const number_system *system = get_number_system(t->base, alph);
+    size_t size = get_big_integer_min_size_of_power((int16_t) t->base, t->length, t->leading, 1);
+    big_integer *value = create_big_integer(size + 8, false);
+    convert_number_from_any_base_into_binary(system, z, t->length, value, NULL, t->simd);
+    size_t used = big_integer_used_bytes(value);
+    bool success = used <= size && size <= used + 1;
+
+    char *result = malloc(t->length + 1);
+    check_alloc(result, t->length + 1, "result");
+    convert_big_integer_to_any_base(value, system, result, t->length + 1, NULL, t->simd);
+    success &= strcmp(z, result) == 0;
+
+    delete_big_integer(value);
+    free(result);
+    free(z);
+
+    return success;
+}
+
+/**
+ * Tests the size calculations from the number of digits and the leading digit and the conversion
+ * into buffers of exactly the length of the result (all digits of the base base^k are packed into
+ * the bytes of the double dabble).
+ */
+void test_big_integer_sizes(bool simd, Implementation impl) {
+    TestResult tr = test_init_impl(impl, "big_integer size calculations");
+
+    const int bases[] = {3, 5, 7, 10, 11, 12, 100, 127, -3, -10, -100};
+    const size_t lengths[] = {1, 2, 3, 10, 33, 100, 1000};
+
+    for (size_t b = 0; b < sizeof(bases) / sizeof(int); b++) {
+        unsigned int base_abs = abs(bases[b]);
+        for (size_t l = 0; l < sizeof(lengths) / sizeof(size_t); l++) {
+            // leading digits of 1, half the base and the greatest digit
+            const uint8_t leadings[] = {1, base_abs / 2, base_abs - 1};
+            for (size_t d = 0; d < sizeof(leadings); d++) {
+                Testcase_sizes t = {simd, bases[b], lengths[l], leadings[d]};
+                test_run(&t, (bool (*)(void *)) test_big_integer_sizes_executor, &tr,
+                         "%zu digits with leading digit %u in base %i", "wrong size or result",
+                         lengths[l], leadings[d], bases[b]);
+            }
+        }
+    }
+
+    test_finalize(tr);
+}
+
+#define MAX_ARENA_ALLOCATIONS 8
+
+typedef struct Testcase_arena {
+    size_t capacity;
+
+    size_t count;
+    size_t sizes[MAX_ARENA_ALLOCATIONS];
+
+} Testcase_arena;
+
+/**
+ * Allocates all big_integers of the testcase in the arena (two times, with a reset in between) and
+ * checks that they are zero-initialized and do not overlap.
+ */
+bool test_big_integer_arena_executor(Testcase_arena *t) {
+    big_integer_arena *arena = create_big_integer_arena(t->capacity);
+    big_integer *values[MAX_ARENA_ALLOCATIONS];
+    bool success = true;
+
+    for (int round = 0; round < 2; round++) {
+        for (size_t i = 0; i < t->count; i++) {
+            values[i] = create_big_integer_in_arena(arena, t->sizes[i], false);
+            success = success && values[i]->length == t->sizes[i] &&
+                      big_integer_is_zero(values[i], false);
+            memset(values[i]->mem, (int) i + 1, t->sizes[i]);
+            values[i]->used = t->sizes[i];
+        }
+
+        // every big_integer still holds its own bytes
+        for (size_t i = 0; i < t->count; i++) {
+            for (size_t j = 0; j < t->sizes[i]; j++) {
+                success = success && get_byte_value_of_big_integer(values[i], j) == i + 1;
+            }
+        }
+
+        big_integer_arena_reset(arena);
+
+        // after a reset, the arena consists of a single block that is big enough for all rounds
+        success = success && arena->blocks->next == NULL && arena->blocks->used == 0 &&
+                  arena->blocks->capacity == arena->total_capacity;
+    }
+
+    delete_big_integer_arena(arena);
+
+    return success;
+}
+
+/**
+ * Tests the allocation of big_integers in an arena.
+ */
+void test_big_integer_arena(Implementation impl) {
+    TestResult tr = test_init_impl(impl, "big_integer arena allocation");
+
+    Testcase_arena test_cases[] = {
+            // everything fits into the first block
+            {4096, 3, {1, 15, 100}},
+            // the first block is too small, blocks have to be chained
+            {16, 4, {1, 2, 3, 4}},
+            {64, 5, {100, 7, 1000, 16, 17}},
+            // single allocation that is bigger than twice the current block
+            {32, 2, {10000, 5}},
+            // empty big_integers
+            {16, 2, {0, 0}},
+    };
+
+    int count = sizeof(test_cases) / sizeof(test_cases[0]);
+
+    for (int i = 0; i < count; i++) {
+        test_run(&test_cases[i], (bool (*)(void *)) test_big_integer_arena_executor, &tr,
+                 "arena testcase %i (capacity %zu)", "wrong allocation", i,
+                 test_cases[i].capacity);
+    }
+
+    test_finalize(tr);
+}
+
+typedef struct Testcase_instrumentation {
+    bool simd;
+    int base;
+    const char *alph;
+    const char *z1;
+    const char *z2;
+    char op;
+    const char *expected;
+} Testcase_instrumentation;
+
+/**
+ * Calculates the testcase with enabled instrumentation and checks the counters, then calculates it
+ * again with disabled instrumentation, which must not change them.
+ */
+bool test_instrumentation_executor(Testcase_instrumentation *t) {
+    char result[64];
+    set_instrumentation_enabled(true);
+    arith_op_any_base__binary_conversion(t->base, t->alph, t->z1, t->z2, t->op, result, t->simd);
+    binary_conversion_stats stats = get_binary_conversion_stats();
+    bool success = strcmp(result, t->expected) == 0;
+
+    success = success && stats.operations == 1 && stats.big_integers > 0 &&
+              stats.bytes_allocated > 0 && stats.additions > 0 &&
+              stats.uint8_multiplications > 0 && stats.to_binary_seconds >= 0 &&
+              stats.operation_seconds >= 0 && stats.to_base_seconds >= 0;
+    success = success && (t->op != '-' || stats.subtractions > 0);
+    // double dabble shifts in all bases, the odd digits of negative bases are subtracted
+    success = success && stats.shifts > 0 && (t->base > 0 || stats.subtractions > 0);
+
+    set_instrumentation_enabled(false);
+    arith_op_any_base__binary_conversion(t->base, t->alph, t->z1, t->z2, t->op, result, t->simd);
+    binary_conversion_stats unchanged = get_binary_conversion_stats();
+    success = success && memcmp(&stats, &unchanged, sizeof(binary_conversion_stats)) == 0;
+
+    return success;
+}
+
+/**
+ * Tests the instrumentation counters of the binary conversion.
+ */
+void test_instrumentation(bool simd, Implementation impl) {
+    TestResult tr = test_init_impl(impl, "instrumentation counters");
+
+    Testcase_instrumentation test_cases[] = {
+            {simd, 10, "0123456789", "123", "456", '+', "579"},
+            {simd, 10, "0123456789", "123", "456", '-', "-333"},
+            {simd, 10, "0123456789", "123", "456", '*', "56088"},
+            {simd, -10, "0123456789", "123", "456", '*', "31668"},
+    };
+
+    int count = sizeof(test_cases) / sizeof(test_cases[0]);
+
+    for (int i = 0; i < count; i++) {
+        test_run(&test_cases[i], (bool (*)(void *)) test_instrumentation_executor, &tr,
+                 "%s %c %s (base %d)", "wrong counters", test_cases[i].z1, test_cases[i].op,
+                 test_cases[i].z2, test_cases[i].base);
+    }
+
+    test_finalize(tr);
+}
+
 void binary_conversion_tests_sisd(Implementation impl) {
     test_big_integer_conversion_to_any_base(false, impl);
+    test_power_of_two_bases(false, impl);
+    test_big_integer_sizes(false, impl);
     test_binary_arithmetic(false, impl);
+    test_binary_signed_arithmetic(false, impl);
     test_big_integer_division_int9(false, impl);
     test_big_integer_shl(false, impl);
+    test_big_integer_shifted(false, impl);
+    test_big_integer_square(false, impl);
+    test_big_integer_used_bytes(false, impl);
+    test_big_integer_compare(false, impl);
+    test_big_integer_arena(impl);
+    test_instrumentation(false, impl);
 }
 
 void binary_conversion_tests_simd(Implementation impl) {
     test_big_integer_conversion_to_any_base(true, impl);
+    test_power_of_two_bases(true, impl);
+    test_big_integer_sizes(true, impl);
     test_binary_arithmetic(true, impl);
+    test_binary_signed_arithmetic(true, impl);
     test_big_integer_division_int9(true, impl);
     test_big_integer_shl(true, impl);
+    test_big_integer_shifted(true, impl);
+    test_big_integer_square(true, impl);
+    test_big_integer_used_bytes(true, impl);
+    test_big_integer_compare(true, impl);
+    test_wide_simd(impl);
+    test_big_integer_arena(impl);
+    test_instrumentation(true, impl);
 }
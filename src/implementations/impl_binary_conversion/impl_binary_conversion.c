@@ -7,8 +7,20 @@
 #include "arithmetic_helper.h"
 #include "big_integer.h"
 #include "big_integer_arithmetic.h"
+#include "instrumentation.h"
 #include "logger.h"
+#include "wide_simd.h"
 #include "../common.h"
+#include "../number_system.h"
+
+/**
+ * The arena that holds all big_integers of one operation. It is reset (but kept) at the start of
+ * every operation, so that repeated operations reuse its memory (one arena per thread).
+ */
+static _Thread_local big_integer_arena *operation_arena = NULL;
+
+// initial size of the operation arena in bytes (it grows if needed)
+#define OPERATION_ARENA_CAPACITY 4096
 
 void arith_op_any_base__binary_conversion__sisd(int base, const char *alph, const char *z1,
                                                 const char *z2, char op, char *result) {
@@ -20,9 +32,16 @@ void arith_op_any_base__binary_conversion__simd(int base, const char *alph, cons
     arith_op_any_base__binary_conversion(base, alph, z1, z2, op, result, true);
 }
 
+void release_operation_arena(void) {
+    if (operation_arena != NULL) {
+        delete_big_integer_arena(operation_arena);
+        operation_arena = NULL;
+    }
+}
+
 /**
  * This function first converts both operands (that are encoded in the given base) to binary. Then,
- * it executes the corresponding operation (either +,- or *) and converts the result back to the
+ * it executes the corresponding operation (+, -, * or ^) and converts the result back to the
  * desired base format and writes in into the given result string. The result string is terminated
  * with a NULL-byte when the number is finished, no matter how long the original number strings
  * were. The caller of this function needs to make sure that the given result string is big enough
@@ -33,8 +52,8 @@ void arith_op_any_base__binary_conversion__simd(int base, const char *alph, cons
  * @param alph The alphabet that maps each numeric value to a ascii-representable character (digit)
  * @param z1 The operand 1 string encoded in the desired base format.
  * @param z2 The operand 2 string encoded in the desired base format.
- * @param op The operation, either '+', '-' or '*' (respective addition, subtraction or
- * multiplication).
+ * @param op The operation, either '+', '-', '*' or '^' (respective addition, subtraction,
+ * multiplication or exponentiation, the exponent z2 must not be negative).
  * @param result The string buffer where the result in encoded format is written to.
  */
 void arith_op_any_base__binary_conversion(int base, const char *alph, const char *z1,
@@ -47,6 +66,15 @@ void arith_op_any_base__binary_conversion(int base, const char *alph, const char
     //      in negative bases, there is no need for a '-' char because negative values are encoded
     //      already.
 
+    if (operation_arena == NULL) {
+        operation_arena = create_big_integer_arena(OPERATION_ARENA_CAPACITY);
+    } else {
+        big_integer_arena_reset(operation_arena);
+    }
+    big_integer_arena *arena = operation_arena;
+
+    const number_system *system = get_number_system(base, alph);
+
     // Step 1: Conversion of operands to binary
     // This bool indicates of the result of the conversion must be later negated (because the
     // "string" number is neg.).
@@ -57,57 +85,85 @@ void arith_op_any_base__binary_conversion(int base, const char *alph, const char
     size_t z2_length = strlen(z2);
     size_t result_length;
 
-    // Create big_integer elements that later hold the converted values of z1 and z2
-    size_t z1_binary_minsize = get_big_integer_min_size((int16_t) base, z1_length);
-    size_t z2_binary_minsize = get_big_integer_min_size((int16_t) base, z2_length);
+    // Create big_integer elements that later hold the converted values of z1 and z2 (as big as the
+    // number of digits and the value of the leading digit of the operands require)
+    uint8_t z1_leading = system->tables.lut[(unsigned char) z1[z1_negative]];
+    uint8_t z2_leading = system->tables.lut[(unsigned char) z2[z2_negative]];
+    size_t z1_binary_minsize = get_big_integer_min_size_of_power(
+            (int16_t) base, z1_length - z1_negative, z1_leading, 1);
+    size_t z2_binary_minsize = get_big_integer_min_size_of_power(
+            (int16_t) base, z2_length - z2_negative, z2_leading, 1);
 
-    big_integer *z1_binary, *z2_binary = create_big_integer(z2_binary_minsize, false);
+    big_integer *z1_binary;
+    big_integer *z2_binary = create_big_integer_in_arena(arena, z2_binary_minsize, false);
 
     // if addition or subtraction, z1 will hold the result and must therefore have the minimum
     // desired size
     size_t addition_subtraction_min_result_size = max(z1_binary_minsize, z2_binary_minsize) + 1;
     if (op == '+' || op == '-') {
-        z1_binary = create_big_integer(addition_subtraction_min_result_size, false);
+        z1_binary = create_big_integer_in_arena(arena, addition_subtraction_min_result_size, false);
     } else {
         // multiplication
-        z1_binary = create_big_integer(z1_binary_minsize, false);
+        z1_binary = create_big_integer_in_arena(arena, z1_binary_minsize, false);
     }
 
+    // A product of equal operands is a square: the operand only has to be converted once. The
+    // exponent of a power is not converted at all.
+    bool square = op == '*' && (z1 == z2 || strcmp(z1, z2) == 0);
+    uint64_t exponent = 0;
+    exponent_status status = op == '^' ? parse_exponent(system, z2, UINT64_MAX, &exponent)
+                                       : EXPONENT_VALID;
+    if (status == EXPONENT_NEGATIVE) abort_err("The exponent %s is negative!", z2);
+    if (status == EXPONENT_TOO_BIG) abort_err("The exponent %s is too big!", z2);
+
     // Convert string numbers into binary
-    convert_numbers_from_any_base_into_binary(base, alph, z1, z2, z1_length, z2_length, z1_binary,
-                                              z2_binary, simd);
+    if (square || op == '^') {
+        convert_number_from_any_base_into_binary(system, z1, z1_length, z1_binary, arena, simd);
+    } else {
+        convert_numbers_from_any_base_into_binary(system, z1, z2, z1_length, z2_length, z1_binary,
+                                                  z2_binary, arena, simd);
+    }
 
     // add sign if base is positive and first char of number is a '-'
     if (z1_negative) z1_binary->sign = true;
     if (z2_negative) z2_binary->sign = true;
 
     // Step 2: Perform the actual arithmetic operation on the converted binary values.
+    count_event(COUNTER_OPERATIONS, 1);
+    uint64_t operation_start = phase_start();
     big_integer *res;
     switch (op) {
         case '+':
-            result_length = max(z1_length, z2_length) + 2;
-            if (base < 0) {
-                result_length += 1;
-            }
             big_integer_addition(z1_binary, z2_binary, simd);
             res = z1_binary;
-            // Addition/Subtraction: Result length just digits is max(a,b) + 1, then add 2 because
-            // of sign and NULL-byte
             break;
         case '-':
             big_integer_subtraction(z1_binary, z2_binary, simd);
             res = z1_binary;
-            result_length = max(z1_length, z2_length) + 3;
             break;
         case '*':
-            res = create_big_integer(z1_binary->length + z2_binary->length, false);
+            res = create_big_integer_in_arena(arena, z1_binary->length + z2_binary->length, false);
 
-            big_integer_multiplication(z1_binary, z2_binary, res, simd);
-            result_length = max(z1_length, z2_length) * 2 + 1;
+            if (square) {
+                big_integer_square(z1_binary, res, simd);
+            } else {
+                big_integer_multiplication(z1_binary, z2_binary, res, simd);
+            }
             // Clear z1 separately (because in addition/subtraction, res refers to z1 and will be
             // deleted after conversion)
-            delete_big_integer(z1_binary);
+            delete_big_integer_in_arena(arena, z1_binary);
             break;
+        case '^': {
+            size_t power_size = get_big_integer_min_size_of_power(
+                    (int16_t) base, z1_length - z1_negative, z1_leading, exponent);
+            res = create_big_integer_in_arena(arena, power_size, false);
+            big_integer *temp = create_big_integer_in_arena(arena, power_size, false);
+
+            big_integer_power(z1_binary, exponent, res, temp, simd);
+            delete_big_integer_in_arena(arena, temp);
+            delete_big_integer_in_arena(arena, z1_binary);
+            break;
+        }
         default:
             abort_err("The provided operation %c is not valid!", op);
     }
@@ -116,13 +172,22 @@ void arith_op_any_base__binary_conversion(int base, const char *alph, const char
     if (big_integer_is_zero(res, simd)) {
         res->sign = false;
     }
+    phase_end(COUNTER_OPERATION_NS, operation_start);
 
-    // Step 3: Convert the result back to the original base and write it to the given buffer.
-    convert_big_integer_to_any_base(res, base, alph, result, result_length, simd);
+    // Step 3: Convert the result back to the original base and write it to the given buffer (as
+    // big as the caller has to make it, inclusive NULL-byte)
+    if (op == '+' || op == '-') {
+        result_length = max_needed_chars_add_sub(z1, z2) + 1;
+    } else if (op == '*') {
+        result_length = max_needed_chars_mul(z1, z2) + 1;
+    } else {
+        result_length = max_needed_chars_pow(z1, exponent) + 1;
+    }
+    convert_big_integer_to_any_base(res, system, result, result_length, arena, simd);
 
-    // Clear memory
-    delete_big_integer(res);
-    delete_big_integer(z2_binary);
+    // Clear memory (the arena itself is reset by the next operation)
+    delete_big_integer_in_arena(arena, res);
+    delete_big_integer_in_arena(arena, z2_binary);
 }
 
 /**
@@ -134,62 +199,191 @@ void arith_op_any_base__binary_conversion(int base, const char *alph, const char
  */
 uint8_t get_char_value(char c, uint8_t (*lookup)[]) { return (*lookup)[(uint8_t) c]; }
 
+/**
+ * Returns k if the absolute value of the base is 2^k, otherwise 0. The digits in such a base are
+ * bit fields of k bits of the binary value.
+ */
+static unsigned int power_of_two_digit_bits(unsigned int base_abs) {
+    return (base_abs & (base_abs - 1)) == 0 ? (unsigned int) __builtin_ctz(base_abs) : 0;
+}
+
+/**
+ * Packs the digit values (most significant first) into the bytes of binary: the digit at position
+ * i (counted from the least significant digit) is the bit field [i * k, (i + 1) * k). With parity
+ * 0/1 only the digits at even/odd positions are packed (all others count as zero), with -1 all.
+ * binary has to be zero and big enough for the packed value, the (zero) bytes of leading zero digits
+ * above its length are not written.
+ */
+static void pack_digit_values(const uint8_t *values, size_t length, unsigned int k, int parity,
+                              big_integer *binary) {
+    uint8_t *mem = binary->mem;
+    size_t byte_index = 0;
+    uint64_t bits = 0;
+    unsigned int bit_count = 0;
+
+    for (size_t i = 0; i < length; i++) {
+        uint64_t value = values[length - 1 - i];
+        if (parity >= 0 && (int) (i % 2) != parity) value = 0;
+
+        bits |= value << bit_count;
+        bit_count += k;
+        // flush whole bytes (at most 7 bits of the next digits stay)
+        while (bit_count >= 8) {
+            if (byte_index < binary->length) mem[byte_index] = (uint8_t) bits;
+            byte_index++;
+            bits >>= 8;
+            bit_count -= 8;
+        }
+    }
+    if (bit_count > 0 && byte_index < binary->length) mem[byte_index++] = (uint8_t) bits;
+
+    binary->used = min(byte_index, binary->length);
+    big_integer_used_bytes(binary);
+}
+
+/**
+ * Converts the digit values of a number in the base +-2^k into binary in linear time: In positive
+ * bases the digits are packed bit field by bit field. In negative bases the digits at even
+ * positions have positive weights and the digits at odd positions negative weights, so the value is
+ * the difference of both packed halves.
+ */
+static void convert_power_of_two_base_into_binary(const number_system *system, unsigned int k,
+                                                  const uint8_t *values, size_t length,
+                                                  big_integer *binary, big_integer_arena *arena,
+                                                  bool simd) {
+    if (system->base > 0) {
+        pack_digit_values(values, length, k, -1, binary);
+        return;
+    }
+
+    // both halves may be bigger than the value itself
+    size_t half_size = length * k / 8 + 1;
+    big_integer *even = create_big_integer_in_arena(arena, half_size, false);
+    big_integer *odd = create_big_integer_in_arena(arena, half_size, false);
+    pack_digit_values(values, length, k, 0, even);
+    pack_digit_values(values, length, k, 1, odd);
+    big_integer_subtraction(even, odd, simd);
+    copy_big_integer_value_into_another(even, binary);
+    delete_big_integer_in_arena(arena, odd);
+    delete_big_integer_in_arena(arena, even);
+}
+
+/**
+ * Returns the value of the digits at the positions [position, position + count) (counted from the
+ * least significant digit, the positions above length count as zero) in the (signed) base.
+ */
+static int chunk_value(int base, const uint8_t *values, size_t length, size_t position,
+                       unsigned int count) {
+    size_t end = min(position + count, length);
+    int value = 0;
+    for (size_t p = end; p > position; p--) {
+        value = value * base + values[length - p];
+    }
+    return value;
+}
+
 /**
  * Converts the given strings z1, z2 to their binary representation and stores them in the given
- * big_integers by adding each char value with the corresponding weight to one big_integer.
+ * big_integers by adding each char value with the corresponding weight to one big_integer (as
+ * many digits at a time as fit into one byte). The digits of the bases +-2^k are packed as bit
+ * fields instead.
  */
-void convert_numbers_from_any_base_into_binary(int base, const char *alph, const char *z1,
+void convert_numbers_from_any_base_into_binary(const number_system *system, const char *z1,
                                                const char *z2, size_t z1_length, size_t z2_length,
                                                big_integer *z1_binary, big_integer *z2_binary,
-                                               bool simd) {
-    // Create a lookup-table to get the values of the characters of the alphabet quickly in
-    // calculation.
-    uint8_t lookup[UCHAR_MAX + 1] = {};
-    generate_lut(lookup, strlen(alph), alph);
+                                               big_integer_arena *arena, bool simd) {
+    uint64_t start = phase_start();
+    int base = system->base;
+
+    // Translate all digits to their values up front (16 digits at a time). The '-' sign of a
+    // negative number is not in the alphabet and gets the value 0.
+    big_integer *z1_values = create_big_integer_in_arena(arena, z1_length, false);
+    big_integer *z2_values = create_big_integer_in_arena(arena, z2_length, false);
+    digits_to_values(&system->tables, z1, z1_length, z1_values->mem);
+    digits_to_values(&system->tables, z2, z2_length, z2_values->mem);
+
+    // the digits of power of two bases are just copied bit field by bit field
+    unsigned int k = power_of_two_digit_bits(system->base_abs);
+    if (k != 0) {
+        convert_power_of_two_base_into_binary(system, k, z1_values->mem, z1_length, z1_binary,
+                                              arena, simd);
+        convert_power_of_two_base_into_binary(system, k, z2_values->mem, z2_length, z2_binary,
+                                              arena, simd);
+        delete_big_integer_in_arena(arena, z1_values);
+        delete_big_integer_in_arena(arena, z2_values);
+        phase_end(COUNTER_TO_BINARY_NS, start);
+        return;
+    }
+
+    // In negative bases the digits at even positions have positive weights and the digits at odd
+    // positions negative weights: both are summed up separately with the weights abs(base)^i and
+    // subtracted once at the end, so that all additions have the same signs. The sums may be bigger
+    // than the value itself.
+    big_integer *z1_sum = z1_binary;
+    big_integer *z2_sum = z2_binary;
+    big_integer *z1_odd = NULL;
+    big_integer *z2_odd = NULL;
+    if (base < 0) {
+        size_t z1_sum_size = get_big_integer_min_size_exponentiation((int16_t) base, z1_length);
+        size_t z2_sum_size = get_big_integer_min_size_exponentiation((int16_t) base, z2_length);
+        z1_sum = create_big_integer_in_arena(arena, z1_sum_size, false);
+        z2_sum = create_big_integer_in_arena(arena, z2_sum_size, false);
+        z1_odd = create_big_integer_in_arena(arena, z1_sum_size, false);
+        z2_odd = create_big_integer_in_arena(arena, z2_sum_size, false);
+    }
 
     // Big_integer used for calculation that is big enough to hold the final value of z1, z2
-    big_integer *z1_temp = create_big_integer(z1_binary->length, false);
-    big_integer *z2_temp = create_big_integer(z2_binary->length, false);
+    big_integer *z1_temp = create_big_integer_in_arena(arena, z1_sum->length, false);
+    big_integer *z2_temp = create_big_integer_in_arena(arena, z2_sum->length, false);
+
+    // The digits are added in chunks of chunk_digits digits whose value fits into one byte, the
+    // weight is multiplied by chunk_base = abs(base)^chunk_digits once per chunk.
+    unsigned int chunk_digits = 1;
+    unsigned int chunk_base = system->base_abs;
+    while (chunk_base * system->base_abs <= UINT8_MAX) {
+        chunk_base *= system->base_abs;
+        chunk_digits++;
+    }
 
     // Create a big_integer than can hold up to the value of base^(max_length - 1), which is the
-    // weight the last most significant char in the longest of the input strings. Init that value to
-    // 1, which is base^0
+    // weight of the last chunk of the longest of the input strings. Init that value to 1, which is
+    // base^0
     size_t max_length = max(z1_length, z2_length);
 
-    big_integer *current_weight = create_big_integer(
-            get_big_integer_min_size_exponentiation((int16_t) base, (int) max_length), false);
-    big_integer *temp = create_big_integer(current_weight->length, false);
-    big_integer *temp2 = create_big_integer(current_weight->length, false);
+    size_t weight_size = get_big_integer_min_size_exponentiation((int16_t) base, max_length);
+    big_integer *current_weight = create_big_integer_in_arena(arena, weight_size, false);
+    big_integer *temp = create_big_integer_in_arena(arena, current_weight->length, false);
 
     set_byte_value_of_big_integer(current_weight, 0, 1);
 
-    // i: String iterating char-index (Starting at the front of the string)
-    for (size_t i = 0; i < max_length; i++) {
-        // The index of the digit (starting with n-1 at z1[0] or z2[0]) (Starting at the back of the
-        // string)
-        if (i < z1_length) {
-            size_t char_index = z1_length - 1 - i;
-            // digit_value is in between [0; base) but max in [0; 128) because max base is 128
-            uint8_t digit_value = get_char_value(z1[char_index], &lookup);
-
-            // The total value of the digit is its digit value multiplied by the weight of the
-            // position. Because the current weight is only multiplied by a one-byte value, the
-            // total_digit value fits into length of current_weight + 1 bytes.
-            big_integer_multiply_uint8(current_weight, digit_value, z1_temp, temp2, simd);
+    // i: the position of the least significant digit of the chunk (counted from the back of the
+    // strings)
+    for (size_t i = 0; i < max_length; i += chunk_digits) {
+        // In negative bases the weight base^i of the chunk is negative for odd i
+        bool negative_weight = base < 0 && i % 2 == 1;
 
-            // Add the total value of the character to the value of the number (z1, z2).
-            big_integer_addition(z1_binary, z1_temp, simd);
+        if (i < z1_length) {
+            // The total value of the chunk is its value multiplied by the weight of the position.
+            // Because the current weight is only multiplied by a one-byte value, the value fits
+            // into length of current_weight + 1 bytes.
+            int chunk = chunk_value(base, z1_values->mem, z1_length, i, chunk_digits);
+            if (negative_weight) chunk = -chunk;
+            big_integer_multiply_uint8(current_weight, (uint8_t) abs(chunk), z1_temp, simd);
+
+            // Add the total value of the chunk to the value of the number (z1, z2).
+            big_integer_addition(chunk < 0 ? z1_odd : z1_sum, z1_temp, simd);
         }
         if (i < z2_length) {
-            size_t char_index = z2_length - 1 - i;
-            uint8_t digit_value = get_char_value(z2[char_index], &lookup);
-
-            big_integer_multiply_uint8(current_weight, digit_value, z2_temp, temp2, simd);
-            big_integer_addition(z2_binary, z2_temp, simd);
+            int chunk = chunk_value(base, z2_values->mem, z2_length, i, chunk_digits);
+            if (negative_weight) chunk = -chunk;
+            big_integer_multiply_uint8(current_weight, (uint8_t) abs(chunk), z2_temp, simd);
+            big_integer_addition(chunk < 0 ? z2_odd : z2_sum, z2_temp, simd);
         }
 
-        // Multiply the current_weight with the base to get the base of the next char (to the left).
-        big_integer_multiply_int_neg256_to_256(current_weight, (int16_t) base, temp, temp2, simd);
+        // Multiply the current_weight with the chunk base to get the weight of the next chunk (to
+        // the left), the weights of negative bases stay positive.
+        if (i + chunk_digits >= max_length) break;
+        big_integer_multiply_uint8(current_weight, chunk_base, temp, simd);
 
         // swap current_weight and temp
         big_integer *temp_temp = temp;
@@ -197,188 +391,333 @@ void convert_numbers_from_any_base_into_binary(int base, const char *alph, const
         current_weight = temp_temp;
     }
 
+    if (base < 0) {
+        big_integer_subtraction(z1_sum, z1_odd, simd);
+        big_integer_subtraction(z2_sum, z2_odd, simd);
+        copy_big_integer_value_into_another(z1_sum, z1_binary);
+        copy_big_integer_value_into_another(z2_sum, z2_binary);
+        delete_big_integer_in_arena(arena, z2_odd);
+        delete_big_integer_in_arena(arena, z1_odd);
+        delete_big_integer_in_arena(arena, z2_sum);
+        delete_big_integer_in_arena(arena, z1_sum);
+    }
+
     // Clear temp memory
-    delete_big_integer(temp);
-    delete_big_integer(temp2);
-    delete_big_integer(current_weight);
-    delete_big_integer(z1_temp);
-    delete_big_integer(z2_temp);
+    delete_big_integer_in_arena(arena, temp);
+    delete_big_integer_in_arena(arena, current_weight);
+    delete_big_integer_in_arena(arena, z1_temp);
+    delete_big_integer_in_arena(arena, z2_temp);
+    delete_big_integer_in_arena(arena, z1_values);
+    delete_big_integer_in_arena(arena, z2_values);
+    phase_end(COUNTER_TO_BINARY_NS, start);
 }
 
 /**
- * Converts the given big_integer value to a string (in buffer) that is encoded in the given base
- * with the given alphabet.
- * @param value The value that should be converted.
- * @param base The base in which the value should be converted. Note: The only valid values are
- * in range [-128; 128]!
- * @param alph The string indicating the alphabet of the numeric system of the base.
- * @param buffer The buffer where the output string should be written to.
- * @param buffer_length The size of the output buffer, inclusive NULL-byte!
+ * Converts the single string z (without sign) to its binary representation (see
+ * convert_numbers_from_any_base_into_binary).
  */
-void convert_big_integer_to_any_base(big_integer *value, int16_t base, const char *alph,
-                                     char *buffer, size_t buffer_length, bool simd) {
-    // The Double Dabble algorithm is used for positive bases (faster than division).
-
-    if (base > 0) {
-        // explanation and examples of the double-dabble algorithm:
-        // we need log_base(2^(bits of value)) digits for output
-        // rule for base 10: if (nibble >= 5), add 3 then shift (so next bitshift will result in +6,
-        // which will effectively carry (10 will become 16 which will become carried 0x1 0x0)
-        // => add 6, after shift when greater/equal than 10 (because in odd bases there is no whole
-        // number that represents the half of the odd number (256-base) double dabble using one byte
-        // for each digit (no matter the base)
-
-        // base 2 (0...1) => before shift: if >= 2: +254
-        // base 7 (0...6) => before shift: if >= 4: 4 * 2 + 1 = 9 (!!!)
-        //...
-        // base 10 (0...9) => after shift: if >= 10: +246
-        // base 11 (0...10) => after shift: if >= 11: +245 (12 => 17 => bc11: 0x1 0x1 "=" 14)
-        // base 12 (0...11) => after shift: if >= 12: +244                      6 => +2 (6+2 = 8;
-        // 8*2 = 16 => bc12: 0x1 0x0 "=" 12) base 13 (0...12) => after shift: if >= 13: +243 (14 =>
-        // 17 => bc13: 0x1 0x1 "=" 14) base 14 (0...13) => after shift: if >= 14: +242 base 15
-        // (0...14) => after shift: if >= 15: +241 base 16 (0...15) => after shift: if >= 16: +240
-        //...
-        // base 250 (0...249) => after shift: if >= 250: +6
-        // base 251 (0...250) => after shift: if >= 251: +5
-        // base 256 (0...255) => after shift: passt (+0)
-
-        uint8_t conversion_trigger = base;
-        uint8_t carry_add = 256 - base;
-
-        // the big_integer buffer used for calculation
-        big_integer *calc_buffer = create_big_integer(buffer_length, false);
-        big_integer *remaining_value = clone_big_integer(value);
-
-        int value_length = value->length;
-
-        // Perform double-dabble iteration for each bit of input value
-        for (int i = 0; i < value_length * 8; i++) {
-            // 1. double: shift left once
-            big_integer_shl_bitwise_0_to_7(calc_buffer, 1, simd);
-
-            // set the least significant bit of calc_buffer as the most significant bit of the input
-            // value
-            bool most_significant_bit = get_most_significant_bit(remaining_value);
-            set_byte_value_of_big_integer(
-                    calc_buffer, 0,
-                    get_byte_value_of_big_integer(calc_buffer, 0) | most_significant_bit);
-
-            // shift the input value left once
-            big_integer_shl_bitwise_0_to_7(remaining_value, 1, simd);
-
-            // 2. dabble: adjust bytes that are greater/equal than/as the base
-            for (size_t j = 0; j < calc_buffer->length; j++) {
-                uint8_t byte = get_byte_value_of_big_integer(calc_buffer, j);
-                if (byte >= conversion_trigger) {
-                    set_byte_value_of_big_integer(calc_buffer, j, byte + carry_add);
-
-                    // carry: +1 @ next byte
-                    set_byte_value_of_big_integer(
-                            calc_buffer, j + 1, get_byte_value_of_big_integer(calc_buffer, j + 1) + 1);
-                }
-            }
-        }
+void convert_number_from_any_base_into_binary(const number_system *system, const char *z,
+                                              size_t z_length, big_integer *binary,
+                                              big_integer_arena *arena, bool simd) {
+    // the second number of the conversion is empty
+    big_integer *empty = create_big_integer_in_arena(arena, 1, false);
+    convert_numbers_from_any_base_into_binary(system, z, "", z_length, 0, binary, empty, arena,
+                                              simd);
+    delete_big_integer_in_arena(arena, empty);
+}
 
-        // get most significant byte of calc_buffer that is not zero
-        int calc_buffer_start_nonzero = 0;
-        for (int i = calc_buffer->length - 1; i >= 0; i--) {
-            if (get_byte_value_of_big_integer(calc_buffer, i) != 0) {
-                calc_buffer_start_nonzero = i;
-                break;
+/**
+ * Returns the bit field [index, index + k) of the bytes (k <= 8, the bits above length are zero).
+ */
+static uint8_t get_bit_field(const uint8_t *mem, size_t length, size_t index, unsigned int k) {
+    size_t byte_index = index / 8;
+    uint16_t bits = mem[byte_index];
+    if (byte_index + 1 < length) bits |= (uint16_t) (mem[byte_index + 1] << 8);
+    return (uint8_t) ((bits >> (index % 8)) & ((1u << k) - 1));
+}
+
+/**
+ * Converts the value into the base +-2^k in linear time: every digit is a bit field of k bits. In
+ * negative bases the digits are the bit fields of (value + M) XOR M, where M has the digit 2^k - 1
+ * at every odd position: value + M has the digit 2^k - 1 - d at every odd position i (with the
+ * weight (-2^k)^i = -2^(ik)) and the digits d at even positions, the XOR with M gives back every d.
+ */
+static void convert_big_integer_to_power_of_two_base(big_integer *value,
+                                                     const number_system *system, unsigned int k,
+                                                     char *buffer, size_t buffer_length,
+                                                     big_integer_arena *arena, bool simd) {
+    size_t used = big_integer_used_bytes(value);
+    bool negative = system->base > 0 && value->sign && used > 0;
+    big_integer *digits = value;
+
+    if (system->base < 0) {
+        // |value| < 2^(8 * used) has at most 8 * used / k + 2 digits in the negative base
+        size_t digit_count = (8 * used + k - 1) / k + 2;
+        size_t bytes = (digit_count * k + 7) / 8 + 1;
+
+        big_integer *mask = create_big_integer_in_arena(arena, bytes, false);
+        for (size_t i = 1; i < digit_count; i += 2) {
+            for (size_t bit = i * k; bit < (i + 1) * k; bit++) {
+                mask->mem[bit / 8] |= (uint8_t) (1u << (bit % 8));
             }
         }
+        mask->used = bytes;
+        big_integer_used_bytes(mask);
+
+        digits = create_big_integer_in_arena(arena, bytes, false);
+        copy_big_integer_value_into_another(value, digits);
+        big_integer_addition(digits, mask, simd);
+        for (size_t i = 0; i < mask->used; i++) {
+            digits->mem[i] ^= mask->mem[i];
+        }
+        digits->used = max(digits->used, mask->used);
+        used = big_integer_used_bytes(digits);
+        delete_big_integer_in_arena(arena, mask);
+    }
 
-        // 3. Convert the result into the desired base digits
-        size_t output_buffer_index = value->sign ? 1 : 0;
+    // the number of significant bits decides the number of digits (zero has one digit)
+    size_t bits = used == 0 ? 0 : 8 * used - __builtin_clz(digits->mem[used - 1]) + 24;
+    size_t digit_count = bits == 0 ? 1 : (bits + k - 1) / k;
+    size_t start = negative ? 1 : 0;
+    if (start + digit_count >= buffer_length) {
+        abort_err("The %zu digits exceed the buffer length %zu!", digit_count, buffer_length);
+    }
 
-        for (int i = calc_buffer_start_nonzero; i >= 0; i--, output_buffer_index++) {
-            // 0-th byte of calc_buffer is the least significant byte (small-endian)
-            // 0-th byte of output buffer is the most significant digit (big-endian)
+    // write the values (most significant digit first) and translate them to their chars
+    uint8_t *out = (uint8_t *) buffer + start;
+    for (size_t i = 0; i < digit_count; i++) {
+        out[digit_count - 1 - i] = used == 0 ? 0 : get_bit_field(digits->mem, used, i * k, k);
+    }
+    values_to_digits(&system->tables, out, digit_count, buffer + start);
 
-            // Start at the least significant byte of the value
-            // (write it at the end of the output buffer).
+    if (negative) buffer[0] = '-';
+    buffer[start + digit_count] = 0x00;
 
-            if (output_buffer_index >= buffer_length) {
-                warn("output_buffer_index exceeds buffer length!\n");
-                break;
-            }
+    if (digits != value) delete_big_integer_in_arena(arena, digits);
+}
 
-            // write the correct digit (char) from the alphabet to the current position
-            uint8_t byte = get_byte_value_of_big_integer(calc_buffer, i);
-            char c = alph[byte];
-            buffer[output_buffer_index] = c;
-        }
+/**
+ * Writes the digit values of the magnitude of value in the positive base base_abs into digits
+ * (most significant digit first, zero has the single digit 0) with the Double Dabble algorithm
+ * (faster than division).
+ * @return The number of digits.
+ */
+static size_t convert_magnitude_to_digit_values(big_integer *value, unsigned int base_abs,
+                                                uint8_t *digits, size_t capacity,
+                                                big_integer_arena *arena, bool simd) {
+    // explanation and examples of the double-dabble algorithm:
+    // we need log_base(2^(bits of value)) digits for output
+    // rule for base 10: if (nibble >= 5), add 3 then shift (so next bitshift will result in +6,
+    // which will effectively carry (10 will become 16 which will become carried 0x1 0x0)
+    // => add 6, after shift when greater/equal than 10 (because in odd bases there is no whole
+    // number that represents the half of the odd number (256-base) double dabble using one byte
+    // for each digit (no matter the base)
+
+    // base 2 (0...1) => before shift: if >= 2: +254
+    // base 7 (0...6) => before shift: if >= 4: 4 * 2 + 1 = 9 (!!!)
+    //...
+    // base 10 (0...9) => after shift: if >= 10: +246
+    // base 11 (0...10) => after shift: if >= 11: +245 (12 => 17 => bc11: 0x1 0x1 "=" 14)
+    // base 12 (0...11) => after shift: if >= 12: +244                      6 => +2 (6+2 = 8;
+    // 8*2 = 16 => bc12: 0x1 0x0 "=" 12) base 13 (0...12) => after shift: if >= 13: +243 (14 =>
+    // 17 => bc13: 0x1 0x1 "=" 14) base 14 (0...13) => after shift: if >= 14: +242 base 15
+    // (0...14) => after shift: if >= 15: +241 base 16 (0...15) => after shift: if >= 16: +240
+    //...
+    // base 250 (0...249) => after shift: if >= 250: +6
+    // base 251 (0...250) => after shift: if >= 251: +5
+    // base 256 (0...255) => after shift: passt (+0)
+
+    // The bytes of calc_buffer are digits of the base base^k with the greatest k for which
+    // base^k <= 128 (so that a doubled byte does not overflow): every byte holds k digits of
+    // the base, so calc_buffer is k times smaller (e.g. 2 digits per byte in base 10) and every
+    // double dabble step processes k times fewer bytes.
+    unsigned int digits_per_byte = 1;
+    unsigned int packed_base = base_abs;
+    while (packed_base * base_abs <= 128) {
+        packed_base *= base_abs;
+        digits_per_byte++;
+    }
 
-        // Add (negative) sign only if negative
-        if (value->sign) {
-            buffer[0] = '-';
+    uint8_t conversion_trigger = packed_base;
+    uint8_t carry_add = 256 - packed_base;
+
+    // leading zero bytes of the input value would only shift zeros into calc_buffer
+    size_t value_bits = big_integer_used_bytes(value) * 8;
+
+    // the big_integer buffer used for calculation (one more byte for the carry of the dabble)
+    size_t calc_buffer_size = get_max_digit_count(packed_base, value_bits) + 1;
+    big_integer *calc_buffer = create_big_integer_in_arena(arena, calc_buffer_size, false);
+
+    // Perform double-dabble iteration for each bit of input value (most significant bit first)
+    for (size_t i = value_bits; i > 0; i--) {
+        // 1. double: shift left once
+        big_integer_shl_bitwise_0_to_7(calc_buffer, 1, simd);
+
+        // set the least significant bit of calc_buffer as the current bit of the input value
+        size_t bit_index = i - 1;
+        uint8_t value_byte = get_byte_value_of_big_integer(value, bit_index / 8);
+        bool bit = (value_byte >> (bit_index % 8)) & 0x1;
+        set_byte_value_of_big_integer(calc_buffer, 0,
+                                      get_byte_value_of_big_integer(calc_buffer, 0) | bit);
+
+        // 2. dabble: adjust bytes that are greater/equal than/as the base (the bytes above the
+        // used ones are zero), whole AVX2/AVX-512 vectors first (if supported)
+        size_t j = 0;
+        if (simd) {
+            bool carry = false;
+            j = wide_simd_double_dabble_correction(calc_buffer->mem, calc_buffer->used,
+                                                   conversion_trigger, &carry);
+            if (carry) {
+                set_byte_value_of_big_integer(calc_buffer, j,
+                                              get_byte_value_of_big_integer(calc_buffer, j) + 1);
+            }
         }
-
-        // Null-byte terminating
-        if (output_buffer_index >= buffer_length) {
-            warn("Writing NULL-byte exceeds buffer length! buffer_length: %d, base: %d, val: \n", buffer_length, base);
-            print_big_integer_hex(value);
-            exit(5);
+        for (; j < calc_buffer->used; j++) {
+            uint8_t byte = get_byte_value_of_big_integer(calc_buffer, j);
+            if (byte >= conversion_trigger) {
+                set_byte_value_of_big_integer(calc_buffer, j, byte + carry_add);
+
+                // carry: +1 @ next byte
+                set_byte_value_of_big_integer(calc_buffer, j + 1,
+                                              get_byte_value_of_big_integer(calc_buffer, j + 1) + 1);
+            }
         }
-        buffer[output_buffer_index] = 0x00;
+    }
 
-        // Clear memory
-        delete_big_integer(remaining_value);
-        delete_big_integer(calc_buffer);
+    // 3. Unpack the digits of the base from the bytes of calc_buffer (the most significant byte
+    // without its leading zero digits)
+    size_t calc_buffer_used = big_integer_used_bytes(calc_buffer);
+    uint8_t top = get_byte_value_of_big_integer(calc_buffer,
+                                                calc_buffer_used > 0 ? calc_buffer_used - 1 : 0);
+    size_t top_digits = 1;
+    for (unsigned int weight = base_abs; top_digits < digits_per_byte && top >= weight;
+         weight *= base_abs) {
+        top_digits++;
+    }
+    size_t digit_count =
+            (calc_buffer_used > 0 ? calc_buffer_used - 1 : 0) * digits_per_byte + top_digits;
+    if (digit_count > capacity) {
+        abort_err("The %zu digits exceed the buffer length %zu!", digit_count, capacity);
+    }
 
-    } else {
-        // Conversion to negative base:
-
-        int base_abs = base < 0 ? -base : base;
-        // Using adjusted (naive) algorithm for binary to negative base conversion from:
-        // https://www.geeksforgeeks.org/convert-number-negative-base-representation/ case that
-        // value is fully zero
-        if (big_integer_is_zero(value, simd)) {
-            buffer[0] = alph[0];
-            buffer[1] = 0x00;
-            return;
+    // 0-th byte of calc_buffer is the least significant byte (small-endian), 0-th digit is the most
+    // significant digit (big-endian): the digits are written from the end
+    uint8_t *digit = digits + digit_count;
+    for (size_t i = 0; digit > digits; i++) {
+        uint8_t byte = get_byte_value_of_big_integer(calc_buffer, i);
+        for (unsigned int j = 0; j < digits_per_byte && digit > digits; j++) {
+            *--digit = byte % base_abs;
+            byte /= base_abs;
         }
+    }
 
-        big_integer *temp = create_big_integer(value->length, false);
-        big_integer *temp2 = create_big_integer(value->length, false);
-
-        int index = -1;
-        while (!big_integer_is_zero(value, simd)) {
-            index++;
-            // get modulo by: value % base and divide value by base: value /= base
-            int remainder = (int) big_integer_division_int9_t(
-                    value, base, temp, temp2, simd);  //=> value contains the division result
-
-            if (remainder < 0) {
-                remainder += base_abs;  // now remainder is modulo (always positive)
-                big_integer_increment(value);
-            }
+    delete_big_integer_in_arena(arena, calc_buffer);
+    return digit_count;
+}
 
-            // remainder is char (starts with least significant digit) => write to reversed buffer,
-            // reverse later
-            if (remainder < 0 || remainder >= (int) strlen(alph)) {
-                abort_err("[ERROR] Invalid remainder in convert binary to negative base.");
-            }
-            buffer[index] = alph[remainder];
+/**
+ * Turns the digit values of the magnitude of a value in the base base_abs (most significant digit
+ * first) into its digit values in the base -base_abs in linear time: The digit a_i of the
+ * magnitude is worth base_abs^i = (-1)^i * (-base_abs)^i, so the value has the digits +-a_i in the
+ * base -base_abs. Digits below zero borrow base_abs from the next position (which is worth
+ * -base_abs times as much, so it gets a carry of +1) and digits above base_abs - 1 give it a carry
+ * of -1. The carry out of the most significant digit adds at most 2 digits.
+ * @param digits The digits, there has to be room for 2 more digits.
+ * @param length The number of digits.
+ * @param negative Whether the value is negative.
+ * @return The number of digits of the negative base (without leading zeros).
+ */
+static size_t magnitude_to_negative_base_digit_values(uint8_t *digits, size_t length,
+                                                      unsigned int base_abs, bool negative) {
+    int carry = 0;
+    for (size_t i = 0; i < length; i++) {
+        uint8_t *digit = &digits[length - 1 - i];
+        int t = (negative != (i % 2 == 1)) ? carry - *digit : carry + *digit;
+        carry = 0;
+        if (t < 0) {
+            t += (int) base_abs;
+            carry = 1;
+        } else if (t >= (int) base_abs) {
+            t -= (int) base_abs;
+            carry = -1;
         }
+        *digit = (uint8_t) t;
+    }
+
+    // a carry of -1 becomes the digits 1, base_abs - 1, a carry of 1 the digit 1
+    uint8_t top[2];
+    size_t top_count = 0;
+    if (carry == -1) {
+        top[top_count++] = 1;
+        top[top_count++] = base_abs - 1;
+    } else if (carry == 1) {
+        top[top_count++] = 1;
+    }
+    memmove(digits + top_count, digits, length);
+    memcpy(digits, top, top_count);
+    length += top_count;
+
+    // the most significant digits may have become zero
+    size_t zeros = 0;
+    while (zeros + 1 < length && digits[zeros] == 0) zeros++;
+    memmove(digits, digits + zeros, length - zeros);
+    return length - zeros;
+}
 
-        // reverse buffer in-place
-        int last_index = index;
+/**
+ * Converts the given big_integer value to a string (in buffer) that is encoded in the given number
+ * system. The digits of the magnitude are calculated with the Double Dabble algorithm, in negative
+ * bases they are turned into the digits of the negative base afterwards.
+ * @param value The value that should be converted.
+ * @param system The number system in which the value should be converted. Note: The only valid
+ * bases are in range [-128; 128]!
+ * @param buffer The buffer where the output string should be written to.
+ * @param buffer_length The size of the output buffer, inclusive NULL-byte!
+ * @param arena The arena for the temporary big_integers (or NULL to allocate them on the heap).
+ */
+void convert_big_integer_to_any_base(big_integer *value, const number_system *system, char *buffer,
+                                     size_t buffer_length, big_integer_arena *arena, bool simd) {
+    uint64_t start = phase_start();
+
+    // The digits of power of two bases are just copied bit field by bit field
+    unsigned int k = power_of_two_digit_bits(system->base_abs);
+    if (k != 0) {
+        convert_big_integer_to_power_of_two_base(value, system, k, buffer, buffer_length, arena,
+                                                 simd);
+        phase_end(COUNTER_TO_BASE_NS, start);
+        return;
+    }
 
-        buffer[last_index + 1] = 0x00;  // NULL-byte string termination
+    // the '-' sign of negative values in positive bases
+    size_t digits_start = system->base > 0 && value->sign ? 1 : 0;
+    uint8_t *digits = (uint8_t *) buffer + digits_start;
+    size_t capacity = buffer_length - 1 - digits_start;
 
-        int j = 0;
-        for (int i = index; i > j; i--, j++) {
-            if (i >= (int) buffer_length || j >= (int) buffer_length) {
-                abort_err("Invalid write index to output buffer (Index: %d or %d for size: %d)", i,
-                          j, buffer_length);
-            }
-            char temp_start = buffer[j];
-            buffer[j] = buffer[i];
-            buffer[i] = temp_start;
+    size_t digit_count;
+    if (system->base > 0) {
+        digit_count = convert_magnitude_to_digit_values(value, system->base_abs, digits, capacity,
+                                                        arena, simd);
+        if (value->sign) buffer[0] = '-';
+    } else {
+        // the negative base may need up to 2 more digits than the magnitude
+        size_t scratch_size =
+                get_max_digit_count(system->base_abs, big_integer_used_bytes(value) * 8) + 2;
+        big_integer *scratch = create_big_integer_in_arena(arena, scratch_size, false);
+        digit_count = convert_magnitude_to_digit_values(value, system->base_abs, scratch->mem,
+                                                        scratch_size - 2, arena, simd);
+        digit_count = magnitude_to_negative_base_digit_values(scratch->mem, digit_count,
+                                                              system->base_abs, value->sign);
+        if (digit_count > capacity) {
+            abort_err("The %zu digits exceed the buffer length %zu!", digit_count, capacity);
         }
-
-        delete_big_integer(temp);
-        delete_big_integer(temp2);
+        memcpy(digits, scratch->mem, digit_count);
+        delete_big_integer_in_arena(arena, scratch);
     }
+
+    // translate the values to the chars of the alphabet (16 at a time)
+    values_to_digits(&system->tables, digits, digit_count, (char *) digits);
+
+    // Null-byte terminating
+    digits[digit_count] = 0x00;
+    phase_end(COUNTER_TO_BASE_NS, start);
 }
@@ -0,0 +1,59 @@
+#include "instrumentation.h"
+
+#include <time.h>
+
+atomic_bool instrumentation_active = false;
+
+atomic_size_t instrumentation_counters[COUNTER_COUNT];
+
+void set_instrumentation_enabled(bool enabled) {
+    if (enabled) reset_binary_conversion_stats();
+    atomic_store(&instrumentation_active, enabled);
+}
+
+bool get_instrumentation_enabled(void) { return atomic_load(&instrumentation_active); }
+
+void reset_binary_conversion_stats(void) {
+    for (size_t i = 0; i < COUNTER_COUNT; i++) {
+        atomic_store(&instrumentation_counters[i], 0);
+    }
+}
+
+static size_t counter(instrumentation_counter c) { return atomic_load(&instrumentation_counters[c]); }
+
+binary_conversion_stats get_binary_conversion_stats(void) {
+    binary_conversion_stats stats = {
+            counter(COUNTER_OPERATIONS),
+            counter(COUNTER_TO_BINARY_NS) * 1e-9,
+            counter(COUNTER_OPERATION_NS) * 1e-9,
+            counter(COUNTER_TO_BASE_NS) * 1e-9,
+            counter(COUNTER_BIG_INTEGERS),
+            counter(COUNTER_BYTES_ALLOCATED),
+            counter(COUNTER_ADDITIONS),
+            counter(COUNTER_SUBTRACTIONS),
+            counter(COUNTER_SHIFTS),
+            counter(COUNTER_UINT8_MULTIPLICATIONS),
+            counter(COUNTER_DIVISIONS),
+    };
+    return stats;
+}
+
+void print_binary_conversion_stats(const binary_conversion_stats *stats, FILE *stream) {
+    fprintf(stream, "Binary conversion statistics (%zu operations):\n", stats->operations);
+    fprintf(stream, "  conversion into binary:  %.6f ms\n", stats->to_binary_seconds * 1000);
+    fprintf(stream, "  arithmetic operation:    %.6f ms\n", stats->operation_seconds * 1000);
+    fprintf(stream, "  conversion into base:    %.6f ms\n", stats->to_base_seconds * 1000);
+    fprintf(stream, "  big_integers created:    %zu\n", stats->big_integers);
+    fprintf(stream, "  bytes allocated:         %zu\n", stats->bytes_allocated);
+    fprintf(stream, "  additions:               %zu\n", stats->additions);
+    fprintf(stream, "  subtractions:            %zu\n", stats->subtractions);
+    fprintf(stream, "  shifts:                  %zu\n", stats->shifts);
+    fprintf(stream, "  uint8 multiplications:   %zu\n", stats->uint8_multiplications);
+    fprintf(stream, "  divisions:               %zu\n", stats->divisions);
+}
+
+uint64_t instrumentation_time_ns(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (uint64_t) t.tv_sec * 1000000000 + t.tv_nsec;
+}
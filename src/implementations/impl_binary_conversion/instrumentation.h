@@ -0,0 +1,81 @@
+#ifndef INSTRUMENTATION_H
+#define INSTRUMENTATION_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/**
+ * Optional counters of the binary conversion backend (both implementations and the library). They
+ * are disabled by default, then every instrumentation point costs one predictable branch. The
+ * counters are shared by all threads.
+ */
+typedef struct binary_conversion_stats {
+    size_t operations;         // calculations (implementation calls and number_operation)
+    double to_binary_seconds;  // phase 1: conversion of the operands into binary
+    double operation_seconds;  // phase 2: the arithmetic operation
+    double to_base_seconds;    // phase 3: conversion of the result into the base
+    size_t big_integers;       // create_big_integer (also in an arena) calls
+    size_t bytes_allocated;    // bytes of all created big_integers
+    size_t additions;          // addition kernels (also of subtractions of different signs)
+    size_t subtractions;       // subtraction kernels (also of additions of different signs)
+    size_t shifts;             // bit-wise and byte-wise shifts
+    size_t uint8_multiplications;
+    size_t divisions;  // divisions by the base (conversion into negative bases)
+} binary_conversion_stats;
+
+typedef enum instrumentation_counter {
+    COUNTER_OPERATIONS,
+    COUNTER_TO_BINARY_NS,
+    COUNTER_OPERATION_NS,
+    COUNTER_TO_BASE_NS,
+    COUNTER_BIG_INTEGERS,
+    COUNTER_BYTES_ALLOCATED,
+    COUNTER_ADDITIONS,
+    COUNTER_SUBTRACTIONS,
+    COUNTER_SHIFTS,
+    COUNTER_UINT8_MULTIPLICATIONS,
+    COUNTER_DIVISIONS,
+    COUNTER_COUNT,
+} instrumentation_counter;
+
+extern atomic_bool instrumentation_active;
+
+extern atomic_size_t instrumentation_counters[COUNTER_COUNT];
+
+/* control (the counters are reset when they get enabled) */
+void set_instrumentation_enabled(bool enabled);
+
+bool get_instrumentation_enabled(void);
+
+void reset_binary_conversion_stats(void);
+
+binary_conversion_stats get_binary_conversion_stats(void);
+
+void print_binary_conversion_stats(const binary_conversion_stats *stats, FILE *stream);
+
+/* instrumentation points */
+uint64_t instrumentation_time_ns(void);
+
+static inline void count_event(instrumentation_counter counter, size_t n) {
+    if (atomic_load_explicit(&instrumentation_active, memory_order_relaxed)) {
+        atomic_fetch_add_explicit(&instrumentation_counters[counter], n, memory_order_relaxed);
+    }
+}
+
+/* returns the start time of a phase (0 if the instrumentation is disabled) */
+static inline uint64_t phase_start(void) {
+    if (!atomic_load_explicit(&instrumentation_active, memory_order_relaxed)) return 0;
+    return instrumentation_time_ns();
+}
+
+static inline void phase_end(instrumentation_counter phase, uint64_t start) {
+    if (atomic_load_explicit(&instrumentation_active, memory_order_relaxed)) {
+        atomic_fetch_add_explicit(&instrumentation_counters[phase],
+                                  instrumentation_time_ns() - start, memory_order_relaxed);
+    }
+}
+
+#endif
@@ -0,0 +1,572 @@
+#include "wide_simd.h"
+
+#include <immintrin.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ *
+ * This file contains the AVX2 and AVX-512 kernels of the SIMD implementation. The rest of the
+ * implementation is compiled for SSE4.2 only, these kernels are compiled with target attributes and
+ * are only called if the CPU supports them (detected once at startup with cpuid), so the same
+ * binary runs on every x86-64 CPU with SSE4.2.
+ *
+ * Carries between the vector lanes are resolved with masks: every lane that overflows generates a
+ * carry, every lane that would overflow by an incoming carry (all ones for additions) propagates
+ * it. Adding the propagate mask to the shifted generate mask then yields all lanes that receive a
+ * carry, like the carry chain of an adder.
+ *
+ */
+
+// vector width used by the kernels (the widest supported one, unless limited with set_simd_width)
+static simd_width active_width = SIMD_WIDTH_128;
+
+/**
+ * Returns the widest vector width that is supported by the CPU (and the operating system).
+ */
+simd_width get_supported_simd_width(void) {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) {
+        return SIMD_WIDTH_512;
+    }
+    if (__builtin_cpu_supports("avx2")) return SIMD_WIDTH_256;
+    return SIMD_WIDTH_128;
+}
+
+/**
+ * Selects the widest supported vector width at startup.
+ */
+__attribute__((constructor)) static void detect_simd_width(void) {
+    active_width = get_supported_simd_width();
+}
+
+/**
+ * Returns the vector width that is used by the kernels.
+ */
+simd_width get_simd_width(void) { return active_width; }
+
+/**
+ * Limits the vector width used by the kernels (e.g. to test or measure the narrower kernels). The
+ * width is clamped to the supported width.
+ * @return The vector width that is used from now on.
+ */
+simd_width set_simd_width(simd_width width) {
+    simd_width supported = get_supported_simd_width();
+    active_width = width > supported ? supported : width;
+    return active_width;
+}
+
+/**
+ * Returns the name of the instruction set of the given vector width.
+ */
+const char *simd_width_name(simd_width width) {
+    switch (width) {
+        case SIMD_WIDTH_512:
+            return "AVX-512";
+        case SIMD_WIDTH_256:
+            return "AVX2";
+        default:
+            return "SSE4.2";
+    }
+}
+
+/**
+ * Returns the mask of the lanes that receive a carry, given the lanes that generate one, the lanes
+ * that propagate an incoming one and the carry into the lowest lane. For less than 64 lanes, the
+ * bit above the highest lane is the carry out.
+ */
+static inline uint64_t carry_in_mask(uint64_t generate, uint64_t propagate, uint64_t carry) {
+    return (((generate << 1) | carry) + propagate) ^ propagate;
+}
+
+/**
+ * Scalar rest of the in-place left shift: shifts the lowest length bytes from the most significant
+ * byte down (each byte only depends on itself and the unmodified byte below it).
+ */
+static void shift_left_remaining(uint8_t *mem, size_t length, uint8_t bit_count) {
+    for (size_t i = length; i > 1; i--) {
+        mem[i - 1] = (uint8_t) ((mem[i - 1] << bit_count) | (mem[i - 2] >> (8 - bit_count)));
+    }
+    if (length > 0) mem[0] = (uint8_t) (mem[0] << bit_count);
+}
+
+/*
+ * =====================================================================
+ * AVX2 (256 bit)
+ * =====================================================================
+ */
+
+/**
+ * Expands the lowest 4 bits to 64-bit lanes (all ones if the bit is set).
+ */
+__attribute__((target("avx2"))) static inline __m256i lane_mask_avx2(uint64_t bits) {
+    const __m256i select = _mm256_setr_epi64x(1, 2, 4, 8);
+    __m256i broadcast = _mm256_set1_epi64x((long long) bits);
+    return _mm256_cmpeq_epi64(_mm256_and_si256(broadcast, select), select);
+}
+
+/**
+ * Expands the 32 bits to bytes (0xFF if the bit is set).
+ */
+__attribute__((target("avx2"))) static inline __m256i byte_mask_avx2(uint32_t bits) {
+    // byte i gets the byte of the mask that contains bit i
+    const __m256i spread = _mm256_setr_epi64x(0x0000000000000000, 0x0101010101010101,
+                                              0x0202020202020202, 0x0303030303030303);
+    const __m256i select = _mm256_set1_epi64x((long long) 0x8040201008040201);
+    __m256i bytes = _mm256_shuffle_epi8(_mm256_set1_epi32((int) bits), spread);
+    return _mm256_cmpeq_epi8(_mm256_and_si256(bytes, select), select);
+}
+
+__attribute__((target("avx2"))) static size_t addition_avx2(uint8_t *a, const uint8_t *b,
+                                                           size_t length, bool *carry) {
+    const __m256i sign = _mm256_set1_epi64x(INT64_MIN);
+    const __m256i ones = _mm256_set1_epi64x(-1);
+
+    uint64_t c = *carry;
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32) {
+        __m256i x = _mm256_loadu_si256((const __m256i *) (a + i));
+        __m256i y = _mm256_loadu_si256((const __m256i *) (b + i));
+        __m256i sum = _mm256_add_epi64(x, y);
+
+        // unsigned sum < x: the lane overflowed; sum = 2^64 - 1: an incoming carry overflows it
+        __m256i generate = _mm256_cmpgt_epi64(_mm256_xor_si256(x, sign), _mm256_xor_si256(sum, sign));
+        __m256i propagate = _mm256_cmpeq_epi64(sum, ones);
+        uint64_t carries = carry_in_mask(
+                (uint64_t) _mm256_movemask_pd(_mm256_castsi256_pd(generate)),
+                (uint64_t) _mm256_movemask_pd(_mm256_castsi256_pd(propagate)), c);
+
+        // subtracting all ones adds 1
+        sum = _mm256_sub_epi64(sum, lane_mask_avx2(carries));
+        _mm256_storeu_si256((__m256i *) (a + i), sum);
+        c = (carries >> 4) & 0x1;
+    }
+    *carry = c;
+    return i;
+}
+
+__attribute__((target("avx2"))) static size_t add_shifted_avx2(uint8_t *a, const uint8_t *b,
+                                                              size_t length, uint8_t bit_count,
+                                                              bool *carry) {
+    const __m256i sign = _mm256_set1_epi64x(INT64_MIN);
+    const __m256i ones = _mm256_set1_epi64x(-1);
+    const __m128i left = _mm_cvtsi32_si128(bit_count);
+    const __m128i right = _mm_cvtsi32_si128(64 - bit_count);
+
+    uint64_t c = *carry;
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32) {
+        // see shift_left_avx2: every word of b is combined with the word below it
+        __m256i words = _mm256_loadu_si256((const __m256i *) (b + i));
+        __m256i below = _mm256_loadu_si256((const __m256i *) (b + i - 8));
+        __m256i y = _mm256_or_si256(_mm256_sll_epi64(words, left), _mm256_srl_epi64(below, right));
+
+        __m256i x = _mm256_loadu_si256((const __m256i *) (a + i));
+        __m256i sum = _mm256_add_epi64(x, y);
+
+        __m256i generate = _mm256_cmpgt_epi64(_mm256_xor_si256(x, sign), _mm256_xor_si256(sum, sign));
+        __m256i propagate = _mm256_cmpeq_epi64(sum, ones);
+        uint64_t carries = carry_in_mask(
+                (uint64_t) _mm256_movemask_pd(_mm256_castsi256_pd(generate)),
+                (uint64_t) _mm256_movemask_pd(_mm256_castsi256_pd(propagate)), c);
+
+        sum = _mm256_sub_epi64(sum, lane_mask_avx2(carries));
+        _mm256_storeu_si256((__m256i *) (a + i), sum);
+        c = (carries >> 4) & 0x1;
+    }
+    *carry = c;
+    return i;
+}
+
+__attribute__((target("avx2"))) static size_t subtraction_avx2(uint8_t *result,
+                                                              const uint8_t *minuend,
+                                                              const uint8_t *subtrahend,
+                                                              size_t length, bool *borrow) {
+    const __m256i sign = _mm256_set1_epi64x(INT64_MIN);
+    const __m256i zero = _mm256_setzero_si256();
+
+    uint64_t c = *borrow;
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32) {
+        __m256i x = _mm256_loadu_si256((const __m256i *) (minuend + i));
+        __m256i y = _mm256_loadu_si256((const __m256i *) (subtrahend + i));
+        __m256i difference = _mm256_sub_epi64(x, y);
+
+        // unsigned x < y: the lane underflowed; difference = 0: an incoming borrow underflows it
+        __m256i generate = _mm256_cmpgt_epi64(_mm256_xor_si256(y, sign), _mm256_xor_si256(x, sign));
+        __m256i propagate = _mm256_cmpeq_epi64(difference, zero);
+        uint64_t borrows = carry_in_mask(
+                (uint64_t) _mm256_movemask_pd(_mm256_castsi256_pd(generate)),
+                (uint64_t) _mm256_movemask_pd(_mm256_castsi256_pd(propagate)), c);
+
+        // adding all ones subtracts 1
+        difference = _mm256_add_epi64(difference, lane_mask_avx2(borrows));
+        _mm256_storeu_si256((__m256i *) (result + i), difference);
+        c = (borrows >> 4) & 0x1;
+    }
+    *borrow = c;
+    return i;
+}
+
+__attribute__((target("avx2"))) static bool is_zero_avx2(const uint8_t *mem, size_t length,
+                                                        size_t *checked) {
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32) {
+        __m256i vector = _mm256_loadu_si256((const __m256i *) (mem + i));
+        if (!_mm256_testz_si256(vector, vector)) {
+            *checked = i;
+            return false;
+        }
+    }
+    *checked = i;
+    return true;
+}
+
+__attribute__((target("avx2"))) static size_t skip_equal_avx2(const uint8_t *a, const uint8_t *b,
+                                                             size_t length) {
+    size_t j = length;
+    for (; j >= 32; j -= 32) {
+        __m256i x = _mm256_loadu_si256((const __m256i *) (a + j - 32));
+        __m256i y = _mm256_loadu_si256((const __m256i *) (b + j - 32));
+        if (_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y)) != -1) break;
+    }
+    return j;
+}
+
+__attribute__((target("avx2"))) static void shift_left_avx2(uint8_t *mem, size_t length,
+                                                           uint8_t bit_count) {
+    const __m128i left = _mm_cvtsi32_si128(bit_count);
+    const __m128i right = _mm_cvtsi32_si128(64 - bit_count);
+
+    // From the most significant bytes down: every 64-bit word is combined with the word below it,
+    // which is loaded (8 bytes lower) before it gets overwritten.
+    size_t j = length;
+    for (; j >= 40; j -= 32) {
+        __m256i words = _mm256_loadu_si256((const __m256i *) (mem + j - 32));
+        __m256i below = _mm256_loadu_si256((const __m256i *) (mem + j - 40));
+        __m256i shifted =
+                _mm256_or_si256(_mm256_sll_epi64(words, left), _mm256_srl_epi64(below, right));
+        _mm256_storeu_si256((__m256i *) (mem + j - 32), shifted);
+    }
+    shift_left_remaining(mem, j, bit_count);
+}
+
+__attribute__((target("avx2"))) static size_t double_dabble_correction_avx2(uint8_t *mem,
+                                                                           size_t length,
+                                                                           uint8_t base,
+                                                                           bool *carry) {
+    const __m256i trigger = _mm256_set1_epi8((char) base);
+    const __m256i highest_digit = _mm256_set1_epi8((char) (base - 1));
+    const __m256i carry_add = _mm256_set1_epi8((char) (256 - base));
+
+    uint64_t c = *carry;
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32) {
+        __m256i digits = _mm256_loadu_si256((const __m256i *) (mem + i));
+
+        // digits >= base generate a carry, the highest digit overflows by an incoming carry
+        __m256i generate = _mm256_cmpeq_epi8(_mm256_max_epu8(digits, trigger), digits);
+        __m256i propagate = _mm256_cmpeq_epi8(digits, highest_digit);
+        uint64_t carries = carry_in_mask((uint32_t) _mm256_movemask_epi8(generate),
+                                         (uint32_t) _mm256_movemask_epi8(propagate), c);
+
+        // add the incoming carries (subtracting 0xFF adds 1), then correct all digits >= base
+        digits = _mm256_sub_epi8(digits, byte_mask_avx2((uint32_t) carries));
+        __m256i overflow = _mm256_cmpeq_epi8(_mm256_max_epu8(digits, trigger), digits);
+        digits = _mm256_add_epi8(digits, _mm256_and_si256(overflow, carry_add));
+
+        _mm256_storeu_si256((__m256i *) (mem + i), digits);
+        c = (carries >> 32) & 0x1;
+    }
+    *carry = c;
+    return i;
+}
+
+/*
+ * =====================================================================
+ * AVX-512 (512 bit)
+ * =====================================================================
+ */
+
+__attribute__((target("avx512f,avx512bw"))) static size_t addition_avx512(uint8_t *a,
+                                                                         const uint8_t *b,
+                                                                         size_t length,
+                                                                         bool *carry) {
+    const __m512i ones = _mm512_set1_epi64(-1);
+    const __m512i one = _mm512_set1_epi64(1);
+
+    uint64_t c = *carry;
+    size_t i = 0;
+    for (; i + 64 <= length; i += 64) {
+        __m512i x = _mm512_loadu_si512(a + i);
+        __m512i y = _mm512_loadu_si512(b + i);
+        __m512i sum = _mm512_add_epi64(x, y);
+
+        uint64_t carries = carry_in_mask(_mm512_cmplt_epu64_mask(sum, x),
+                                         _mm512_cmpeq_epi64_mask(sum, ones), c);
+
+        sum = _mm512_mask_add_epi64(sum, (__mmask8) carries, sum, one);
+        _mm512_storeu_si512(a + i, sum);
+        c = (carries >> 8) & 0x1;
+    }
+    *carry = c;
+    return i;
+}
+
+__attribute__((target("avx512f,avx512bw"))) static size_t add_shifted_avx512(uint8_t *a,
+                                                                            const uint8_t *b,
+                                                                            size_t length,
+                                                                            uint8_t bit_count,
+                                                                            bool *carry) {
+    const __m512i ones = _mm512_set1_epi64(-1);
+    const __m512i one = _mm512_set1_epi64(1);
+    const __m128i left = _mm_cvtsi32_si128(bit_count);
+    const __m128i right = _mm_cvtsi32_si128(64 - bit_count);
+
+    uint64_t c = *carry;
+    size_t i = 0;
+    for (; i + 64 <= length; i += 64) {
+        __m512i words = _mm512_loadu_si512(b + i);
+        __m512i below = _mm512_loadu_si512(b + i - 8);
+        __m512i y = _mm512_or_si512(_mm512_sll_epi64(words, left), _mm512_srl_epi64(below, right));
+
+        __m512i x = _mm512_loadu_si512(a + i);
+        __m512i sum = _mm512_add_epi64(x, y);
+
+        uint64_t carries = carry_in_mask(_mm512_cmplt_epu64_mask(sum, x),
+                                         _mm512_cmpeq_epi64_mask(sum, ones), c);
+
+        sum = _mm512_mask_add_epi64(sum, (__mmask8) carries, sum, one);
+        _mm512_storeu_si512(a + i, sum);
+        c = (carries >> 8) & 0x1;
+    }
+    *carry = c;
+    return i;
+}
+
+__attribute__((target("avx512f,avx512bw"))) static size_t subtraction_avx512(
+        uint8_t *result, const uint8_t *minuend, const uint8_t *subtrahend, size_t length,
+        bool *borrow) {
+    const __m512i zero = _mm512_setzero_si512();
+    const __m512i one = _mm512_set1_epi64(1);
+
+    uint64_t c = *borrow;
+    size_t i = 0;
+    for (; i + 64 <= length; i += 64) {
+        __m512i x = _mm512_loadu_si512(minuend + i);
+        __m512i y = _mm512_loadu_si512(subtrahend + i);
+        __m512i difference = _mm512_sub_epi64(x, y);
+
+        uint64_t borrows = carry_in_mask(_mm512_cmplt_epu64_mask(x, y),
+                                         _mm512_cmpeq_epi64_mask(difference, zero), c);
+
+        difference = _mm512_mask_sub_epi64(difference, (__mmask8) borrows, difference, one);
+        _mm512_storeu_si512(result + i, difference);
+        c = (borrows >> 8) & 0x1;
+    }
+    *borrow = c;
+    return i;
+}
+
+__attribute__((target("avx512f,avx512bw"))) static bool is_zero_avx512(const uint8_t *mem,
+                                                                      size_t length,
+                                                                      size_t *checked) {
+    size_t i = 0;
+    for (; i + 64 <= length; i += 64) {
+        __m512i vector = _mm512_loadu_si512(mem + i);
+        if (_mm512_test_epi64_mask(vector, vector) != 0) {
+            *checked = i;
+            return false;
+        }
+    }
+    *checked = i;
+    return true;
+}
+
+__attribute__((target("avx512f,avx512bw"))) static size_t skip_equal_avx512(const uint8_t *a,
+                                                                          const uint8_t *b,
+                                                                          size_t length) {
+    size_t j = length;
+    for (; j >= 64; j -= 64) {
+        __m512i x = _mm512_loadu_si512(a + j - 64);
+        __m512i y = _mm512_loadu_si512(b + j - 64);
+        if (_mm512_cmpneq_epi8_mask(x, y) != 0) break;
+    }
+    return j;
+}
+
+__attribute__((target("avx512f,avx512bw"))) static void shift_left_avx512(uint8_t *mem,
+                                                                         size_t length,
+                                                                         uint8_t bit_count) {
+    const __m128i left = _mm_cvtsi32_si128(bit_count);
+    const __m128i right = _mm_cvtsi32_si128(64 - bit_count);
+
+    // see shift_left_avx2
+    size_t j = length;
+    for (; j >= 72; j -= 64) {
+        __m512i words = _mm512_loadu_si512(mem + j - 64);
+        __m512i below = _mm512_loadu_si512(mem + j - 72);
+        __m512i shifted =
+                _mm512_or_si512(_mm512_sll_epi64(words, left), _mm512_srl_epi64(below, right));
+        _mm512_storeu_si512(mem + j - 64, shifted);
+    }
+    shift_left_remaining(mem, j, bit_count);
+}
+
+__attribute__((target("avx512f,avx512bw"))) static size_t double_dabble_correction_avx512(
+        uint8_t *mem, size_t length, uint8_t base, bool *carry) {
+    const __m512i trigger = _mm512_set1_epi8((char) base);
+    const __m512i highest_digit = _mm512_set1_epi8((char) (base - 1));
+    const __m512i carry_add = _mm512_set1_epi8((char) (256 - base));
+    const __m512i one = _mm512_set1_epi8(1);
+
+    uint64_t c = *carry;
+    size_t i = 0;
+    for (; i + 64 <= length; i += 64) {
+        __m512i digits = _mm512_loadu_si512(mem + i);
+
+        uint64_t generate = _mm512_cmpge_epu8_mask(digits, trigger);
+        uint64_t propagate = _mm512_cmpeq_epi8_mask(digits, highest_digit);
+        uint64_t carries = carry_in_mask(generate, propagate, c);
+
+        // 64 lanes: the carry out does not fit into the mask
+        uint64_t carry_out = (generate >> 63) | ((propagate >> 63) & (carries >> 63));
+
+        digits = _mm512_mask_add_epi8(digits, carries, digits, one);
+        __mmask64 overflow = _mm512_cmpge_epu8_mask(digits, trigger);
+        digits = _mm512_mask_add_epi8(digits, overflow, digits, carry_add);
+
+        _mm512_storeu_si512(mem + i, digits);
+        c = carry_out;
+    }
+    *carry = c;
+    return i;
+}
+
+/*
+ * =====================================================================
+ * Dispatch
+ * =====================================================================
+ */
+
+/**
+ * Adds b to a (both length bytes) in whole vectors, starting at the least significant byte.
+ * @param carry The incoming carry, it is replaced by the carry out of the processed bytes.
+ * @return The number of processed bytes (0 if no wide vectors are supported).
+ */
+size_t wide_simd_addition(uint8_t *a, const uint8_t *b, size_t length, bool *carry) {
+    switch (active_width) {
+        case SIMD_WIDTH_512:
+            return addition_avx512(a, b, length, carry);
+        case SIMD_WIDTH_256:
+            return addition_avx2(a, b, length, carry);
+        default:
+            return 0;
+    }
+}
+
+/**
+ * Adds b << bit_count (bit_count in [0;7]) to a (length bytes) in whole vectors, starting at the
+ * least significant byte. The bits shifted into b are taken from the 8 bytes below b, which have to
+ * be readable (b must not point to the first word of a value).
+ * @param carry The incoming carry, it is replaced by the carry out of the processed bytes.
+ * @return The number of processed bytes (0 if no wide vectors are supported).
+ */
+size_t wide_simd_add_shifted(uint8_t *a, const uint8_t *b, size_t length, uint8_t bit_count,
+                             bool *carry) {
+    switch (active_width) {
+        case SIMD_WIDTH_512:
+            return add_shifted_avx512(a, b, length, bit_count, carry);
+        case SIMD_WIDTH_256:
+            return add_shifted_avx2(a, b, length, bit_count, carry);
+        default:
+            return 0;
+    }
+}
+
+/**
+ * Computes result = minuend - subtrahend (all length bytes) in whole vectors, starting at the least
+ * significant byte. result may be the same memory as one of the operands.
+ * @param borrow The incoming borrow, it is replaced by the borrow out of the processed bytes.
+ * @return The number of processed bytes (0 if no wide vectors are supported).
+ */
+size_t wide_simd_subtraction(uint8_t *result, const uint8_t *minuend, const uint8_t *subtrahend,
+                             size_t length, bool *borrow) {
+    switch (active_width) {
+        case SIMD_WIDTH_512:
+            return subtraction_avx512(result, minuend, subtrahend, length, borrow);
+        case SIMD_WIDTH_256:
+            return subtraction_avx2(result, minuend, subtrahend, length, borrow);
+        default:
+            return 0;
+    }
+}
+
+/**
+ * Checks the bytes for zero in whole vectors.
+ * @param checked The number of bytes that were checked (all of them were zero).
+ * @return False if a non-zero byte was found.
+ */
+bool wide_simd_is_zero(const uint8_t *mem, size_t length, size_t *checked) {
+    switch (active_width) {
+        case SIMD_WIDTH_512:
+            return is_zero_avx512(mem, length, checked);
+        case SIMD_WIDTH_256:
+            return is_zero_avx2(mem, length, checked);
+        default:
+            *checked = 0;
+            return true;
+    }
+}
+
+/**
+ * Skips the equal whole vectors at the top of the length bytes of a and b (from the most
+ * significant bytes down), the first difference is below the returned length.
+ * @return The number of bytes that are left to compare (length if no wide vectors are supported).
+ */
+size_t wide_simd_skip_equal(const uint8_t *a, const uint8_t *b, size_t length) {
+    switch (active_width) {
+        case SIMD_WIDTH_512:
+            return skip_equal_avx512(a, b, length);
+        case SIMD_WIDTH_256:
+            return skip_equal_avx2(a, b, length);
+        default:
+            return length;
+    }
+}
+
+/**
+ * Shifts the length bytes left by bit_count bits ([0;7]) in-place, bits shifted out of the most
+ * significant byte are cut.
+ * @return False if no wide vectors are supported (then nothing was shifted).
+ */
+bool wide_simd_shift_left(uint8_t *mem, size_t length, uint8_t bit_count) {
+    switch (active_width) {
+        case SIMD_WIDTH_512:
+            shift_left_avx512(mem, length, bit_count);
+            return true;
+        case SIMD_WIDTH_256:
+            shift_left_avx2(mem, length, bit_count);
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * Dabble step of the double dabble conversion in whole vectors: every byte is a digit in [0;
+ * 2 * base) after the doubling. Digits >= base are reduced by base and carry 1 into the next one.
+ * @param carry The incoming carry, it is replaced by the carry into the byte after the processed
+ * ones.
+ * @return The number of processed bytes (0 if no wide vectors are supported).
+ */
+size_t wide_simd_double_dabble_correction(uint8_t *mem, size_t length, uint8_t base, bool *carry) {
+    switch (active_width) {
+        case SIMD_WIDTH_512:
+            return double_dabble_correction_avx512(mem, length, base, carry);
+        case SIMD_WIDTH_256:
+            return double_dabble_correction_avx2(mem, length, base, carry);
+        default:
+            return 0;
+    }
+}
@@ -0,0 +1,41 @@
+#ifndef WIDE_SIMD_H
+#define WIDE_SIMD_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* vector widths of the SIMD kernels (128 bit is the SSE4.2 baseline of the SIMD implementation) */
+typedef enum simd_width {
+    SIMD_WIDTH_128 = 0,  // SSE4.2
+    SIMD_WIDTH_256 = 1,  // AVX2
+    SIMD_WIDTH_512 = 2,  // AVX-512 (F + BW)
+} simd_width;
+
+/* runtime CPU dispatch */
+simd_width get_supported_simd_width(void);
+
+simd_width get_simd_width(void);
+
+simd_width set_simd_width(simd_width width);
+
+const char *simd_width_name(simd_width width);
+
+/* kernels (they process whole vectors only and return how many bytes they processed) */
+size_t wide_simd_addition(uint8_t *a, const uint8_t *b, size_t length, bool *carry);
+
+size_t wide_simd_add_shifted(uint8_t *a, const uint8_t *b, size_t length, uint8_t bit_count,
+                             bool *carry);
+
+size_t wide_simd_subtraction(uint8_t *result, const uint8_t *minuend, const uint8_t *subtrahend,
+                             size_t length, bool *borrow);
+
+bool wide_simd_is_zero(const uint8_t *mem, size_t length, size_t *checked);
+
+size_t wide_simd_skip_equal(const uint8_t *a, const uint8_t *b, size_t length);
+
+bool wide_simd_shift_left(uint8_t *mem, size_t length, uint8_t bit_count);
+
+size_t wide_simd_double_dabble_correction(uint8_t *mem, size_t length, uint8_t base, bool *carry);
+
+#endif
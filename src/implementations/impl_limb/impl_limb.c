@@ -0,0 +1,532 @@
+#include "impl_limb.h"
+
+#include <math.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "../../util.h"
+#include "../common.h"
+#include "../number_system.h"
+#include "../thread_pool.h"
+#include "limb_division.h"
+#include "limb_integer.h"
+#include "limb_integer_arithmetic.h"
+#include "limb_multiplication.h"
+#include "limb_powers.h"
+
+/**
+ * Returns the number of limbs that is enough to hold any number with the given amount of digits in
+ * a base with the absolute value base_abs.
+ */
+static size_t limb_count_for_digits(unsigned int base_abs, size_t length) {
+    // ceil(log_2(base_abs)) bits per digit
+    size_t bits_per_digit = 0;
+    while ((1u << bits_per_digit) < base_abs) {
+        bits_per_digit++;
+    }
+    return (length * bits_per_digit) / 64 + 1;
+}
+
+void arith_op_any_base__limb__schoolbook(int base, const char *alph, const char *z1, const char *z2,
+                                         char op, char *result) {
+    arith_op_any_base__limb(base, alph, z1, z2, op, result, false);
+}
+
+void arith_op_any_base__limb__subquadratic(int base, const char *alph, const char *z1,
+                                           const char *z2, char op, char *result) {
+    arith_op_any_base__limb(base, alph, z1, z2, op, result, true);
+}
+
+/**
+ * This function converts both operands (that are encoded in the given base) to limb_integers
+ * (binary numbers stored in 64-bit limbs). Then, it executes the corresponding operation (+, -, *
+ * or ^) and converts the result back to the desired base format and writes in into the given
+ * result string. The caller of this function needs to make sure that the given result string is big
+ * enough to hold the output value when calling this function.
+ *
+ * @param base Whole number in range [-128;128] (except: -1, 0 and 1) which indicates the base/radix
+ * of the input/output numbers.
+ * @param alph The alphabet that maps each numeric value to a ascii-representable character (digit)
+ * @param z1 The operand 1 string encoded in the desired base format.
+ * @param z2 The operand 2 string encoded in the desired base format.
+ * @param op The operation, either '+', '-', '*' or '^' (respective addition, subtraction,
+ * multiplication or exponentiation, the exponent z2 must not be negative).
+ * @param result The string buffer where the result in encoded format is written to.
+ * @param subquadratic If true, large products are calculated with Karatsuba/Toom-3 multiplication
+ * instead of the schoolbook algorithm.
+ */
+void arith_op_any_base__limb(int base, const char *alph, const char *z1, const char *z2, char op,
+                             char *result, bool subquadratic) {
+    number_system *system = get_number_system(base, alph);
+    unsigned int base_abs = system->base_abs;
+
+    // The exponent of a power is not converted into a limb_integer
+    uint64_t exponent = 0;
+    exponent_status status = op == '^' ? parse_exponent(system, z2, UINT64_MAX, &exponent)
+                                       : EXPONENT_VALID;
+    if (status == EXPONENT_NEGATIVE) abort_err("The exponent %s is negative!", z2);
+    if (status == EXPONENT_TOO_BIG) abort_err("The exponent %s is too big!", z2);
+
+    // Note: negative numbers in positive base systems have a leading '-' char, in negative bases
+    // negative values are encoded without a sign.
+    bool z1_negative = base > 1 && z1[0] == '-';
+    bool z2_negative = base > 1 && z2[0] == '-';
+    if (z1_negative) z1++;
+    if (z2_negative) z2++;
+
+    // Step 1: Conversion of operands to binary
+    size_t z1_length = strlen(z1);
+    size_t z2_length = strlen(z2);
+
+    limb_integer *z1_binary = create_limb_integer(limb_count_for_digits(base_abs, z1_length));
+    limb_integer *z2_binary = create_limb_integer(limb_count_for_digits(base_abs, z2_length));
+
+    convert_any_base_to_limb_integer(system, z1, z1_length, z1_binary);
+    if (op != '^') convert_any_base_to_limb_integer(system, z2, z2_length, z2_binary);
+
+    if (z1_negative && !limb_integer_is_zero(z1_binary)) z1_binary->sign = true;
+    if (z2_negative && !limb_integer_is_zero(z2_binary)) z2_binary->sign = true;
+
+    // Step 2: Perform the actual arithmetic operation on the converted binary values.
+    switch (op) {
+        case '+':
+            limb_integer_addition(z1_binary, z1_binary, z2_binary);
+            break;
+        case '-':
+            limb_integer_subtraction(z1_binary, z1_binary, z2_binary);
+            break;
+        case '*':
+            limb_integer_multiplication(z1_binary, z1_binary, z2_binary, subquadratic);
+            break;
+        case '^': {
+            // the power is written into z2_binary (the exponent is not in there), then both swap
+            limb_integer *power = z2_binary;
+            limb_integer_power(power, z1_binary, exponent, subquadratic);
+            z2_binary = z1_binary;
+            z1_binary = power;
+            break;
+        }
+        default:
+            abort_err("The provided operation %c is not valid!", op);
+    }
+
+    // Step 3: Convert the result back to the original base and write it to the given buffer.
+    convert_limb_integer_to_any_base(system, z1_binary, result);
+
+    // Clear memory (the number system stays cached)
+    delete_limb_integer(z1_binary);
+    delete_limb_integer(z2_binary);
+}
+
+/**
+ * Inputs with at most this many limb-sized chunks of digits are parsed with the (word-wise) Horner
+ * scheme, longer inputs are split recursively.
+ */
+size_t limb_parse_dc_threshold = 32;
+
+/**
+ * The state of a divide-and-conquer parse. In negative bases the digits at even and odd positions
+ * are parsed separately: only the digits at positions of the given parity are parsed, all other
+ * digits count as zero.
+ */
+typedef struct parse_context {
+    limb_power_table *powers;
+    // -1: all digits, 0/1: only the digits at even/odd positions
+    int parity;
+} parse_context;
+
+/**
+ * Parses n <= digits_per_limb digit values into a single limb.
+ * @param position The position of the least significant digit (z[n - 1]) in the whole number.
+ */
+static uint64_t parse_chunk(const parse_context *ctx, const uint8_t *z, size_t n,
+                            size_t position) {
+    uint64_t base = ctx->powers->base;
+    uint64_t value = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        uint64_t digit_value = z[i];
+        if (ctx->parity >= 0 && ((position + n - 1 - i) & 1) != (size_t) ctx->parity) {
+            digit_value = 0;
+        }
+        value = value * base + digit_value;
+    }
+
+    return value;
+}
+
+/**
+ * Parses the digits with the Horner scheme, one limb-sized chunk of digits at a time:
+ * value = value * base^digits_per_limb + chunk.
+ */
+static void parse_horner(const parse_context *ctx, const uint8_t *z, size_t length,
+                         size_t position, limb_integer *result) {
+    size_t k = ctx->powers->digits_per_limb;
+
+    // the first chunk takes the digits that do not fill up a whole chunk
+    size_t first = length % k == 0 ? k : length % k;
+
+    limb_integer_set_uint64(result, parse_chunk(ctx, z, first, position + length - first));
+
+    for (size_t i = first; i < length; i += k) {
+        uint64_t chunk = parse_chunk(ctx, z + i, k, position + length - i - k);
+        limb_integer_mul_1_add(result, ctx->powers->limb_base, chunk);
+    }
+}
+
+/**
+ * A part of the digits that is parsed on its own (possibly in parallel with the other parts).
+ */
+typedef struct parse_part {
+    const parse_context *ctx;
+    const uint8_t *z;
+    size_t length;
+    size_t position;
+    limb_integer *result;
+} parse_part;
+
+static void parse_divide_and_conquer(const parse_context *ctx, const uint8_t *z, size_t length,
+                                     size_t position, limb_integer *result);
+
+static void parse_part_task(void *context, size_t index) {
+    parse_part *part = (parse_part *) context + index;
+    parse_divide_and_conquer(part->ctx, part->z, part->length, part->position, part->result);
+}
+
+/**
+ * Returns i of the biggest low part of digits_per_limb * 2^i digits that is shorter than the number.
+ */
+static size_t parse_split_level(size_t k, size_t length) {
+    size_t i = 0;
+    while ((k << (i + 1)) < length) {
+        i++;
+    }
+    return i;
+}
+
+/**
+ * Parses the digits by splitting them into a low part of digits_per_limb * 2^i digits and a high
+ * part with the remaining digits: value = high * base^(digits_per_limb * 2^i) + low. The parts are
+ * parsed recursively (in parallel if they are long enough), the multiplication with the power is
+ * subquadratic.
+ */
+static void parse_divide_and_conquer(const parse_context *ctx, const uint8_t *z, size_t length,
+                                     size_t position, limb_integer *result) {
+    size_t k = ctx->powers->digits_per_limb;
+
+    if (length <= k * limb_parse_dc_threshold) {
+        parse_horner(ctx, z, length, position, result);
+        return;
+    }
+
+    size_t i = parse_split_level(k, length);
+    size_t low_length = k << i;
+
+    // the parts only need smaller powers, so they never have to compute (and lock) a power
+    const limb_integer *power = limb_power_table_get(ctx->powers, i);
+
+    limb_integer *low = create_limb_integer(((size_t) 1 << i) + 1);
+    parse_part parts[] = {{ctx, z, length - low_length, position + low_length, result},
+                          {ctx, z + length - low_length, low_length, position, low}};
+    if (limb_split_across_threads((size_t) 1 << i)) {
+        thread_pool_run(2, parse_part_task, parts);
+    } else {
+        parse_part_task(parts, 0);
+        parse_part_task(parts, 1);
+    }
+
+    limb_integer_multiplication(result, result, power, true);
+    limb_integer_addition(result, result, low);
+    delete_limb_integer(low);
+}
+
+/**
+ * Converts the given string z (without sign) to its binary representation and stores it in the
+ * given limb_integer. The digits are packed into limb-sized chunks which are combined recursively
+ * with the powers base^(digits_per_limb * 2^i) (divide-and-conquer conversion).
+ *
+ * In negative bases, the value is P - N where P has the digits at the even positions of z and N the
+ * digits at the odd positions (both read in the base |base|), since (-b)^i = b^i for even i and
+ * -b^i for odd i.
+ *
+ * The digits are translated to their values (16 at a time) before they are parsed.
+ *
+ * @param system The number system, in negative bases the sign of the value alternates with every
+ * digit.
+ * @param z The digits.
+ * @param z_length The number of digits.
+ * @param result The limb_integer the value is written into. It grows if it is not big enough.
+ */
+void convert_any_base_to_limb_integer(number_system *system, const char *z, size_t z_length,
+                                      limb_integer *result) {
+    limb_power_table *powers = system->powers;
+
+    if (z_length == 0) {
+        limb_integer_set_zero(result);
+        return;
+    }
+
+    uint8_t *values = malloc(z_length);
+    check_alloc(values, z_length, "digit values");
+    digits_to_values(&system->tables, z, z_length, values);
+
+    if (system->base > 0) {
+        parse_context ctx = {powers, -1};
+        parse_divide_and_conquer(&ctx, values, z_length, 0, result);
+        free(values);
+        return;
+    }
+
+    // the even and the odd digits are parsed in parallel, the powers they need are computed before
+    parse_context even = {powers, 0};
+    parse_context odd = {powers, 1};
+    limb_integer *odd_value = create_limb_integer(z_length / powers->digits_per_limb + 2);
+    parse_part parts[] = {{&even, values, z_length, 0, result},
+                          {&odd, values, z_length, 0, odd_value}};
+    if (limb_split_across_threads(z_length / powers->digits_per_limb)) {
+        limb_power_table_get(powers, parse_split_level(powers->digits_per_limb, z_length));
+        thread_pool_run(2, parse_part_task, parts);
+    } else {
+        parse_part_task(parts, 0);
+        parse_part_task(parts, 1);
+    }
+
+    limb_integer_subtraction(result, result, odd_value);
+    delete_limb_integer(odd_value);
+    free(values);
+}
+
+/**
+ * Values with at most this many limbs are converted with repeated divisions by
+ * base^digits_per_limb, bigger values are split recursively.
+ */
+size_t limb_output_dc_threshold = 32;
+
+/**
+ * Writes the digit values of the non-negative value (most significant first) into out by dividing
+ * it repeatedly by limb_base = base^digits_per_limb and splitting every remainder into
+ * digits_per_limb digits. Exactly digits digits are written (with leading zeroes), the value has to
+ * fit into them. The value gets overwritten.
+ */
+static void output_leaf(const limb_power_table *powers, limb_integer *value, size_t digits,
+                        uint8_t *out) {
+    size_t k = powers->digits_per_limb;
+    uint64_t base = powers->base;
+
+    size_t index = digits;
+    while (!limb_integer_is_zero(value)) {
+        uint64_t chunk = limb_integer_div_1(value, powers->limb_base);
+        for (size_t j = 0; j < k && index > 0; j++) {
+            out[--index] = chunk % base;
+            chunk /= base;
+        }
+    }
+    while (index > 0) {
+        out[--index] = 0;
+    }
+}
+
+static size_t output_divide_and_conquer(limb_power_table *powers, limb_integer *value,
+                                        bool padded, size_t digits, uint8_t *out);
+
+/**
+ * A part of the value that is written on its own (possibly in parallel with the other parts).
+ */
+typedef struct output_part {
+    limb_power_table *powers;
+    limb_integer *value;
+    bool padded;
+    size_t digits;
+    uint8_t *out;
+    size_t written;
+} output_part;
+
+static void output_part_task(void *context, size_t index) {
+    output_part *part = (output_part *) context + index;
+    part->written = output_divide_and_conquer(part->powers, part->value, part->padded, part->digits,
+                                              part->out);
+}
+
+/**
+ * Writes high and low (with exactly low_digits digits) in parallel. The low digits are written into
+ * a temporary buffer first if the number of digits of high is not known in advance.
+ */
+static size_t output_parts_in_parallel(limb_power_table *powers, limb_integer *high,
+                                       limb_integer *low, size_t i, bool padded, size_t digits,
+                                       uint8_t *out) {
+    size_t low_digits = powers->digits_per_limb << i;
+
+    // the parts only need smaller powers, so they never have to compute (and lock) a power
+    for (size_t j = 0; j < i; j++) {
+        limb_power_table_get_inverse(powers, j);
+    }
+
+    uint8_t *low_out = padded ? out + digits - low_digits : malloc(low_digits);
+    check_alloc(low_out, low_digits, "low digits");
+
+    output_part parts[] = {{powers, high, padded, padded ? digits - low_digits : 0, out, 0},
+                           {powers, low, true, low_digits, low_out, 0}};
+    thread_pool_run(2, output_part_task, parts);
+
+    if (!padded) {
+        memcpy(out + parts[0].written, low_out, low_digits);
+        free(low_out);
+    }
+    return parts[0].written + low_digits;
+}
+
+/**
+ * Writes the digit values of the non-negative value (most significant first) into out with the
+ * divide-and-conquer conversion: value = high * P + low with the power P = base^(k * 2^i)
+ * (k = digits_per_limb), where low is written with exactly k * 2^i digits. The division by P is a
+ * Barrett division with the cached reciprocal of P. The parts are written in parallel if the value
+ * is long enough.
+ *
+ * @param padded If true, exactly digits digits are written (with leading zeroes), otherwise the
+ * value is written without leading zeroes.
+ * @return The number of written digits.
+ */
+static size_t output_divide_and_conquer(limb_power_table *powers, limb_integer *value,
+                                        bool padded, size_t digits, uint8_t *out) {
+    size_t k = powers->digits_per_limb;
+
+    if (value->size <= limb_output_dc_threshold || value->size <= 2) {
+        if (padded) {
+            output_leaf(powers, value, digits, out);
+            return digits;
+        }
+
+        // (k + 1) digits per limb are always enough, the leading zeroes are removed afterwards
+        size_t max_digits = (k + 1) * value->size;
+        uint8_t *tmp = malloc(max_digits);
+        check_alloc(tmp, max_digits, "leaf digits");
+        output_leaf(powers, value, max_digits, tmp);
+
+        size_t leading_zeroes = 0;
+        while (leading_zeroes < max_digits && tmp[leading_zeroes] == 0) {
+            leading_zeroes++;
+        }
+        memcpy(out, tmp + leading_zeroes, max_digits - leading_zeroes);
+        free(tmp);
+        return max_digits - leading_zeroes;
+    }
+
+    // the smallest power with at least half of the limbs of the value (value < P^2)
+    size_t i = 0;
+    while (2 * limb_power_table_get(powers, i)->size < value->size) {
+        i++;
+    }
+    size_t low_digits = k << i;
+
+    limb_integer *high = create_limb_integer(value->size / 2 + 2);
+    limb_integer *low = create_limb_integer(value->size / 2 + 2);
+    limb_integer_divmod_barrett(high, low, value, limb_power_table_get(powers, i),
+                                limb_power_table_get_inverse(powers, i));
+
+    size_t written;
+    if (!padded && limb_integer_is_zero(high)) {
+        delete_limb_integer(high);
+        written = output_divide_and_conquer(powers, low, false, 0, out);
+        delete_limb_integer(low);
+        return written;
+    } else if (limb_split_across_threads(value->size)) {
+        written = output_parts_in_parallel(powers, high, low, i, padded, digits, out);
+    } else {
+        written = output_divide_and_conquer(powers, high, padded, padded ? digits - low_digits : 0,
+                                            out);
+        written += output_divide_and_conquer(powers, low, true, low_digits, out + written);
+    }
+
+    delete_limb_integer(high);
+    delete_limb_integer(low);
+
+    return written;
+}
+
+/**
+ * Returns an upper bound for the number of digits of the absolute value in the given base.
+ */
+static size_t max_digits_of_limb_integer(const limb_integer *value, uint64_t base_abs) {
+    size_t bits = 64 * value->size - __builtin_clzll(value->limbs[value->size - 1]);
+    return (size_t) ((double) bits / log2((double) base_abs)) + 2;
+}
+
+/**
+ * Converts the given limb_integer value to a NULL terminated string (in buffer) that is encoded in
+ * the given base with the given alphabet, using the divide-and-conquer conversion.
+ *
+ * Negative bases are converted with the help of M = sum of (|base| - 1) * |base|^j for all odd
+ * positions j < L: The digits e_j of value + M in the base |base| give the digits in the negative
+ * base with d_j = e_j at even positions and d_j = |base| - 1 - e_j at odd positions, since
+ * d_j * (-|base|)^j = -d_j * |base|^j for odd j.
+ *
+ * The digit values are translated to the chars of the alphabet (16 at a time) at the end.
+ *
+ * @param system The number system in which the value should be converted.
+ * @param value The value that should be converted. It gets overwritten during the conversion.
+ * @param buffer The buffer where the output string should be written to. It has to be big enough.
+ */
+void convert_limb_integer_to_any_base(number_system *system, limb_integer *value, char *buffer) {
+    limb_power_table *powers = system->powers;
+    const digit_tables *tables = &system->tables;
+    uint64_t base_abs = system->base_abs;
+
+    if (limb_integer_is_zero(value)) {
+        buffer[0] = tables->alph[0];
+        buffer[1] = '\0';
+        return;
+    }
+
+    if (system->base > 0) {
+        // add '-' if the value is negative (only in positive bases)
+        size_t index = 0;
+        if (value->sign) {
+            buffer[index++] = '-';
+            value->sign = false;
+        }
+        uint8_t *values = (uint8_t *) buffer + index;
+        size_t written = output_divide_and_conquer(powers, value, false, 0, values);
+        values_to_digits(tables, values, written, buffer + index);
+        buffer[index + written] = '\0';
+        return;
+    }
+
+    // L digits (even) are enough for the value in the negative base
+    size_t length = max_digits_of_limb_integer(value, base_abs) + 2;
+    length += length % 2;
+
+    // M = |base| * (|base|^L - 1) / (|base| + 1) has the digit |base| - 1 at every odd position
+    limb_integer *m = create_limb_integer(value->size + 2);
+    limb_integer_set_uint64(m, 1);
+    for (size_t bit = (size_t) 1 << (63 - __builtin_clzll(length)); bit > 0; bit >>= 1) {
+        limb_integer_multiplication(m, m, m, true);
+        if (length & bit) limb_integer_mul_1_add(m, base_abs, 0);
+    }
+    limb_integer_add_int64(m, -1);
+    limb_integer_div_1(m, base_abs + 1);
+    limb_integer_mul_1_add(m, base_abs, 0);
+
+    limb_integer_addition(value, value, m);
+    delete_limb_integer(m);
+
+    // the L digits of value + M (the buffer may be too small for the leading zeroes)
+    uint8_t *digits = malloc(length);
+    check_alloc(digits, length, "negative base digits");
+    output_divide_and_conquer(powers, value, true, length, digits);
+
+    for (size_t i = 0; i < length; i++) {
+        // position L - 1 - i is odd
+        if ((length - 1 - i) % 2 == 1) {
+            digits[i] = base_abs - 1 - digits[i];
+        }
+    }
+
+    size_t leading_zeroes = 0;
+    while (leading_zeroes < length - 1 && digits[leading_zeroes] == 0) {
+        leading_zeroes++;
+    }
+    values_to_digits(tables, digits + leading_zeroes, length - leading_zeroes, buffer);
+    buffer[length - leading_zeroes] = '\0';
+
+    free(digits);
+}
@@ -0,0 +1,34 @@
+#ifndef IMPL_LIMB_H
+#define IMPL_LIMB_H
+
+#include <limits.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "../number_system.h"
+#include "limb_integer.h"
+#include "limb_powers.h"
+
+/* tunable threshold (in limb-sized chunks of digits) of the divide-and-conquer parse */
+extern size_t limb_parse_dc_threshold;
+
+/* tunable threshold (in limbs) of the divide-and-conquer output conversion */
+extern size_t limb_output_dc_threshold;
+
+/* core functions */
+void arith_op_any_base__limb__schoolbook(int base, const char *alph, const char *z1, const char *z2,
+                                         char op, char *result);
+
+void arith_op_any_base__limb__subquadratic(int base, const char *alph, const char *z1,
+                                           const char *z2, char op, char *result);
+
+void arith_op_any_base__limb(int base, const char *alph, const char *z1, const char *z2, char op,
+                             char *result, bool subquadratic);
+
+/* conversion */
+void convert_any_base_to_limb_integer(number_system *system, const char *z, size_t z_length,
+                                      limb_integer *result);
+
+void convert_limb_integer_to_any_base(number_system *system, limb_integer *value, char *buffer);
+
+#endif
@@ -0,0 +1,252 @@
+#include "limb_division.h"
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../util.h"
+#include "limb_integer_arithmetic.h"
+
+typedef unsigned __int128 uint128_t;
+
+/*
+ *
+ * This file contains the multi-limb division of the limb implementation:
+ *  - the schoolbook long division (Knuth, TAOCP Vol. 2, Algorithm 4.3.1 D)
+ *  - the reciprocal floor(B^2n / d) (B = 2^64) with Newton iteration on the upper half of the limbs
+ *  - the Barrett division with a precomputed reciprocal, which only needs multiplications
+ *
+ */
+
+/**
+ * Divisors with at most this many limbs get their reciprocal from the schoolbook division.
+ */
+size_t limb_newton_threshold = 32;
+
+/**
+ * Schoolbook long division of limb arrays: q = a / d, r = a % d (Knuth's Algorithm D).
+ * The divisor is normalized (shifted so that its most significant bit is set), so that every
+ * estimated quotient limb is at most two too big.
+ *
+ * @param q The quotient, has to hold a_n - d_n + 1 limbs.
+ * @param r The remainder, has to hold d_n limbs.
+ * a_n >= d_n, the most significant limb of d must not be zero and q and r must not overlap with the
+ * operands.
+ */
+void limb_div_qr(uint64_t *q, uint64_t *r, const uint64_t *a, size_t a_n, const uint64_t *d,
+                 size_t d_n) {
+    if (d_n == 1) {
+        r[0] = limb_div_1(q, a, a_n, d[0]);
+        return;
+    }
+
+    // normalized copies of the operands, u gets an additional most significant limb
+    unsigned int shift = __builtin_clzll(d[d_n - 1]);
+    uint64_t *v = malloc(d_n * sizeof(uint64_t));
+    check_alloc(v, d_n * sizeof(uint64_t), "normalized divisor");
+    uint64_t *u = malloc((a_n + 1) * sizeof(uint64_t));
+    check_alloc(u, (a_n + 1) * sizeof(uint64_t), "normalized dividend");
+
+    if (shift != 0) {
+        limb_lshift(v, d, d_n, shift);
+        u[a_n] = limb_lshift(u, a, a_n, shift);
+    } else {
+        memcpy(v, d, d_n * sizeof(uint64_t));
+        memcpy(u, a, a_n * sizeof(uint64_t));
+        u[a_n] = 0;
+    }
+
+    uint64_t v1 = v[d_n - 1];
+    uint64_t v2 = v[d_n - 2];
+
+    for (size_t j = a_n - d_n + 1; j > 0; j--) {
+        uint64_t *window = u + j - 1;  // d_n + 1 limbs
+        uint64_t u0 = window[d_n];
+        uint64_t u1 = window[d_n - 1];
+        uint64_t u2 = window[d_n - 2];
+
+        // estimate the quotient limb with the two most significant limbs (u0 <= v1 always holds)
+        uint64_t qhat;
+        uint64_t rhat;
+        bool rhat_overflow = false;
+        if (u0 >= v1) {
+            qhat = UINT64_MAX;
+            rhat = u1 + v1;
+            rhat_overflow = rhat < v1;
+        } else {
+            qhat = udiv_128_by_64(u0, u1, v1, &rhat);
+        }
+
+        // correct the estimate with the second limb of the divisor
+        while (!rhat_overflow && (uint128_t) qhat * v2 > (((uint128_t) rhat << 64) | u2)) {
+            qhat--;
+            rhat += v1;
+            rhat_overflow = rhat < v1;
+        }
+
+        // window -= qhat * v, add v back if the estimate was still one too big
+        uint64_t borrow = limb_submul_1(window, v, d_n, qhat);
+        if (u0 < borrow) {
+            qhat--;
+            window[d_n] = u0 - borrow + limb_add_n(window, window, v, d_n);
+        } else {
+            window[d_n] = u0 - borrow;
+        }
+
+        q[j - 1] = qhat;
+    }
+
+    // the remainder has to be shifted back
+    if (shift != 0) {
+        limb_rshift(r, u, d_n, shift);
+    } else {
+        memcpy(r, u, d_n * sizeof(uint64_t));
+    }
+
+    free(u);
+    free(v);
+}
+
+/**
+ * Divides the absolute values of two limb_integers with the schoolbook division:
+ * q = |x| / |d|, r = |x| % |d|. q and r are positive and must not be the same limb_integers as x or
+ * d.
+ */
+void limb_integer_divmod(limb_integer *q, limb_integer *r, const limb_integer *x,
+                         const limb_integer *d) {
+    if (d->size == 0) {
+        abort_err("[FATAL] limb_integer_divmod: Division by zero.");
+    }
+
+    if (limb_integer_compare_magnitude(x, d) < 0) {
+        limb_integer_set_zero(q);
+        copy_limb_integer_value_into_another(x, r);
+        r->sign = false;
+        return;
+    }
+
+    limb_integer_reserve(q, x->size - d->size + 1);
+    limb_integer_reserve(r, d->size);
+    limb_div_qr(q->limbs, r->limbs, x->limbs, x->size, d->limbs, d->size);
+
+    q->size = x->size - d->size + 1;
+    q->sign = false;
+    limb_integer_normalize(q);
+    r->size = d->size;
+    r->sign = false;
+    limb_integer_normalize(r);
+}
+
+/**
+ * Returns B^exponent (B = 2^64) as a new limb_integer.
+ */
+static limb_integer *create_limb_integer_power_of_b(size_t exponent) {
+    limb_integer *power = create_limb_integer(exponent + 1);
+    memset(power->limbs, 0, exponent * sizeof(uint64_t));
+    power->limbs[exponent] = 1;
+    power->size = exponent + 1;
+    return power;
+}
+
+/**
+ * Calculates the reciprocal of the absolute value of d: result = floor(B^2n / |d|) where n is the
+ * number of limbs of d (B = 2^64).
+ *
+ * Above limb_newton_threshold limbs, the reciprocal x0 of the upper h (about n / 2) limbs of d is
+ * calculated recursively and scaled to n limbs. It already has about h correct limbs, one Newton
+ * step x1 = x0 + x0 * (B^2n - d * x0) / B^2n doubles them. The (small) remaining error is
+ * corrected with the remainder B^2n - d * x1. So the reciprocal only costs a few multiplications of
+ * n limbs.
+ */
+void limb_integer_reciprocal(limb_integer *result, const limb_integer *d) {
+    size_t n = d->size;
+    if (n == 0) {
+        abort_err("[FATAL] limb_integer_reciprocal: Division by zero.");
+    }
+
+    limb_integer *power = create_limb_integer_power_of_b(2 * n);
+
+    if (n <= limb_newton_threshold || n <= 8) {
+        limb_integer *remainder = create_limb_integer(n);
+        limb_integer_divmod(result, remainder, power, d);
+        delete_limb_integer(remainder);
+        delete_limb_integer(power);
+        return;
+    }
+
+    // reciprocal of the upper h limbs of d, scaled to n limbs: x0 = floor(B^2h / d_high) * B^(n-h)
+    size_t h = (n + 1) / 2 + 3;
+    limb_integer d_high = {false, h, h, d->limbs + n - h};
+    limb_integer_reciprocal(result, &d_high);
+    limb_integer_shift_left_limbs(result, n - h);
+
+    limb_integer d_abs = {false, d->capacity, n, d->limbs};
+
+    // e = B^2n - d * x0
+    limb_integer *e = create_limb_integer(2 * n + 2);
+    limb_integer_multiplication(e, &d_abs, result, true);
+    e->sign = true;
+    limb_integer_addition(e, e, power);
+
+    // Newton step: x1 = x0 + t with t = x0 * e / B^2n
+    limb_integer *t = create_limb_integer(n + 2);
+    limb_integer_multiplication(t, result, e, true);
+    limb_integer_shift_right_limbs(t, 2 * n);
+    limb_integer_addition(result, result, t);
+
+    // remainder of x1: B^2n - d * x1 = e - d * t
+    limb_integer_multiplication(t, &d_abs, t, true);
+    limb_integer_subtraction(e, e, t);
+
+    // correct the last limb(s) until 0 <= B^2n - d * x1 < d
+    while (e->sign) {
+        limb_integer_add_int64(result, -1);
+        limb_integer_addition(e, e, &d_abs);
+    }
+    while (limb_integer_compare_magnitude(e, &d_abs) >= 0) {
+        limb_integer_add_int64(result, 1);
+        limb_integer_subtraction(e, e, &d_abs);
+    }
+
+    delete_limb_integer(e);
+    delete_limb_integer(t);
+    delete_limb_integer(power);
+}
+
+/**
+ * Divides the absolute values of two limb_integers with the Barrett division:
+ * q = |x| / |d|, r = |x| % |d|. The quotient is estimated with the reciprocal of d by
+ * q = ((x / B^(n-1)) * inverse) / B^(n+1), which is at most 2 too small, and then corrected.
+ *
+ * @param inverse The reciprocal floor(B^2n / |d|) (see limb_integer_reciprocal).
+ * |x| has to be less than B^2n where n is the number of limbs of d. q and r are positive and must
+ * not be the same limb_integers as x, d or inverse.
+ */
+void limb_integer_divmod_barrett(limb_integer *q, limb_integer *r, const limb_integer *x,
+                                 const limb_integer *d, const limb_integer *inverse) {
+    size_t n = d->size;
+
+    if (limb_integer_compare_magnitude(x, d) < 0) {
+        limb_integer_set_zero(q);
+        copy_limb_integer_value_into_another(x, r);
+        r->sign = false;
+        return;
+    }
+
+    // q = ((x / B^(n-1)) * inverse) / B^(n+1)
+    limb_integer x_high = {false, x->size - (n - 1), x->size - (n - 1), x->limbs + (n - 1)};
+    limb_integer_multiplication(q, &x_high, inverse, true);
+    limb_integer_shift_right_limbs(q, n + 1);
+    q->sign = false;
+
+    // r = x - q * d
+    limb_integer x_abs = {false, x->capacity, x->size, x->limbs};
+    limb_integer d_abs = {false, d->capacity, n, d->limbs};
+    limb_integer_multiplication(r, q, &d_abs, true);
+    limb_integer_subtraction(r, &x_abs, r);
+
+    while (limb_integer_compare_magnitude(r, &d_abs) >= 0) {
+        limb_integer_subtraction(r, r, &d_abs);
+        limb_integer_add_int64(q, 1);
+    }
+}
@@ -0,0 +1,25 @@
+#ifndef LIMB_DIVISION_H
+#define LIMB_DIVISION_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "limb_integer.h"
+
+/* tunable threshold (in limbs) of the Newton reciprocal */
+extern size_t limb_newton_threshold;
+
+/* division kernels */
+void limb_div_qr(uint64_t *q, uint64_t *r, const uint64_t *a, size_t a_n, const uint64_t *d,
+                 size_t d_n);
+
+/* limb_integer division */
+void limb_integer_divmod(limb_integer *q, limb_integer *r, const limb_integer *x,
+                         const limb_integer *d);
+
+void limb_integer_reciprocal(limb_integer *result, const limb_integer *d);
+
+void limb_integer_divmod_barrett(limb_integer *q, limb_integer *r, const limb_integer *x,
+                                 const limb_integer *d, const limb_integer *inverse);
+
+#endif
@@ -0,0 +1,199 @@
+#include "limb_integer.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../util.h"
+
+/*
+ *
+ * This file contains methods for the initialization and utility of limb_integers.
+ * The file limb_integer_arithmetic.c contains the limb kernels and limb_integer arithmetic.
+ *
+ */
+
+// Definition of limb_integer type in header file.
+/*
+
+    Definition of an arbitrary precision integer that is stored in 64-bit limbs.
+    bool "sign" is the sign bit of the number. When set to true, the number is negative and vice
+    versa. "capacity" specifies how many limbs are allocated at "limbs". "size" is the number of
+    significant limbs: limbs[size - 1] is never zero, and the value zero has size 0. Limbs at
+    index >= size have undefined content. limbs[0] stores the least significant limb.
+
+    typedef struct limb_integer {
+        bool sign;
+        size_t capacity;
+        size_t size;
+        uint64_t *limbs;
+    } limb_integer;
+
+ */
+
+/*
+ * =====================================================================
+ * Initialization of limb integers
+ * =====================================================================
+ */
+
+/**
+ * Creates a limb_integer with the value (positive) zero that can hold capacity limbs without being
+ * resized.
+ * @param capacity Number of limbs that get allocated. At least one limb is always allocated.
+ * @return The pointer to the created limb_integer. Make sure to free this memory.
+ */
+limb_integer *create_limb_integer(size_t capacity) {
+    if (capacity == 0) capacity = 1;
+
+    limb_integer *value = (limb_integer *) calloc(1, sizeof(limb_integer));
+    check_alloc(value, sizeof(limb_integer), "limb_integer");
+
+    value->limbs = malloc(capacity * sizeof(uint64_t));
+    check_alloc(value->limbs, capacity * sizeof(uint64_t), "limb_integer->limbs");
+
+    value->capacity = capacity;
+    value->size = 0;
+    value->sign = false;
+
+    return value;
+}
+
+/**
+ * Creates a limb_integer of the given limb values (least significant limb first) and sign.
+ * @param length The number of limbs.
+ * @param limbs The limb values.
+ * @param sign The sign indicating whether the limb_integer is negative or positive.
+ * @return The pointer to the created limb_integer. Make sure to free this memory.
+ */
+limb_integer *create_limb_integer_of_limbs(size_t length, const uint64_t limbs[length], bool sign) {
+    limb_integer *value = create_limb_integer(length);
+    memcpy(value->limbs, limbs, length * sizeof(uint64_t));
+    value->size = length;
+    value->sign = sign;
+    limb_integer_normalize(value);
+    return value;
+}
+
+/**
+ * Creates a new limb_integer which has exactly the same value as the given one.
+ * @return The pointer to the created limb_integer. Make sure to free this memory.
+ */
+limb_integer *clone_limb_integer(const limb_integer *og_limb_integer) {
+    limb_integer *value = create_limb_integer(og_limb_integer->size);
+    copy_limb_integer_value_into_another(og_limb_integer, value);
+    return value;
+}
+
+/**
+ * Copies the value of the source limb_integer to the destination limb_integer. The destination
+ * grows if it is not big enough.
+ * @param source The limb_integer to get the value from.
+ * @param destination The limb_integer to write the value into.
+ */
+void copy_limb_integer_value_into_another(const limb_integer *source, limb_integer *destination) {
+    if (source == destination) return;
+
+    limb_integer_reserve(destination, source->size);
+    memcpy(destination->limbs, source->limbs, source->size * sizeof(uint64_t));
+    destination->size = source->size;
+    destination->sign = source->sign;
+}
+
+/*
+ * =====================================================================
+ * Limb integer util
+ * =====================================================================
+ */
+
+/**
+ * Makes sure that the limb_integer can hold at least capacity limbs. The value is preserved.
+ */
+void limb_integer_reserve(limb_integer *value, size_t capacity) {
+    if (capacity <= value->capacity) return;
+
+    uint64_t *limbs = realloc(value->limbs, capacity * sizeof(uint64_t));
+    check_alloc(limbs, capacity * sizeof(uint64_t), "limb_integer->limbs");
+
+    value->limbs = limbs;
+    value->capacity = capacity;
+}
+
+/**
+ * Strips the most significant zero limbs from the size of the limb_integer. Zero is always
+ * positive.
+ */
+void limb_integer_normalize(limb_integer *value) {
+    size_t size = value->size;
+    while (size > 0 && value->limbs[size - 1] == 0) {
+        size--;
+    }
+    value->size = size;
+
+    if (size == 0) value->sign = false;
+}
+
+/**
+ * Sets the value of the limb_integer to (positive) zero.
+ */
+void limb_integer_set_zero(limb_integer *value) {
+    value->size = 0;
+    value->sign = false;
+}
+
+/**
+ * Sets the value of the limb_integer to the given (positive) 64-bit value.
+ */
+void limb_integer_set_uint64(limb_integer *value, uint64_t u) {
+    value->sign = false;
+    if (u == 0) {
+        value->size = 0;
+        return;
+    }
+    value->limbs[0] = u;
+    value->size = 1;
+}
+
+/**
+ * Deletes the whole given limb_integer.
+ */
+void delete_limb_integer(limb_integer *value) {
+    if (value->limbs == NULL) {
+        abort_err("delete_limb_integer() was called twice on a limb_integer!");
+    }
+
+    free(value->limbs);
+
+    // set NULL to check if limb_integer was already free'd (error handling)
+    value->limbs = NULL;
+
+    free(value);
+}
+
+/**
+ * Returns true if the value of the given limb_integer is zero.
+ * Complexity: Θ(1)
+ */
+bool limb_integer_is_zero(const limb_integer *value) { return value->size == 0; }
+
+/**
+ * Checks if two limb_integers are equal.
+ */
+bool limb_integer_is_equal(const limb_integer *a, const limb_integer *b) {
+    if (a->size != b->size || a->sign != b->sign) return false;
+    return memcmp(a->limbs, b->limbs, a->size * sizeof(uint64_t)) == 0;
+}
+
+/**
+ * Util/Debugging-function: Prints the limb_integer value in hexadecimal representation.
+ */
+void print_limb_integer_hex(const limb_integer *val) {
+    printf(val->sign ? "- " : "+ ");
+    printf("0x ");
+    if (val->size == 0) printf("0");
+    for (size_t i = val->size; i > 0; i--) {
+        printf("%016lX ", (unsigned long) val->limbs[i - 1]);
+    }
+    printf("(size: %zu limbs, capacity: %zu limbs)\n", val->size, val->capacity);
+}
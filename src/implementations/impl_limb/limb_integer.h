@@ -0,0 +1,45 @@
+#ifndef LIMB_INTEGER_H
+#define LIMB_INTEGER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+typedef struct limb_integer {
+    bool sign;
+    size_t capacity;
+    size_t size;
+    uint64_t *limbs;
+} limb_integer;
+
+/* Initialization of limb_integers */
+limb_integer *create_limb_integer(size_t capacity);
+
+limb_integer *create_limb_integer_of_limbs(size_t length, const uint64_t limbs[length], bool sign);
+
+limb_integer *clone_limb_integer(const limb_integer *og_limb_integer);
+
+void copy_limb_integer_value_into_another(const limb_integer *source, limb_integer *destination);
+
+/* size management */
+void limb_integer_reserve(limb_integer *value, size_t capacity);
+
+void limb_integer_normalize(limb_integer *value);
+
+/* setters */
+void limb_integer_set_zero(limb_integer *value);
+
+void limb_integer_set_uint64(limb_integer *value, uint64_t u);
+
+/* deletion */
+void delete_limb_integer(limb_integer *value);
+
+/* checks */
+bool limb_integer_is_zero(const limb_integer *value);
+
+bool limb_integer_is_equal(const limb_integer *a, const limb_integer *b);
+
+/* debug/IO */
+void print_limb_integer_hex(const limb_integer *val);
+
+#endif
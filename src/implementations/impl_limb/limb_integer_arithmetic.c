@@ -0,0 +1,499 @@
+#include "limb_integer_arithmetic.h"
+
+#include <immintrin.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../util.h"
+#include "limb_multiplication.h"
+
+typedef unsigned __int128 uint128_t;
+
+/*
+ * =====================================================================
+ * Limb kernels
+ * =====================================================================
+ *
+ * The kernels work on plain limb arrays and do not care about signs or sizes of limb_integers.
+ * Carries and borrows are propagated with the ADC/SBB instructions (_addcarry_u64,
+ * _subborrow_u64), products are computed with the 64x64->128 bit multiplication.
+ */
+
+/**
+ * Adds two limb arrays of the same length: r = a + b.
+ * r may be the same array as a or b.
+ * @return The carry out of the most significant limb (0 or 1).
+ */
+uint64_t limb_add_n(uint64_t *r, const uint64_t *a, const uint64_t *b, size_t n) {
+    unsigned char carry = 0;
+    for (size_t i = 0; i < n; i++) {
+        unsigned long long sum;
+        carry = _addcarry_u64(carry, a[i], b[i], &sum);
+        r[i] = sum;
+    }
+    return carry;
+}
+
+/**
+ * Adds two limb arrays: r = a + b, where a is at least as long as b (a_n >= b_n).
+ * r has to hold a_n limbs and may be the same array as a or b.
+ * @return The carry out of the most significant limb (0 or 1).
+ */
+uint64_t limb_add(uint64_t *r, const uint64_t *a, size_t a_n, const uint64_t *b, size_t b_n) {
+    unsigned char carry = limb_add_n(r, a, b, b_n);
+
+    size_t i = b_n;
+    // propagate the carry through the remaining limbs of a
+    for (; carry && i < a_n; i++) {
+        unsigned long long sum;
+        carry = _addcarry_u64(carry, a[i], 0, &sum);
+        r[i] = sum;
+    }
+    // the remaining limbs are unchanged
+    if (r != a && i < a_n) {
+        memcpy(r + i, a + i, (a_n - i) * sizeof(uint64_t));
+    }
+    return carry;
+}
+
+/**
+ * Subtracts two limb arrays of the same length: r = a - b.
+ * r may be the same array as a or b.
+ * @return The borrow out of the most significant limb (0 or 1).
+ */
+uint64_t limb_sub_n(uint64_t *r, const uint64_t *a, const uint64_t *b, size_t n) {
+    unsigned char borrow = 0;
+    for (size_t i = 0; i < n; i++) {
+        unsigned long long diff;
+        borrow = _subborrow_u64(borrow, a[i], b[i], &diff);
+        r[i] = diff;
+    }
+    return borrow;
+}
+
+/**
+ * Subtracts two limb arrays: r = a - b, where a is at least as long as b (a_n >= b_n).
+ * r has to hold a_n limbs and may be the same array as a or b.
+ * @return The borrow out of the most significant limb (0 or 1).
+ */
+uint64_t limb_sub(uint64_t *r, const uint64_t *a, size_t a_n, const uint64_t *b, size_t b_n) {
+    unsigned char borrow = limb_sub_n(r, a, b, b_n);
+
+    size_t i = b_n;
+    // propagate the borrow through the remaining limbs of a
+    for (; borrow && i < a_n; i++) {
+        unsigned long long diff;
+        borrow = _subborrow_u64(borrow, a[i], 0, &diff);
+        r[i] = diff;
+    }
+    // the remaining limbs are unchanged
+    if (r != a && i < a_n) {
+        memcpy(r + i, a + i, (a_n - i) * sizeof(uint64_t));
+    }
+    return borrow;
+}
+
+/**
+ * Multiplies the limb array a with a single limb: r = a * mul.
+ * r may be the same array as a.
+ * @return The most significant limb of the product (which does not fit into n limbs).
+ */
+uint64_t limb_mul_1(uint64_t *r, const uint64_t *a, size_t n, uint64_t mul) {
+    uint64_t carry = 0;
+    for (size_t i = 0; i < n; i++) {
+        uint128_t prod = (uint128_t) a[i] * mul + carry;
+        r[i] = (uint64_t) prod;
+        carry = (uint64_t) (prod >> 64);
+    }
+    return carry;
+}
+
+/**
+ * Multiplies the limb array a with a single limb and adds the product to r: r += a * mul.
+ * @return The most significant limb of the result (which does not fit into n limbs).
+ */
+uint64_t limb_addmul_1(uint64_t *r, const uint64_t *a, size_t n, uint64_t mul) {
+    uint64_t carry = 0;
+    for (size_t i = 0; i < n; i++) {
+        // a[i] * mul + r[i] + carry <= (2^64 - 1)^2 + 2 * (2^64 - 1) = 2^128 - 1 never overflows
+        uint128_t prod = (uint128_t) a[i] * mul + r[i] + carry;
+        r[i] = (uint64_t) prod;
+        carry = (uint64_t) (prod >> 64);
+    }
+    return carry;
+}
+
+/**
+ * Multiplies the limb array a with a single limb and subtracts the product from r: r -= a * mul.
+ * @return The limb that has to be subtracted from the limb above r (the borrow of the result).
+ */
+uint64_t limb_submul_1(uint64_t *r, const uint64_t *a, size_t n, uint64_t mul) {
+    uint64_t borrow = 0;
+    for (size_t i = 0; i < n; i++) {
+        uint128_t prod = (uint128_t) a[i] * mul + borrow;
+        uint64_t low = (uint64_t) prod;
+        borrow = (uint64_t) (prod >> 64) + (r[i] < low);
+        r[i] -= low;
+    }
+    return borrow;
+}
+
+/**
+ * Shifts the limb array a to the left by 0 < shift < 64 bits: r = a << shift.
+ * r may be the same array as a.
+ * @return The bits that are shifted out of the most significant limb.
+ */
+uint64_t limb_lshift(uint64_t *r, const uint64_t *a, size_t n, unsigned int shift) {
+    uint64_t out = a[n - 1] >> (64 - shift);
+    for (size_t i = n - 1; i > 0; i--) {
+        r[i] = (a[i] << shift) | (a[i - 1] >> (64 - shift));
+    }
+    r[0] = a[0] << shift;
+    return out;
+}
+
+/**
+ * Shifts the limb array a to the right by 0 < shift < 64 bits: r = a >> shift.
+ * r may be the same array as a.
+ * @return The bits that are shifted out of the least significant limb (in the upper bits).
+ */
+uint64_t limb_rshift(uint64_t *r, const uint64_t *a, size_t n, unsigned int shift) {
+    uint64_t out = a[0] << (64 - shift);
+    for (size_t i = 0; i < n - 1; i++) {
+        r[i] = (a[i] >> shift) | (a[i + 1] << (64 - shift));
+    }
+    r[n - 1] = a[n - 1] >> shift;
+    return out;
+}
+
+/**
+ * Schoolbook multiplication of two limb arrays: r = a * b.
+ * r has to hold a_n + b_n limbs and must not overlap with a or b. a_n and b_n must not be zero.
+ */
+void limb_mul_basecase(uint64_t *r, const uint64_t *a, size_t a_n, const uint64_t *b, size_t b_n) {
+    r[a_n] = limb_mul_1(r, a, a_n, b[0]);
+    for (size_t j = 1; j < b_n; j++) {
+        r[a_n + j] = limb_addmul_1(r + j, a, a_n, b[j]);
+    }
+}
+
+/**
+ * Returns the reciprocal v = floor((B^2 - 1) / d) - B (B = 2^64) of the normalized divisor d (most
+ * significant bit set), which replaces the division instruction in udiv_128_by_64_preinv.
+ */
+static inline uint64_t limb_reciprocal_1(uint64_t d) {
+    uint64_t remainder;
+    // (B^2 - 1) - B * d = (B - 1 - d) * B + (B - 1)
+    return udiv_128_by_64(~d, UINT64_MAX, d, &remainder);
+}
+
+/**
+ * Divides the 128-bit value (hi, lo) by the normalized divisor d with its reciprocal v (see
+ * limb_reciprocal_1) with two multiplications instead of a division instruction (Möller and
+ * Granlund, "Improved division by invariant integers", Algorithm 4). hi has to be less than d.
+ */
+static inline uint64_t udiv_128_by_64_preinv(uint64_t hi, uint64_t lo, uint64_t d, uint64_t v,
+                                             uint64_t *remainder) {
+    uint128_t q = (uint128_t) v * hi + (((uint128_t) (hi + 1) << 64) | lo);
+    uint64_t q1 = (uint64_t) (q >> 64);
+    uint64_t q0 = (uint64_t) q;
+
+    uint64_t r = lo - q1 * d;
+    if (r > q0) {
+        q1--;
+        r += d;
+    }
+    if (r >= d) {
+        q1++;
+        r -= d;
+    }
+
+    *remainder = r;
+    return q1;
+}
+
+/**
+ * Divides the limb array a by a single limb, starting at the most significant limb: q = a / divisor.
+ * The divisor is normalized (shifted so that its most significant bit is set) and every limb is
+ * divided with its precomputed reciprocal, the dividend is shifted on the fly.
+ * q may be the same array as a.
+ * @return The remainder of the division.
+ */
+uint64_t limb_div_1(uint64_t *q, const uint64_t *a, size_t n, uint64_t divisor) {
+    if (divisor == 0) {
+        abort_err("[FATAL] limb_div_1: Division by zero.");
+    }
+    if (n == 0) return 0;
+
+    unsigned int shift = __builtin_clzll(divisor);
+    uint64_t d = divisor << shift;
+    uint64_t v = limb_reciprocal_1(d);
+
+    uint64_t remainder = 0;
+    if (shift == 0) {
+        for (size_t i = n; i > 0; i--) {
+            q[i - 1] = udiv_128_by_64_preinv(remainder, a[i - 1], d, v, &remainder);
+        }
+        return remainder;
+    }
+
+    // the limbs of a * 2^shift
+    remainder = a[n - 1] >> (64 - shift);
+    for (size_t i = n - 1; i > 0; i--) {
+        uint64_t limb = (a[i] << shift) | (a[i - 1] >> (64 - shift));
+        q[i] = udiv_128_by_64_preinv(remainder, limb, d, v, &remainder);
+    }
+    q[0] = udiv_128_by_64_preinv(remainder, a[0] << shift, d, v, &remainder);
+
+    return remainder >> shift;
+}
+
+/**
+ * Compares two limb arrays of the same length, starting at the most significant limb.
+ * @return -1 if a < b, 0 if a == b and 1 if a > b.
+ */
+int limb_cmp_n(const uint64_t *a, const uint64_t *b, size_t n) {
+    for (size_t i = n; i > 0; i--) {
+        if (a[i - 1] != b[i - 1]) {
+            return a[i - 1] > b[i - 1] ? 1 : -1;
+        }
+    }
+    return 0;
+}
+
+/*
+ * =====================================================================
+ * Limb integer arithmetic
+ * =====================================================================
+ */
+
+/**
+ * Shifts the absolute value of the limb_integer to the left by the given number of limbs (in-place):
+ * |value| = |value| * 2^(64 * count).
+ */
+void limb_integer_shift_left_limbs(limb_integer *value, size_t count) {
+    if (value->size == 0 || count == 0) return;
+
+    limb_integer_reserve(value, value->size + count);
+    memmove(value->limbs + count, value->limbs, value->size * sizeof(uint64_t));
+    memset(value->limbs, 0, count * sizeof(uint64_t));
+    value->size += count;
+}
+
+/**
+ * Shifts the absolute value of the limb_integer to the right by the given number of limbs
+ * (in-place): |value| = |value| / 2^(64 * count). The shifted out limbs are discarded.
+ */
+void limb_integer_shift_right_limbs(limb_integer *value, size_t count) {
+    if (count >= value->size) {
+        limb_integer_set_zero(value);
+        return;
+    }
+
+    memmove(value->limbs, value->limbs + count, (value->size - count) * sizeof(uint64_t));
+    value->size -= count;
+}
+
+/**
+ * Compares the absolute values of two limb_integers.
+ * Complexity: Θ(1) if the sizes differ.
+ * @return -1 if |a| < |b|, 0 if |a| == |b| and 1 if |a| > |b|.
+ */
+int limb_integer_compare_magnitude(const limb_integer *a, const limb_integer *b) {
+    if (a->size != b->size) {
+        return a->size > b->size ? 1 : -1;
+    }
+    return limb_cmp_n(a->limbs, b->limbs, a->size);
+}
+
+/**
+ * Calculates a + (-1)^negate_b * b and stores it in result. result may be the same limb_integer as
+ * a or b and grows if necessary.
+ */
+static void limb_integer_add_signed(limb_integer *result, const limb_integer *a,
+                                    const limb_integer *b, bool negate_b) {
+    bool a_sign = a->sign;
+    bool b_sign = b->sign != negate_b;
+
+    if (a_sign == b_sign) {
+        // same signs: add the absolute values, the sign stays
+        // let x be the longer operand
+        const limb_integer *x = a->size >= b->size ? a : b;
+        const limb_integer *y = a->size >= b->size ? b : a;
+        size_t x_size = x->size;
+        size_t y_size = y->size;
+
+        // (reserve may move the limbs of a or b if result is the same limb_integer)
+        limb_integer_reserve(result, x_size + 1);
+        uint64_t carry = limb_add(result->limbs, x->limbs, x_size, y->limbs, y_size);
+
+        result->limbs[x_size] = carry;
+        result->size = x_size + carry;
+        result->sign = a_sign;
+    } else {
+        // different signs: subtract the smaller absolute value from the bigger one, the result
+        // gets the sign of the operand with the bigger absolute value
+        int cmp = limb_integer_compare_magnitude(a, b);
+        if (cmp == 0) {
+            limb_integer_set_zero(result);
+            return;
+        }
+        const limb_integer *x = cmp > 0 ? a : b;
+        const limb_integer *y = cmp > 0 ? b : a;
+        bool sign = cmp > 0 ? a_sign : b_sign;
+        size_t x_size = x->size;
+        size_t y_size = y->size;
+
+        limb_integer_reserve(result, x_size);
+        limb_sub(result->limbs, x->limbs, x_size, y->limbs, y_size);
+
+        result->size = x_size;
+        result->sign = sign;
+        limb_integer_normalize(result);
+    }
+}
+
+/**
+ * Adds two limb_integers: result = a + b.
+ * result may be the same limb_integer as a or b and grows if it is not big enough.
+ */
+void limb_integer_addition(limb_integer *result, const limb_integer *a, const limb_integer *b) {
+    limb_integer_add_signed(result, a, b, false);
+}
+
+/**
+ * Subtracts two limb_integers: result = a - b.
+ * result may be the same limb_integer as a or b and grows if it is not big enough.
+ */
+void limb_integer_subtraction(limb_integer *result, const limb_integer *a, const limb_integer *b) {
+    limb_integer_add_signed(result, a, b, true);
+}
+
+/**
+ * Multiplies two limb_integers: result = a * b.
+ * result may be the same limb_integer as a or b and grows if it is not big enough.
+ * @param subquadratic If true, Karatsuba/Toom-3 multiplication is used for large operands (see
+ * limb_mul), otherwise the schoolbook algorithm.
+ */
+void limb_integer_multiplication(limb_integer *result, const limb_integer *a, const limb_integer *b,
+                                 bool subquadratic) {
+    if (a->size == 0 || b->size == 0) {
+        limb_integer_set_zero(result);
+        return;
+    }
+
+    bool sign = a->sign != b->sign;
+    size_t size = a->size + b->size;
+
+    if (result == a || result == b) {
+        // the product can not be written into one of its factors
+        limb_integer *product = create_limb_integer(size);
+        limb_integer_multiplication(product, a, b, subquadratic);
+
+        // swap the limbs of the product into the result
+        uint64_t *limbs = result->limbs;
+        result->limbs = product->limbs;
+        result->capacity = product->capacity;
+        result->size = product->size;
+        result->sign = product->sign;
+
+        product->limbs = limbs;
+        delete_limb_integer(product);
+        return;
+    }
+
+    limb_integer_reserve(result, size);
+    if (subquadratic) {
+        limb_mul(result->limbs, a->limbs, a->size, b->limbs, b->size);
+    } else {
+        limb_mul_basecase(result->limbs, a->limbs, a->size, b->limbs, b->size);
+    }
+
+    result->size = size;
+    result->sign = sign;
+    limb_integer_normalize(result);
+}
+
+/**
+ * Calculates result = a^exponent with the left-to-right binary exponentiation
+ * (square-and-multiply): Starting with a, the power is squared for every bit of the exponent below
+ * the most significant one and multiplied by a if the bit is set. a^0 is 1.
+ * result must not be the same limb_integer as a, it grows if it is not big enough.
+ * @param subquadratic If true, Karatsuba/Toom-3 multiplication is used for large operands (see
+ * limb_mul), otherwise the schoolbook algorithm.
+ */
+void limb_integer_power(limb_integer *result, const limb_integer *a, uint64_t exponent,
+                        bool subquadratic) {
+    if (exponent == 0) {
+        limb_integer_set_uint64(result, 1);
+        return;
+    }
+
+    copy_limb_integer_value_into_another(a, result);
+
+    // the products are written into temp, then the limbs of temp and result are swapped
+    limb_integer *temp = create_limb_integer(result->capacity);
+    for (int bit = 62 - __builtin_clzll(exponent); bit >= 0; bit--) {
+        limb_integer_multiplication(temp, result, result, subquadratic);
+        limb_integer swap = *result;
+        *result = *temp;
+        *temp = swap;
+
+        if ((exponent >> bit) & 0x1) {
+            limb_integer_multiplication(temp, result, a, subquadratic);
+            swap = *result;
+            *result = *temp;
+            *temp = swap;
+        }
+    }
+    delete_limb_integer(temp);
+}
+
+/**
+ * Adds a signed 64-bit value to the limb_integer (in-place): value += summand.
+ */
+void limb_integer_add_int64(limb_integer *value, int64_t summand) {
+    if (summand == 0) return;
+
+    // the summand as a limb_integer on the stack (no allocation)
+    uint64_t limb = summand < 0 ? -(uint64_t) summand : (uint64_t) summand;
+    limb_integer small = {summand < 0, 1, 1, &limb};
+
+    limb_integer_addition(value, value, &small);
+}
+
+/**
+ * Multiplies the absolute value of the limb_integer with mul and adds add to it (in-place):
+ * |value| = |value| * mul + add. The sign is not changed (unless the value becomes zero).
+ */
+void limb_integer_mul_1_add(limb_integer *value, uint64_t mul, uint64_t add) {
+    size_t size = value->size;
+    limb_integer_reserve(value, size + 1);
+
+    uint64_t *limbs = value->limbs;
+    uint64_t carry = limb_mul_1(limbs, limbs, size, mul);
+
+    // add the summand to the product
+    for (size_t i = 0; add != 0 && i < size; i++) {
+        uint64_t sum = limbs[i] + add;
+        add = sum < add;  // carry of the addition
+        limbs[i] = sum;
+    }
+    // both the carry of the multiplication and the addition end up in the new most significant limb
+    limbs[size] = carry + add;
+    value->size = size + 1;
+
+    limb_integer_normalize(value);
+}
+
+/**
+ * Divides the absolute value of the limb_integer by divisor (in-place): |value| = |value| / divisor.
+ * The sign is not changed (unless the value becomes zero).
+ * @return The remainder of the division of the absolute value.
+ */
+uint64_t limb_integer_div_1(limb_integer *value, uint64_t divisor) {
+    uint64_t remainder = limb_div_1(value->limbs, value->limbs, value->size, divisor);
+    limb_integer_normalize(value);
+    return remainder;
+}
@@ -0,0 +1,69 @@
+#ifndef LIMB_INTEGER_ARITHMETIC_H
+#define LIMB_INTEGER_ARITHMETIC_H
+
+#include "limb_integer.h"
+
+/**
+ * Divides the 128-bit value (hi, lo) by the divisor with the 128/64-bit division instruction.
+ * The quotient must fit into one limb, therefore hi has to be less than the divisor.
+ */
+static inline uint64_t udiv_128_by_64(uint64_t hi, uint64_t lo, uint64_t divisor,
+                                      uint64_t *remainder) {
+    uint64_t quotient;
+    uint64_t rem;
+    __asm__("divq %4" : "=a"(quotient), "=d"(rem) : "a"(lo), "d"(hi), "rm"(divisor));
+    *remainder = rem;
+    return quotient;
+}
+
+/* limb kernels (operate on raw limb arrays, least significant limb first) */
+uint64_t limb_add_n(uint64_t *r, const uint64_t *a, const uint64_t *b, size_t n);
+
+uint64_t limb_add(uint64_t *r, const uint64_t *a, size_t a_n, const uint64_t *b, size_t b_n);
+
+uint64_t limb_sub_n(uint64_t *r, const uint64_t *a, const uint64_t *b, size_t n);
+
+uint64_t limb_sub(uint64_t *r, const uint64_t *a, size_t a_n, const uint64_t *b, size_t b_n);
+
+uint64_t limb_mul_1(uint64_t *r, const uint64_t *a, size_t n, uint64_t mul);
+
+uint64_t limb_addmul_1(uint64_t *r, const uint64_t *a, size_t n, uint64_t mul);
+
+uint64_t limb_submul_1(uint64_t *r, const uint64_t *a, size_t n, uint64_t mul);
+
+uint64_t limb_lshift(uint64_t *r, const uint64_t *a, size_t n, unsigned int shift);
+
+uint64_t limb_rshift(uint64_t *r, const uint64_t *a, size_t n, unsigned int shift);
+
+void limb_mul_basecase(uint64_t *r, const uint64_t *a, size_t a_n, const uint64_t *b, size_t b_n);
+
+uint64_t limb_div_1(uint64_t *q, const uint64_t *a, size_t n, uint64_t divisor);
+
+int limb_cmp_n(const uint64_t *a, const uint64_t *b, size_t n);
+
+/* arithmetic */
+void limb_integer_addition(limb_integer *result, const limb_integer *a, const limb_integer *b);
+
+void limb_integer_subtraction(limb_integer *result, const limb_integer *a, const limb_integer *b);
+
+void limb_integer_multiplication(limb_integer *result, const limb_integer *a, const limb_integer *b,
+                                 bool subquadratic);
+
+void limb_integer_power(limb_integer *result, const limb_integer *a, uint64_t exponent,
+                        bool subquadratic);
+
+void limb_integer_add_int64(limb_integer *value, int64_t summand);
+
+void limb_integer_mul_1_add(limb_integer *value, uint64_t mul, uint64_t add);
+
+uint64_t limb_integer_div_1(limb_integer *value, uint64_t divisor);
+
+/* shifts */
+void limb_integer_shift_left_limbs(limb_integer *value, size_t count);
+
+void limb_integer_shift_right_limbs(limb_integer *value, size_t count);
+
+/* comparison */
+int limb_integer_compare_magnitude(const limb_integer *a, const limb_integer *b);
+
+#endif
@@ -0,0 +1,405 @@
+#include "limb_multiplication.h"
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../util.h"
+#include "../thread_pool.h"
+#include "limb_integer.h"
+#include "limb_integer_arithmetic.h"
+
+/*
+ *
+ * This file contains the subquadratic multiplication engine of the limb implementation:
+ *  - schoolbook multiplication (limb_mul_basecase) below limb_karatsuba_threshold limbs
+ *  - Karatsuba multiplication below limb_toom3_threshold limbs
+ *  - Toom-3 (Toom-Cook with 3 parts) multiplication above
+ * Unbalanced operands are multiplied in chunks of the size of the smaller operand.
+ * Big products are split across the threads of the thread pool: the five pointwise products of
+ * Toom-3 and the slices of unbalanced operands are calculated in parallel.
+ *
+ */
+
+/**
+ * Operands with fewer limbs than this threshold are multiplied with the schoolbook algorithm.
+ */
+size_t limb_karatsuba_threshold = 32;
+
+/**
+ * Operands with at least as many limbs as this threshold are multiplied with Toom-3.
+ */
+size_t limb_toom3_threshold = 192;
+
+/**
+ * Operations on at least this many limbs are split across threads (if there is more than one).
+ */
+size_t limb_parallel_threshold = 1024;
+
+bool limb_split_across_threads(size_t limbs) {
+    return limbs >= limb_parallel_threshold && thread_pool_threads() > 1;
+}
+
+/**
+ * Returns the effective Karatsuba threshold. Karatsuba needs at least 2 limbs to split.
+ */
+static size_t karatsuba_threshold() {
+    return limb_karatsuba_threshold < 2 ? 2 : limb_karatsuba_threshold;
+}
+
+/**
+ * Returns the effective Toom-3 threshold. Toom-3 needs at least 5 limbs so that every one of the
+ * three parts is non-empty.
+ */
+static size_t toom3_threshold() { return limb_toom3_threshold < 5 ? 5 : limb_toom3_threshold; }
+
+/**
+ * Returns the number of scratch limbs that the (recursive) Karatsuba multiplication of two n-limb
+ * operands needs.
+ */
+static size_t karatsuba_scratch_size(size_t n) {
+    size_t size = 0;
+    while (n >= karatsuba_threshold() && n < toom3_threshold()) {
+        size_t h = n - n / 2;
+        // |a0 - a1|, |b0 - b1|, their product and the middle coefficient
+        size += 6 * h + 1;
+        n = h;
+    }
+    return size;
+}
+
+/**
+ * Calculates r = |a - b| where a is at least as long as b (a_n >= b_n). r has to hold a_n limbs.
+ * @return True if a < b (the difference is negative).
+ */
+static bool limb_abs_diff(uint64_t *r, const uint64_t *a, size_t a_n, const uint64_t *b,
+                          size_t b_n) {
+    // a is bigger if any of its limbs above b_n is not zero
+    size_t i = a_n;
+    while (i > b_n && a[i - 1] == 0) {
+        i--;
+    }
+    int cmp = i > b_n ? 1 : limb_cmp_n(a, b, b_n);
+
+    if (cmp >= 0) {
+        limb_sub(r, a, a_n, b, b_n);
+        return false;
+    }
+
+    // the limbs of a above b_n are zero
+    limb_sub_n(r, b, a, b_n);
+    memset(r + b_n, 0, (a_n - b_n) * sizeof(uint64_t));
+    return true;
+}
+
+static void limb_mul_n(uint64_t *r, const uint64_t *a, const uint64_t *b, size_t n,
+                       uint64_t *scratch);
+
+/**
+ * Karatsuba multiplication of two n-limb operands: r = a * b.
+ *
+ * With a = a1 * B^h + a0 and b = b1 * B^h + b0 (B = 2^64) the product is
+ * z2 * B^2h + z1 * B^h + z0 with z0 = a0 * b0, z2 = a1 * b1 and
+ * z1 = a0 * b1 + a1 * b0 = z0 + z2 - (a0 - a1) * (b0 - b1), so only three half-sized products are
+ * needed.
+ *
+ * @param r The result, has to hold 2n limbs and must not overlap with a or b.
+ * @param scratch At least karatsuba_scratch_size(n) limbs of temporary memory.
+ */
+static void limb_mul_karatsuba(uint64_t *r, const uint64_t *a, const uint64_t *b, size_t n,
+                               uint64_t *scratch) {
+    size_t h = n - n / 2;  // limbs of the lower halves a0, b0
+    size_t l = n - h;      // limbs of the upper halves a1, b1 (l <= h)
+
+    const uint64_t *a0 = a;
+    const uint64_t *a1 = a + h;
+    const uint64_t *b0 = b;
+    const uint64_t *b1 = b + h;
+
+    uint64_t *da = scratch;     // |a0 - a1|          (h limbs)
+    uint64_t *db = da + h;      // |b0 - b1|          (h limbs)
+    uint64_t *t = db + h;       // |a0 - a1| * |b0 - b1| (2h limbs)
+    uint64_t *m = t + 2 * h;    // middle coefficient z1 (2h + 1 limbs)
+    uint64_t *next = m + 2 * h + 1;
+
+    bool da_negative = limb_abs_diff(da, a0, h, a1, l);
+    bool db_negative = limb_abs_diff(db, b0, h, b1, l);
+
+    limb_mul_n(t, da, db, h, next);
+    limb_mul_n(r, a0, b0, h, next);          // z0
+    limb_mul_n(r + 2 * h, a1, b1, l, next);  // z2
+
+    // z1 = z0 + z2 - (a0 - a1) * (b0 - b1)
+    m[2 * h] = limb_add(m, r, 2 * h, r + 2 * h, 2 * l);
+    if (da_negative == db_negative) {
+        limb_sub(m, m, 2 * h + 1, t, 2 * h);
+    } else {
+        limb_add(m, m, 2 * h + 1, t, 2 * h);
+    }
+
+    // r += z1 * B^h (z1 < 2 * B^n fits into n + 1 limbs)
+    limb_add(r + h, r + h, 2 * n - h, m, n + 1);
+}
+
+/**
+ * Returns a read-only limb_integer that refers to the given limbs (no allocation).
+ */
+static limb_integer limb_integer_view(const uint64_t *limbs, size_t n) {
+    limb_integer view = {false, n, n, (uint64_t *) limbs};
+    limb_integer_normalize(&view);
+    return view;
+}
+
+/**
+ * Adds the non-negative limb_integer x to the limb array r at the given limb offset:
+ * r += x * B^offset. The sum has to fit into r_n limbs.
+ */
+static void limb_add_at(uint64_t *r, size_t r_n, size_t offset, const limb_integer *x) {
+    if (x->size == 0) return;
+    limb_add(r + offset, r + offset, r_n - offset, x->limbs, x->size);
+}
+
+/**
+ * Evaluates the polynomial x2 * t^2 + x1 * t + x0 at t = 1, t = -1 and t = -2.
+ */
+static void toom3_evaluate(const limb_integer *x0, const limb_integer *x1, const limb_integer *x2,
+                           limb_integer *p1, limb_integer *pm1, limb_integer *pm2) {
+    // p(1) = x0 + x1 + x2, p(-1) = x0 - x1 + x2
+    limb_integer_addition(pm1, x0, x2);
+    limb_integer_addition(p1, pm1, x1);
+    limb_integer_subtraction(pm1, pm1, x1);
+
+    // p(-2) = x0 - 2 * x1 + 4 * x2 = 2 * (p(-1) + x2) - x0
+    limb_integer_addition(pm2, pm1, x2);
+    limb_integer_mul_1_add(pm2, 2, 0);
+    limb_integer_subtraction(pm2, pm2, x0);
+}
+
+/**
+ * The pointwise products of Toom-3: results[i] = a[i] * b[i].
+ */
+typedef struct toom3_products {
+    limb_integer *results[5];
+    const limb_integer *a[5];
+    const limb_integer *b[5];
+} toom3_products;
+
+static void toom3_multiply(void *context, size_t i) {
+    toom3_products *products = context;
+    limb_integer_multiplication(products->results[i], products->a[i], products->b[i], true);
+}
+
+/**
+ * Toom-3 multiplication of two n-limb operands: r = a * b.
+ *
+ * The operands are split into three parts (a = a2 * B^2k + a1 * B^k + a0) and seen as polynomials
+ * in B^k. The product polynomial is evaluated at the points 0, 1, -1, -2 and infinity (five
+ * recursive products of about a third of the size) and interpolated with Bodrato's sequence.
+ *
+ * @param r The result, has to hold 2n limbs and must not overlap with a or b.
+ */
+static void limb_mul_toom3(uint64_t *r, const uint64_t *a, const uint64_t *b, size_t n) {
+    size_t k = (n + 2) / 3;
+
+    limb_integer a0 = limb_integer_view(a, k);
+    limb_integer a1 = limb_integer_view(a + k, k);
+    limb_integer a2 = limb_integer_view(a + 2 * k, n - 2 * k);
+    limb_integer b0 = limb_integer_view(b, k);
+    limb_integer b1 = limb_integer_view(b + k, k);
+    limb_integer b2 = limb_integer_view(b + 2 * k, n - 2 * k);
+
+    // evaluation
+    limb_integer *p1 = create_limb_integer(k + 1);
+    limb_integer *pm1 = create_limb_integer(k + 1);
+    limb_integer *pm2 = create_limb_integer(k + 1);
+    limb_integer *q1 = create_limb_integer(k + 1);
+    limb_integer *qm1 = create_limb_integer(k + 1);
+    limb_integer *qm2 = create_limb_integer(k + 1);
+
+    toom3_evaluate(&a0, &a1, &a2, p1, pm1, pm2);
+    toom3_evaluate(&b0, &b1, &b2, q1, qm1, qm2);
+
+    // pointwise multiplication
+    limb_integer *r0 = create_limb_integer(2 * k);
+    limb_integer *r1 = create_limb_integer(2 * k + 2);
+    limb_integer *rm1 = create_limb_integer(2 * k + 2);
+    limb_integer *rm2 = create_limb_integer(2 * k + 2);
+    limb_integer *rinf = create_limb_integer(2 * k);
+
+    toom3_products products = {
+            {r0, r1, rm1, rm2, rinf}, {&a0, p1, pm1, pm2, &a2}, {&b0, q1, qm1, qm2, &b2}};
+    if (limb_split_across_threads(n)) {
+        thread_pool_run(5, toom3_multiply, &products);
+    } else {
+        for (size_t i = 0; i < 5; i++) {
+            toom3_multiply(&products, i);
+        }
+    }
+
+    // interpolation (all divisions are exact)
+    // r3 = (r(-2) - r(1)) / 3           (stored in rm2)
+    limb_integer_subtraction(rm2, rm2, r1);
+    limb_integer_div_1(rm2, 3);
+    // r1 = (r(1) - r(-1)) / 2           (stored in r1)
+    limb_integer_subtraction(r1, r1, rm1);
+    limb_integer_div_1(r1, 2);
+    // r2 = r(-1) - r(0)                 (stored in rm1)
+    limb_integer_subtraction(rm1, rm1, r0);
+    // r3 = (r2 - r3) / 2 + 2 * r(inf)
+    limb_integer_subtraction(rm2, rm1, rm2);
+    limb_integer_div_1(rm2, 2);
+    limb_integer_addition(rm2, rm2, rinf);
+    limb_integer_addition(rm2, rm2, rinf);
+    // r2 = r2 + r1 - r(inf)
+    limb_integer_addition(rm1, rm1, r1);
+    limb_integer_subtraction(rm1, rm1, rinf);
+    // r1 = r1 - r3
+    limb_integer_subtraction(r1, r1, rm2);
+
+    // recomposition: r = r0 + r1 * B^k + r2 * B^2k + r3 * B^3k + r(inf) * B^4k
+    memset(r, 0, 2 * n * sizeof(uint64_t));
+    limb_add_at(r, 2 * n, 0, r0);
+    limb_add_at(r, 2 * n, k, r1);
+    limb_add_at(r, 2 * n, 2 * k, rm1);
+    limb_add_at(r, 2 * n, 3 * k, rm2);
+    limb_add_at(r, 2 * n, 4 * k, rinf);
+
+    delete_limb_integer(p1);
+    delete_limb_integer(pm1);
+    delete_limb_integer(pm2);
+    delete_limb_integer(q1);
+    delete_limb_integer(qm1);
+    delete_limb_integer(qm2);
+    delete_limb_integer(r0);
+    delete_limb_integer(r1);
+    delete_limb_integer(rm1);
+    delete_limb_integer(rm2);
+    delete_limb_integer(rinf);
+}
+
+/**
+ * Multiplies two n-limb operands with the algorithm that fits the size: r = a * b.
+ * @param r The result, has to hold 2n limbs and must not overlap with a or b.
+ * @param scratch At least karatsuba_scratch_size(n) limbs of temporary memory.
+ */
+static void limb_mul_n(uint64_t *r, const uint64_t *a, const uint64_t *b, size_t n,
+                       uint64_t *scratch) {
+    if (n < karatsuba_threshold()) {
+        limb_mul_basecase(r, a, n, b, n);
+    } else if (n >= toom3_threshold()) {
+        limb_mul_toom3(r, a, b, n);
+    } else {
+        limb_mul_karatsuba(r, a, b, n, scratch);
+    }
+}
+
+/**
+ * The slices of the longer operand a that are multiplied with b in parallel:
+ * products[i] = a[i * slice, (i + 1) * slice) * b.
+ */
+typedef struct limb_mul_slices {
+    const uint64_t *a;
+    size_t a_n;
+    const uint64_t *b;
+    size_t b_n;
+    size_t slice;
+    uint64_t **products;
+} limb_mul_slices;
+
+static size_t slice_length(const limb_mul_slices *slices, size_t i) {
+    size_t offset = i * slices->slice;
+    return slices->a_n - offset < slices->slice ? slices->a_n - offset : slices->slice;
+}
+
+static void multiply_slice(void *context, size_t i) {
+    limb_mul_slices *slices = context;
+    limb_mul(slices->products[i], slices->a + i * slices->slice, slice_length(slices, i), slices->b,
+             slices->b_n);
+}
+
+/**
+ * Multiplies unbalanced operands (a_n >= 2 * b_n) by splitting a into one slice per thread. The
+ * slice products are calculated in parallel and added up with a final carry pass.
+ */
+static void limb_mul_parallel(uint64_t *r, const uint64_t *a, size_t a_n, const uint64_t *b,
+                              size_t b_n) {
+    size_t count = thread_pool_threads();
+    if (count > a_n / b_n) count = a_n / b_n;
+
+    limb_mul_slices slices = {a, a_n, b, b_n, (a_n + count - 1) / count, NULL};
+    count = (a_n + slices.slice - 1) / slices.slice;
+    slices.products = malloc(count * sizeof(uint64_t *));
+    check_alloc(slices.products, count * sizeof(uint64_t *), "slice products");
+    for (size_t i = 0; i < count; i++) {
+        size_t size = (slice_length(&slices, i) + b_n) * sizeof(uint64_t);
+        slices.products[i] = malloc(size);
+        check_alloc(slices.products[i], size, "slice product");
+    }
+
+    thread_pool_run(count, multiply_slice, &slices);
+
+    memset(r, 0, (a_n + b_n) * sizeof(uint64_t));
+    for (size_t i = 0; i < count; i++) {
+        size_t offset = i * slices.slice;
+        limb_add(r + offset, r + offset, a_n + b_n - offset, slices.products[i],
+                 slice_length(&slices, i) + b_n);
+        free(slices.products[i]);
+    }
+    free(slices.products);
+}
+
+/**
+ * Multiplies two limb arrays: r = a * b. Depending on the size of the operands, the schoolbook,
+ * Karatsuba or Toom-3 algorithm is used.
+ * r has to hold a_n + b_n limbs and must not overlap with a or b. a_n and b_n must not be zero.
+ */
+void limb_mul(uint64_t *r, const uint64_t *a, size_t a_n, const uint64_t *b, size_t b_n) {
+    // let a be the longer operand
+    if (a_n < b_n) {
+        const uint64_t *tmp = a;
+        a = b;
+        b = tmp;
+        size_t tmp_n = a_n;
+        a_n = b_n;
+        b_n = tmp_n;
+    }
+
+    if (a_n >= 2 * b_n && limb_split_across_threads(a_n)) {
+        limb_mul_parallel(r, a, a_n, b, b_n);
+        return;
+    }
+
+    if (b_n < karatsuba_threshold()) {
+        limb_mul_basecase(r, a, a_n, b, b_n);
+        return;
+    }
+
+    size_t scratch_size = karatsuba_scratch_size(b_n) + 1;
+    uint64_t *scratch = malloc(scratch_size * sizeof(uint64_t));
+    check_alloc(scratch, scratch_size * sizeof(uint64_t), "multiplication scratch memory");
+
+    // the first (or only) b_n limbs of a
+    limb_mul_n(r, a, b, b_n, scratch);
+
+    if (a_n > b_n) {
+        // unbalanced operands: multiply b with the remaining chunks of b_n limbs of a
+        uint64_t *t = malloc(2 * b_n * sizeof(uint64_t));
+        check_alloc(t, 2 * b_n * sizeof(uint64_t), "multiplication chunk product");
+
+        for (size_t offset = b_n; offset < a_n; offset += b_n) {
+            size_t chunk = a_n - offset < b_n ? a_n - offset : b_n;
+            if (chunk == b_n) {
+                limb_mul_n(t, a + offset, b, b_n, scratch);
+            } else {
+                limb_mul(t, b, b_n, a + offset, chunk);
+            }
+
+            // r[offset, offset + b_n) holds the upper limbs of the previous chunk products
+            limb_add(r + offset, t, chunk + b_n, r + offset, b_n);
+        }
+
+        free(t);
+    }
+
+    free(scratch);
+}
@@ -0,0 +1,21 @@
+#ifndef LIMB_MULTIPLICATION_H
+#define LIMB_MULTIPLICATION_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* tunable thresholds (in limbs) of the subquadratic multiplication */
+extern size_t limb_karatsuba_threshold;
+
+extern size_t limb_toom3_threshold;
+
+/* operations on at least this many limbs are split across the threads of the thread pool */
+extern size_t limb_parallel_threshold;
+
+bool limb_split_across_threads(size_t limbs);
+
+/* multiplication */
+void limb_mul(uint64_t *r, const uint64_t *a, size_t a_n, const uint64_t *b, size_t b_n);
+
+#endif
@@ -0,0 +1,136 @@
+#include "limb_powers.h"
+
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../util.h"
+#include "limb_division.h"
+#include "limb_integer_arithmetic.h"
+
+/*
+ *
+ * This file contains the power table of the limb implementation: the powers
+ * base^(digits_per_limb * 2^i) that the divide-and-conquer conversions split the numbers at. The
+ * number systems use one table per base that is shared by all threads, so the powers are only
+ * computed once per process.
+ *
+ */
+
+/* the shared tables, indexed by the base (created at the first use) */
+static limb_power_table *_Atomic shared_tables[LIMB_SHARED_POWER_TABLE_MAX_BASE + 1];
+static pthread_mutex_t shared_tables_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * Creates the power table of the given base (|base| > 1). Only limb_base^1 is computed right away.
+ * @return The pointer to the created table. Make sure to free it with delete_limb_power_table.
+ */
+limb_power_table *create_limb_power_table(uint64_t base) {
+    limb_power_table *table = malloc(sizeof(limb_power_table));
+    check_alloc(table, sizeof(limb_power_table), "limb_power_table");
+
+    // the biggest power of the base that fits into a limb
+    table->base = base;
+    table->digits_per_limb = 1;
+    table->limb_base = base;
+    while (table->limb_base <= UINT64_MAX / base) {
+        table->limb_base *= base;
+        table->digits_per_limb++;
+    }
+
+    for (size_t i = 0; i < LIMB_POWER_TABLE_CAPACITY; i++) {
+        atomic_init(&table->powers[i], NULL);
+        atomic_init(&table->inverses[i], NULL);
+    }
+    pthread_mutex_init(&table->lock, NULL);
+
+    limb_integer *power = create_limb_integer(1);
+    limb_integer_set_uint64(power, table->limb_base);
+    atomic_init(&table->powers[0], power);
+    atomic_init(&table->count, 1);
+
+    return table;
+}
+
+limb_power_table *get_shared_limb_power_table(uint64_t base) {
+    if (base > LIMB_SHARED_POWER_TABLE_MAX_BASE) {
+        abort_err("There is no shared power table of the base %" PRIu64 ".\n", base);
+    }
+
+    limb_power_table *table = atomic_load_explicit(&shared_tables[base], memory_order_acquire);
+    if (table != NULL) return table;
+
+    pthread_mutex_lock(&shared_tables_lock);
+    table = atomic_load_explicit(&shared_tables[base], memory_order_relaxed);
+    if (table == NULL) {
+        table = create_limb_power_table(base);
+        atomic_store_explicit(&shared_tables[base], table, memory_order_release);
+    }
+    pthread_mutex_unlock(&shared_tables_lock);
+
+    return table;
+}
+
+/**
+ * Returns limb_base^(2^i) and computes all missing powers up to it.
+ */
+const limb_integer *limb_power_table_get(limb_power_table *table, size_t i) {
+    // the powers below count are complete and never change
+    if (i < atomic_load_explicit(&table->count, memory_order_acquire)) {
+        return atomic_load_explicit(&table->powers[i], memory_order_relaxed);
+    }
+    if (i >= LIMB_POWER_TABLE_CAPACITY) {
+        abort_err("The power limb_base^(2^%zu) is too big for the power table.\n", i);
+    }
+
+    pthread_mutex_lock(&table->lock);
+    size_t count = atomic_load_explicit(&table->count, memory_order_relaxed);
+    for (; count <= i; count++) {
+        const limb_integer *previous =
+                atomic_load_explicit(&table->powers[count - 1], memory_order_relaxed);
+        limb_integer *power = create_limb_integer(2 * previous->size);
+        limb_integer_multiplication(power, previous, previous, true);
+
+        atomic_store_explicit(&table->powers[count], power, memory_order_relaxed);
+        atomic_store_explicit(&table->count, count + 1, memory_order_release);
+    }
+    pthread_mutex_unlock(&table->lock);
+
+    return atomic_load_explicit(&table->powers[i], memory_order_relaxed);
+}
+
+/**
+ * Returns the reciprocal floor(B^2n / limb_base^(2^i)) (n limbs of the power, B = 2^64) and computes
+ * it if it is missing.
+ */
+const limb_integer *limb_power_table_get_inverse(limb_power_table *table, size_t i) {
+    const limb_integer *power = limb_power_table_get(table, i);
+
+    limb_integer *inverse = atomic_load_explicit(&table->inverses[i], memory_order_acquire);
+    if (inverse != NULL) return inverse;
+
+    pthread_mutex_lock(&table->lock);
+    inverse = atomic_load_explicit(&table->inverses[i], memory_order_relaxed);
+    if (inverse == NULL) {
+        inverse = create_limb_integer(power->size + 2);
+        limb_integer_reciprocal(inverse, power);
+        atomic_store_explicit(&table->inverses[i], inverse, memory_order_release);
+    }
+    pthread_mutex_unlock(&table->lock);
+
+    return inverse;
+}
+
+/**
+ * Frees the power table and all of its powers.
+ */
+void delete_limb_power_table(limb_power_table *table) {
+    size_t count = atomic_load(&table->count);
+    for (size_t i = 0; i < count; i++) {
+        delete_limb_integer(atomic_load(&table->powers[i]));
+        limb_integer *inverse = atomic_load(&table->inverses[i]);
+        if (inverse != NULL) delete_limb_integer(inverse);
+    }
+    pthread_mutex_destroy(&table->lock);
+    free(table);
+}
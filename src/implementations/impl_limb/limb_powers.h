@@ -0,0 +1,56 @@
+#ifndef LIMB_POWERS_H
+#define LIMB_POWERS_H
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "limb_integer.h"
+
+/* greatest base that has a shared table (the greatest absolute value of a base) */
+#define LIMB_SHARED_POWER_TABLE_MAX_BASE 256
+
+/* number of powers limb_base^(2^i) a table can hold (limb_base^(2^47) has over 2^49 bytes) */
+#define LIMB_POWER_TABLE_CAPACITY 48
+
+/**
+ * Table of the powers of a base that are needed by the divide-and-conquer conversions.
+ * limb_base = base^digits_per_limb is the biggest power of the base that fits into one limb and
+ * powers[i] = limb_base^(2^i). The powers are computed lazily (by squaring) when they are needed,
+ * inverses[i] is the reciprocal of powers[i] for the Barrett division (NULL until it is needed).
+ * The table can be used by several threads at once: computed powers never change, missing ones are
+ * computed under the lock of the table. Tasks of the thread pool must only get powers that were
+ * computed before they were started (a caller that waits for its tasks may run them while it holds
+ * the lock).
+ */
+typedef struct limb_power_table {
+    uint64_t base;
+    size_t digits_per_limb;
+    uint64_t limb_base;
+    atomic_size_t count;
+    limb_integer *_Atomic powers[LIMB_POWER_TABLE_CAPACITY];
+    limb_integer *_Atomic inverses[LIMB_POWER_TABLE_CAPACITY];
+    pthread_mutex_t lock;
+} limb_power_table;
+
+limb_power_table *create_limb_power_table(uint64_t base);
+
+/**
+ * @brief Get the power table of the base that is shared by all threads of the process
+ *
+ * The table is created at the first call with the base and kept until the process exits, so all
+ * number systems of the base (of any alphabet and sign) reuse the powers of earlier operations.
+ *
+ * @param base  The base       1 < base <= LIMB_SHARED_POWER_TABLE_MAX_BASE
+ * @return      The power table, it must not be deleted
+ */
+limb_power_table *get_shared_limb_power_table(uint64_t base);
+
+const limb_integer *limb_power_table_get(limb_power_table *table, size_t i);
+
+const limb_integer *limb_power_table_get_inverse(limb_power_table *table, size_t i);
+
+void delete_limb_power_table(limb_power_table *table);
+
+#endif
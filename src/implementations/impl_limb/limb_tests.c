@@ -0,0 +1,625 @@
+#include "limb_tests.h"
+
+#include <limits.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../test.h"
+#include "../../util.h"
+#include "../common.h"
+#include "impl_limb.h"
+#include "limb_division.h"
+#include "limb_integer.h"
+#include "limb_integer_arithmetic.h"
+#include "limb_multiplication.h"
+
+/**
+ * All functions run a couple of tests that test a single component function of the limb
+ * implementation.
+ */
+
+#define MAX_LIMBS 4
+
+typedef struct Testcase_limb_arithmetic {
+    size_t len_a;
+    uint64_t a[MAX_LIMBS];
+    bool sign_a;
+
+    size_t len_b;
+    uint64_t b[MAX_LIMBS];
+    bool sign_b;
+
+    char op;
+
+    size_t len_exp;
+    uint64_t exp[2 * MAX_LIMBS];
+    bool sign_exp;
+} Testcase_limb_arithmetic;
+
+bool test_limb_arithmetic_executor(bool *subquadratic, Testcase_limb_arithmetic *t) {
+    limb_integer *a = create_limb_integer_of_limbs(t->len_a, t->a, t->sign_a);
+    limb_integer *b = create_limb_integer_of_limbs(t->len_b, t->b, t->sign_b);
+    limb_integer *expected = create_limb_integer_of_limbs(t->len_exp, t->exp, t->sign_exp);
+
+    // the result is written into a new limb_integer that has to grow and into the first operand
+    limb_integer *result = create_limb_integer(1);
+
+    switch (t->op) {
+        case '+':
+            limb_integer_addition(result, a, b);
+            limb_integer_addition(a, a, b);
+            break;
+        case '-':
+            limb_integer_subtraction(result, a, b);
+            limb_integer_subtraction(a, a, b);
+            break;
+        case '*':
+            limb_integer_multiplication(result, a, b, *subquadratic);
+            limb_integer_multiplication(a, a, b, *subquadratic);
+            break;
+        default:
+            abort_err("No valid operation specified.\n");
+    }
+
+    bool success = limb_integer_is_equal(result, expected) && limb_integer_is_equal(a, expected);
+
+    delete_limb_integer(a);
+    delete_limb_integer(b);
+    delete_limb_integer(expected);
+    delete_limb_integer(result);
+
+    return success;
+}
+
+/**
+ * Tests the limb_integer arithmetic functions (addition, subtraction, multiplication).
+ */
+void test_limb_arithmetic(bool subquadratic, Implementation impl) {
+    TestResult tr = test_init_impl(impl, "arithmetic on limb_integers");
+
+    const uint64_t MAX = UINT64_MAX;
+
+    Testcase_limb_arithmetic test_cases[] = {
+            // addition
+            // 5 + 5 = 10
+            {1, {5}, false, 1, {5}, false, '+', 1, {10}, false},
+            // (2^64 - 1) + 1 = 2^64
+            {1, {MAX}, false, 1, {1}, false, '+', 2, {0, 1}, false},
+            // (2^128 - 1) + 1 = 2^128 (carry through all limbs)
+            {2, {MAX, MAX}, false, 1, {1}, false, '+', 3, {0, 0, 1}, false},
+            // -20 + 36 = 16
+            {1, {20}, true, 1, {36}, false, '+', 1, {16}, false},
+            // -(2^64) + (-(2^64 - 1)) = -(2^65 - 1)
+            {2, {0, 1}, true, 1, {MAX}, true, '+', 2, {MAX, 1}, true},
+            // 2^64 + (-1) = 2^64 - 1 (borrow through a limb)
+            {2, {0, 1}, false, 1, {1}, true, '+', 1, {MAX}, false},
+            // 100 + 0 = 100
+            {1, {100}, false, 0, {0}, false, '+', 1, {100}, false},
+
+            // subtraction
+            // 7 - 10 = -3
+            {1, {7}, false, 1, {10}, false, '-', 1, {3}, true},
+            // -7 - 10 = -17
+            {1, {7}, true, 1, {10}, false, '-', 1, {17}, true},
+            // 7 - (-10) = 17
+            {1, {7}, false, 1, {10}, true, '-', 1, {17}, false},
+            // -7 - (-10) = 3
+            {1, {7}, true, 1, {10}, true, '-', 1, {3}, false},
+            // 2^128 - 1 = 2^128 - 1
+            {3, {0, 0, 1}, false, 1, {1}, false, '-', 2, {MAX, MAX}, false},
+            // 1 - 2^128 = -(2^128 - 1)
+            {1, {1}, false, 3, {0, 0, 1}, false, '-', 2, {MAX, MAX}, true},
+            // x - x = 0
+            {2, {123, 456}, true, 2, {123, 456}, true, '-', 0, {0}, false},
+
+            // multiplication
+            // 25 * 0 = 0
+            {1, {25}, false, 0, {0}, false, '*', 0, {0}, false},
+            // 42 * (-1) = -42
+            {1, {42}, false, 1, {1}, true, '*', 1, {42}, true},
+            // -14 * (-8) = 112
+            {1, {14}, true, 1, {8}, true, '*', 1, {112}, false},
+            // (2^64 - 1)^2 = 2^128 - 2^65 + 1
+            {1, {MAX}, false, 1, {MAX}, false, '*', 2, {1, MAX - 1}, false},
+            // (2^192 - 1) * (2^64 - 1) = 2^256 - 2^192 - 2^64 + 1
+            {3, {MAX, MAX, MAX}, false, 1, {MAX}, false, '*', 4, {1, MAX, MAX, MAX - 1}, false},
+            // multi-limb factors
+            {3,
+             {0x0F1E2D3C4B5A6978, 0xFEDCBA9876543210, 0x0123456789ABCDEF},
+             false,
+             1,
+             {0xFFFFFFFFFFFFFFFF},
+             true,
+             '*',
+             4,
+             {0xF0E1D2C3B4A59688, 0x104172A3D5063767, 0xFDB97530ECA86420, 0x0123456789ABCDEF},
+             true},
+    };
+
+    int count = sizeof(test_cases) / sizeof(test_cases[0]);
+
+    for (int i = 0; i < count; i++) {
+        test_run_with_env(&subquadratic, &test_cases[i], (void *) test_limb_arithmetic_executor, &tr,
+                          "limb_integer arithmetic testcase %i (%c)", "wrong result", i,
+                          test_cases[i].op);
+    }
+
+    test_finalize(tr);
+}
+
+typedef struct Testcase_limb_conversion {
+    size_t len;
+    uint64_t limbs[MAX_LIMBS];
+    bool sign;
+    int base;
+    const char *expected;
+} Testcase_limb_conversion;
+
+bool test_limb_conversion_executor(char *buffer, Testcase_limb_conversion *t) {
+    const char *alph = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+    number_system *system = create_number_system(t->base, alph);
+
+    // limb_integer -> string
+    limb_integer *value = create_limb_integer_of_limbs(t->len, t->limbs, t->sign);
+    convert_limb_integer_to_any_base(system, value, buffer);
+    bool success = strcmp(buffer, t->expected) == 0;
+
+    // string -> limb_integer
+
+    const char *digits = t->expected;
+    bool negative = t->base > 0 && *digits == '-';
+    if (negative) digits++;
+
+    convert_any_base_to_limb_integer(system, digits, strlen(digits), value);
+    if (negative) value->sign = true;
+
+    limb_integer *expected = create_limb_integer_of_limbs(t->len, t->limbs, t->sign);
+    success = success && limb_integer_is_equal(value, expected);
+
+    delete_limb_integer(value);
+    delete_limb_integer(expected);
+    delete_number_system(system);
+
+    return success;
+}
+
+/**
+ * Tests the conversion of limb_integers to numbers represented in any given base and back.
+ */
+void test_limb_conversion(Implementation impl) {
+    TestResult tr = test_init_impl(impl, "limb_integer conversion from/to any base");
+
+    const uint64_t X[] = {0x0F1E2D3C4B5A6978, 0xFEDCBA9876543210, 0x0123456789ABCDEF};
+
+    Testcase_limb_conversion test_cases[] = {
+            {0, {0}, false, 10, "0"},
+            {1, {12}, false, 10, "12"},
+            {1, {123}, true, 10, "-123"},
+            {1, {0xAFFE}, false, 16, "AFFE"},
+            {1, {15}, false, -2, "10011"},
+            {1, {3}, true, -2, "1101"},
+            {1, {12}, false, -3, "220"},
+            {2, {0, 1}, false, -2, "10000000000000000000000000000000000000000000000000000000000000000"},
+            {2, {0, 1}, true, 16, "-10000000000000000"},
+            {3, {X[0], X[1], X[2]}, false, 10, "27898229935051914480226618602452055723401069111537199480"},
+            {3, {X[0], X[1], X[2]}, true, 10, "-27898229935051914480226618602452055723401069111537199480"},
+            {3, {X[0], X[1], X[2]}, false, -10,
+             "188102370145152126521834799418552065884619130929678801520"},
+            {3, {X[0], X[1], X[2]}, true, -10, "33919830075068095680387422603668156337401071292543200680"},
+            {3, {X[0], X[1], X[2]}, false, 7,
+             "316050261262360501130235512045366626424320434351325413160023654324"},
+    };
+
+    int count = sizeof(test_cases) / sizeof(test_cases[0]);
+
+    char *buffer = malloc(128);
+    check_alloc(buffer, 128, "");
+
+    for (int i = 0; i < count; i++) {
+        test_run_with_env(buffer, &test_cases[i], (void *) test_limb_conversion_executor, &tr,
+                          "conversion to/from base %i -> %s", "got %s", test_cases[i].base,
+                          test_cases[i].expected, buffer);
+    }
+
+    test_finalize(tr);
+
+    free(buffer);
+}
+
+typedef struct Testcase_limb_conversion_long {
+    int base;
+    size_t length;
+    // thresholds of the divide-and-conquer conversions that are used during the test
+    size_t parse_dc_threshold;
+    size_t output_dc_threshold;
+    uint64_t seed;
+} Testcase_limb_conversion_long;
+
+static uint64_t next_random_limb(uint64_t *state);
+
+bool test_limb_conversion_long_executor(Testcase_limb_conversion_long *t) {
+    const char *alph =
+            "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz!#$%&()*+,./:;<=>?@[]^_`{|}~";
+    unsigned int base_abs = abs(t->base);
+
+    // random digits without leading zeroes, so that the round trip gives the same string
+    char *digits = malloc(t->length + 1);
+    check_alloc(digits, t->length + 1, "digits");
+    char *buffer = malloc(t->length + 2);
+    check_alloc(buffer, t->length + 2, "buffer");
+
+    uint64_t state = t->seed;
+    for (size_t i = 0; i < t->length; i++) {
+        digits[i] = alph[next_random_limb(&state) % base_abs];
+    }
+    digits[0] = alph[1 + next_random_limb(&state) % (base_abs - 1)];
+    digits[t->length] = '\0';
+
+    size_t parse_dc_threshold = limb_parse_dc_threshold;
+    size_t output_dc_threshold = limb_output_dc_threshold;
+    limb_parse_dc_threshold = t->parse_dc_threshold;
+    limb_output_dc_threshold = t->output_dc_threshold;
+
+    number_system *system = create_number_system(t->base, alph);
+    limb_integer *value = create_limb_integer(1);
+    convert_any_base_to_limb_integer(system, digits, t->length, value);
+    limb_integer *copy = clone_limb_integer(value);
+    convert_limb_integer_to_any_base(system, value, buffer);
+    bool success = strcmp(buffer, digits) == 0;
+
+    // the divide-and-conquer output has to match the output of the repeated divisions
+    limb_output_dc_threshold = SIZE_MAX;
+    convert_limb_integer_to_any_base(system, copy, buffer);
+    success = success && strcmp(buffer, digits) == 0;
+
+    limb_parse_dc_threshold = parse_dc_threshold;
+    limb_output_dc_threshold = output_dc_threshold;
+
+    delete_limb_integer(value);
+    delete_limb_integer(copy);
+    delete_number_system(system);
+    free(digits);
+    free(buffer);
+
+    return success;
+}
+
+/**
+ * Tests the divide-and-conquer conversion of long numbers into limb_integers (round trip through
+ * the output conversion).
+ */
+void test_limb_conversion_long(Implementation impl) {
+    TestResult tr = test_init_impl(impl, "divide-and-conquer conversion of long numbers");
+
+    Testcase_limb_conversion_long test_cases[] = {
+            {10, 1, 1, 1, 1},       {10, 19, 1, 1, 2},      {10, 20, 1, 1, 3},
+            {10, 39, 1, 1, 4},      {10, 1000, 1, 1, 5},    {10, 1001, 2, 2, 6},
+            {16, 777, 1, 3, 7},     {7, 500, 1, 1, 8},      {2, 1024, 1, 1, 9},
+            {85, 300, 1, 1, 10},    {-2, 1, 1, 1, 11},      {-2, 64, 1, 1, 12},
+            {-2, 1000, 1, 1, 13},   {-3, 999, 1, 1, 14},    {-10, 1000, 1, 1, 15},
+            {-10, 1001, 3, 4, 16},  {-85, 301, 1, 1, 17},   {10, 5000, 32, 32, 18},
+            {-7, 5000, 32, 32, 19}, {10, 20000, 32, 32, 20}, {-16, 20000, 32, 32, 21},
+    };
+
+    int count = sizeof(test_cases) / sizeof(test_cases[0]);
+
+    for (int i = 0; i < count; i++) {
+        test_run(&test_cases[i], (bool (*)(void *)) test_limb_conversion_long_executor, &tr,
+                 "%zu digits in base %i (thresholds %zu, %zu)", "wrong round trip",
+                 test_cases[i].length, test_cases[i].base, test_cases[i].parse_dc_threshold,
+                 test_cases[i].output_dc_threshold);
+    }
+
+    test_finalize(tr);
+}
+
+typedef struct Testcase_limb_shared_powers {
+    int base;
+    size_t levels;   // the powers limb_base^(2^i) with i < levels are checked
+    size_t threads;  // the number of threads that get the powers at the same time
+} Testcase_limb_shared_powers;
+
+static void *get_shared_powers(void *arg) {
+    Testcase_limb_shared_powers *t = arg;
+    limb_power_table *table = get_shared_limb_power_table(abs(t->base));
+    // the powers are requested from the highest one down, so that all threads compute at once
+    for (size_t i = t->levels; i > 0; i--) {
+        limb_power_table_get_inverse(table, i - 1);
+    }
+    return table;
+}
+
+/**
+ * Gets the powers of the shared table from several threads at once and compares them with the
+ * powers of a table of its own. The number systems of the base have to use the shared table.
+ */
+bool test_limb_shared_powers_executor(Testcase_limb_shared_powers *t) {
+    pthread_t *threads = malloc(t->threads * sizeof(pthread_t));
+    check_alloc(threads, t->threads * sizeof(pthread_t), "threads");
+    for (size_t i = 0; i < t->threads; i++) {
+        if (pthread_create(&threads[i], NULL, get_shared_powers, t) != 0) {
+            abort_err("Could not create a thread.\n");
+        }
+    }
+
+    limb_power_table *shared = get_shared_limb_power_table(abs(t->base));
+    bool success = true;
+    for (size_t i = 0; i < t->threads; i++) {
+        void *table;
+        pthread_join(threads[i], &table);
+        success = success && table == shared;
+    }
+    free(threads);
+
+    limb_power_table *own = create_limb_power_table(abs(t->base));
+    for (size_t i = 0; i < t->levels && success; i++) {
+        success = limb_integer_is_equal(limb_power_table_get(shared, i),
+                                        limb_power_table_get(own, i)) &&
+                  limb_integer_is_equal(limb_power_table_get_inverse(shared, i),
+                                        limb_power_table_get_inverse(own, i));
+    }
+    delete_limb_power_table(own);
+
+    // the number systems of both signs and of all alphabets share the table
+    char alph[UCHAR_MAX + 1];
+    for (int i = 0; i < abs(t->base); i++) {
+        alph[i] = (char) ('!' + i);
+    }
+    number_system *system = create_number_system(t->base, alph);
+    number_system *negative = create_number_system(-t->base, alph + 1);
+    success = success && system->powers == shared && negative->powers == shared;
+    delete_number_system(system);
+    delete_number_system(negative);
+
+    return success;
+}
+
+/**
+ * Tests that the shared power tables can be used by several threads at once.
+ */
+void test_limb_shared_powers(Implementation impl) {
+    TestResult tr = test_init_impl(impl, "shared power tables");
+
+    Testcase_limb_shared_powers test_cases[] = {
+            {93, 1, 1}, {91, 6, 2}, {89, 10, 4}, {-87, 10, 8}, {83, 12, 3},
+    };
+
+    int count = sizeof(test_cases) / sizeof(test_cases[0]);
+
+    for (int i = 0; i < count; i++) {
+        test_run(&test_cases[i], (bool (*)(void *)) test_limb_shared_powers_executor, &tr,
+                 "%zu powers of base %i with %zu threads", "wrong powers", test_cases[i].levels,
+                 test_cases[i].base, test_cases[i].threads);
+    }
+
+    test_finalize(tr);
+}
+
+typedef struct Testcase_limb_multiplication {
+    size_t len_a;
+    size_t len_b;
+    // thresholds that are used during the test (to reach deep recursions with small operands)
+    size_t karatsuba_threshold;
+    size_t toom3_threshold;
+    // 0: random limbs, 1: all limbs UINT64_MAX (longest carry chains)
+    int fill;
+    uint64_t seed;
+} Testcase_limb_multiplication;
+
+/**
+ * Returns the next pseudo random limb (splitmix64), so that the tests are reproducible.
+ */
+static uint64_t next_random_limb(uint64_t *state) {
+    uint64_t z = (*state += 0x9E3779B97F4A7C15);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+    return z ^ (z >> 31);
+}
+
+bool test_limb_multiplication_executor(Testcase_limb_multiplication *t) {
+    size_t product_size = (t->len_a + t->len_b) * sizeof(uint64_t);
+
+    uint64_t *a = malloc(t->len_a * sizeof(uint64_t));
+    check_alloc(a, t->len_a * sizeof(uint64_t), "factor a");
+    uint64_t *b = malloc(t->len_b * sizeof(uint64_t));
+    check_alloc(b, t->len_b * sizeof(uint64_t), "factor b");
+    uint64_t *expected = malloc(product_size);
+    check_alloc(expected, product_size, "expected product");
+    uint64_t *actual = malloc(product_size);
+    check_alloc(actual, product_size, "actual product");
+
+    uint64_t state = t->seed;
+    for (size_t i = 0; i < t->len_a; i++) {
+        a[i] = t->fill == 1 ? UINT64_MAX : next_random_limb(&state);
+    }
+    for (size_t i = 0; i < t->len_b; i++) {
+        b[i] = t->fill == 1 ? UINT64_MAX : next_random_limb(&state);
+    }
+
+    size_t karatsuba_threshold = limb_karatsuba_threshold;
+    size_t toom3_threshold = limb_toom3_threshold;
+    limb_karatsuba_threshold = t->karatsuba_threshold;
+    limb_toom3_threshold = t->toom3_threshold;
+
+    limb_mul_basecase(expected, a, t->len_a, b, t->len_b);
+    limb_mul(actual, a, t->len_a, b, t->len_b);
+
+    limb_karatsuba_threshold = karatsuba_threshold;
+    limb_toom3_threshold = toom3_threshold;
+
+    bool success = memcmp(expected, actual, product_size) == 0;
+
+    free(a);
+    free(b);
+    free(expected);
+    free(actual);
+
+    return success;
+}
+
+/**
+ * Tests the subquadratic multiplication (Karatsuba, Toom-3 and unbalanced operands) against the
+ * schoolbook multiplication.
+ */
+void test_limb_multiplication_subquadratic(Implementation impl) {
+    TestResult tr = test_init_impl(impl, "subquadratic limb multiplication");
+
+    const size_t DEFAULT = 0;
+
+    Testcase_limb_multiplication test_cases[] = {
+            // Karatsuba only (odd and even sizes)
+            {2, 2, 2, 1000, 0, 1},
+            {3, 3, 2, 1000, 0, 2},
+            {7, 7, 2, 1000, 0, 3},
+            {64, 64, 4, 1000, 0, 4},
+            {65, 65, 4, 1000, 0, 5},
+            {65, 65, 4, 1000, 1, 0},
+            // Toom-3 (all sizes modulo 3)
+            {5, 5, 2, 5, 0, 6},
+            {9, 9, 4, 5, 0, 7},
+            {10, 10, 4, 5, 0, 8},
+            {11, 11, 4, 5, 0, 9},
+            {100, 100, 4, 8, 0, 10},
+            {101, 101, 4, 8, 1, 0},
+            {202, 202, 3, 12, 0, 11},
+            // unbalanced operands
+            {17, 5, 2, 5, 0, 12},
+            {5, 17, 2, 5, 0, 13},
+            {100, 33, 4, 8, 0, 14},
+            {97, 31, 4, 8, 1, 0},
+            {300, 7, 4, 5, 0, 15},
+            // default thresholds
+            {40, 40, DEFAULT, DEFAULT, 0, 16},
+            {250, 250, DEFAULT, DEFAULT, 0, 17},
+            {700, 500, DEFAULT, DEFAULT, 0, 18},
+            {600, 600, DEFAULT, DEFAULT, 1, 0},
+    };
+
+    int count = sizeof(test_cases) / sizeof(test_cases[0]);
+
+    for (int i = 0; i < count; i++) {
+        if (test_cases[i].karatsuba_threshold == DEFAULT) {
+            test_cases[i].karatsuba_threshold = limb_karatsuba_threshold;
+            test_cases[i].toom3_threshold = limb_toom3_threshold;
+        }
+        test_run(&test_cases[i], (bool (*)(void *)) test_limb_multiplication_executor, &tr,
+                 "%zu x %zu limbs (thresholds %zu, %zu)", "wrong product", test_cases[i].len_a,
+                 test_cases[i].len_b, test_cases[i].karatsuba_threshold,
+                 test_cases[i].toom3_threshold);
+    }
+
+    test_finalize(tr);
+}
+
+typedef struct Testcase_limb_division {
+    size_t len_x;
+    size_t len_d;
+    // threshold of the Newton reciprocal that is used during the test
+    size_t newton_threshold;
+    // 0: random limbs, 1: all limbs UINT64_MAX, 2: divisor with the most significant bit set
+    int fill;
+    uint64_t seed;
+} Testcase_limb_division;
+
+bool test_limb_division_executor(Testcase_limb_division *t) {
+    uint64_t state = t->seed;
+
+    limb_integer *x = create_limb_integer(t->len_x);
+    limb_integer *d = create_limb_integer(t->len_d);
+    for (size_t i = 0; i < t->len_x; i++) {
+        x->limbs[i] = t->fill == 1 ? UINT64_MAX : next_random_limb(&state);
+    }
+    for (size_t i = 0; i < t->len_d; i++) {
+        d->limbs[i] = t->fill == 1 ? UINT64_MAX : next_random_limb(&state);
+    }
+    if (t->fill == 2) d->limbs[t->len_d - 1] |= (uint64_t) 1 << 63;
+    x->size = t->len_x;
+    d->size = t->len_d;
+    limb_integer_normalize(x);
+    limb_integer_normalize(d);
+
+    limb_integer *q = create_limb_integer(1);
+    limb_integer *r = create_limb_integer(1);
+    limb_integer *check = create_limb_integer(1);
+
+    // schoolbook division: x == q * d + r and r < d
+    limb_integer_divmod(q, r, x, d);
+    limb_integer_multiplication(check, q, d, false);
+    limb_integer_addition(check, check, r);
+    bool success = limb_integer_is_equal(check, x) && limb_integer_compare_magnitude(r, d) < 0;
+
+    // Newton reciprocal == schoolbook reciprocal
+    size_t newton_threshold = limb_newton_threshold;
+    limb_newton_threshold = t->newton_threshold;
+    limb_integer *inverse = create_limb_integer(1);
+    limb_integer_reciprocal(inverse, d);
+    limb_newton_threshold = SIZE_MAX;
+    limb_integer *expected_inverse = create_limb_integer(1);
+    limb_integer_reciprocal(expected_inverse, d);
+    limb_newton_threshold = newton_threshold;
+    success = success && limb_integer_is_equal(inverse, expected_inverse);
+
+    // Barrett division == schoolbook division (only defined for x < B^2n)
+    if (x->size <= 2 * d->size) {
+        limb_integer *barrett_q = create_limb_integer(1);
+        limb_integer *barrett_r = create_limb_integer(1);
+        limb_integer_divmod_barrett(barrett_q, barrett_r, x, d, inverse);
+        success = success && limb_integer_is_equal(barrett_q, q) &&
+                  limb_integer_is_equal(barrett_r, r);
+        delete_limb_integer(barrett_q);
+        delete_limb_integer(barrett_r);
+    }
+
+    delete_limb_integer(x);
+    delete_limb_integer(d);
+    delete_limb_integer(q);
+    delete_limb_integer(r);
+    delete_limb_integer(check);
+    delete_limb_integer(inverse);
+    delete_limb_integer(expected_inverse);
+
+    return success;
+}
+
+/**
+ * Tests the schoolbook division, the Newton reciprocal and the Barrett division of limb_integers.
+ */
+void test_limb_division(Implementation impl) {
+    TestResult tr = test_init_impl(impl, "limb_integer division");
+
+    Testcase_limb_division test_cases[] = {
+            {1, 1, 1, 0, 1},        {5, 1, 1, 0, 2},        {7, 1, 1, 1, 0},
+            {7, 1, 1, 2, 21},       {2, 2, 1, 0, 3},        {3, 2, 1, 1, 0},
+            {4, 2, 1, 2, 4},        {10, 3, 1, 0, 5},       {20, 10, 1, 0, 6},
+            {20, 10, 1, 1, 0},      {19, 10, 1, 2, 7},      {40, 20, 8, 0, 8},
+            {41, 21, 8, 1, 0},      {60, 30, 9, 2, 9},      {100, 50, 8, 0, 10},
+            {99, 77, 8, 0, 11},     {200, 100, 8, 1, 0},    {257, 129, 8, 2, 12},
+            {300, 150, 32, 0, 13},  {1000, 500, 32, 0, 14}, {1000, 30, 32, 0, 15},
+            {2000, 1000, 32, 1, 0},
+    };
+
+    int count = sizeof(test_cases) / sizeof(test_cases[0]);
+
+    for (int i = 0; i < count; i++) {
+        test_run(&test_cases[i], (bool (*)(void *)) test_limb_division_executor, &tr,
+                 "%zu / %zu limbs (threshold %zu)", "wrong quotient/remainder",
+                 test_cases[i].len_x, test_cases[i].len_d, test_cases[i].newton_threshold);
+    }
+
+    test_finalize(tr);
+}
+
+void limb_tests_schoolbook(Implementation impl) {
+    test_limb_arithmetic(false, impl);
+    test_limb_division(impl);
+    test_limb_conversion(impl);
+    test_limb_conversion_long(impl);
+    test_limb_shared_powers(impl);
+}
+
+void limb_tests_subquadratic(Implementation impl) {
+    test_limb_arithmetic(true, impl);
+    test_limb_multiplication_subquadratic(impl);
+}
@@ -0,0 +1,10 @@
+#ifndef LIMB_TESTS_H
+#define LIMB_TESTS_H
+
+#include "../../implementations.h"
+
+void limb_tests_schoolbook(Implementation impl);
+
+void limb_tests_subquadratic(Implementation impl);
+
+#endif
@@ -1,135 +1,205 @@
 #include "impl_naive.h"
 
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
 #include "../../test.h"
 #include "../../util.h"
 #include "../common.h"
+#include "../number_system.h"
+
+// a one in the lowest bit of every byte of a word
+#define BYTE_ONES 0x0101010101010101ULL
+
+// masks of the bytes at even/odd digit positions of a word
+#define EVEN_DIGITS 0x00FF00FF00FF00FFULL
+#define ODD_DIGITS 0xFF00FF00FF00FF00ULL
+
+/**
+ * @brief Add two words of 8 digits (one digit per byte) in the base base_abs
+ *
+ * Every digit of a is biased by 256 - base_abs first, so that the byte overflows exactly if the sum
+ * of the digits is at least base_abs. The carries then propagate through the whole word with a
+ * single addition. The bias is removed again from all digits that did not carry.
+ *
+ * @param a         The first 8 digits
+ * @param b         The second 8 digits
+ * @param bias      256 - base_abs in every byte
+ * @param carry     The carry into the lowest digit, it is set to the carry out of the highest one
+ * @return          The 8 digits of the sum
+ */
+static uint64_t add_digit_words(uint64_t a, uint64_t b, uint64_t bias, bool *carry) {
+    a += bias;
+
+    uint64_t sum;
+    bool carry_out = __builtin_add_overflow(a, b, &sum);
+    carry_out |= __builtin_add_overflow(sum, (uint64_t) *carry, &sum);
+
+    // bit 8 * (j + 1) of a ^ b ^ sum is the carry out of the digit j
+    uint64_t carried = (((a ^ b ^ sum) >> 8) & BYTE_ONES) | ((uint64_t) carry_out << 56);
+    *carry = carry_out;
+
+    return sum - (~carried & BYTE_ONES) * (bias & 0xFF);
+}
+
+/**
+ * @brief Subtract two words of 8 digits (one digit per byte) in the base base_abs
+ *
+ * The borrows propagate through the whole word with a single subtraction, every digit that
+ * borrowed 256 instead of base_abs is corrected by the bias afterwards.
+ *
+ * @param a         The 8 digits of the minuend
+ * @param b         The 8 digits of the subtrahend
+ * @param bias      256 - base_abs in every byte
+ * @param borrow    The borrow of the lowest digit, it is set to the borrow of the highest one
+ * @return          The 8 digits of the difference
+ */
+static uint64_t sub_digit_words(uint64_t a, uint64_t b, uint64_t bias, bool *borrow) {
+    uint64_t difference;
+    bool borrow_out = __builtin_sub_overflow(a, b, &difference);
+    borrow_out |= __builtin_sub_overflow(difference, (uint64_t) *borrow, &difference);
+
+    // bit 8 * (j + 1) of a ^ b ^ difference is the borrow of the digit j
+    uint64_t borrowed = (((a ^ b ^ difference) >> 8) & BYTE_ONES) | ((uint64_t) borrow_out << 56);
+    *borrow = borrow_out;
+
+    return difference - borrowed * (bias & 0xFF);
+}
+
+/**
+ * @brief Replace every digit d at an odd position of a word by base_abs - 1 - d
+ *
+ * A number x in the base -base_abs with this flip applied is the number x + M in the base
+ * base_abs, where M has the digit base_abs - 1 at every odd position.
+ *
+ * @param digits    8 digits
+ * @param odd_max   base_abs - 1 in every odd byte
+ */
+static uint64_t flip_odd_digits(uint64_t digits, uint64_t odd_max) {
+    return (digits & EVEN_DIGITS) | (odd_max - (digits & ODD_DIGITS));
+}
+
+/**
+ * @brief Load the word of the 8 digits that end at the given digit (most significant first)
+ *
+ * The digit values are stored most significant first, the lowest byte of the word is the least
+ * significant digit.
+ */
+static uint64_t load_digit_word(const uint8_t *digits) {
+    uint64_t word;
+    memcpy(&word, digits, sizeof(word));
+    return __builtin_bswap64(word);
+}
+
+static void store_digit_word(uint8_t *digits, uint64_t word) {
+    word = __builtin_bswap64(word);
+    memcpy(digits, &word, sizeof(word));
+}
 
 /**
  * @brief Add or subtract two unsigned numbers
  *
- * z1 has to be bigger than z2 for subtraction.
+ * z1 has to be bigger than z2 for subtraction (in positive bases).
  * The NULL terminated result will be written to the given buffer.
  * If specified the result will be prefixed by a '-' character.
  *
+ * The digit values are packed into 64-bit words of 8 digits that are added/subtracted with a
+ * single carry (see add_digit_words). In negative bases, the numbers x are added as x + M in the
+ * base abs(base) (see flip_odd_digits): (a + M) + (b + M) - M = (a + b) + M and
+ * (a + M) - (b + M) + M = (a - b) + M.
+ *
  * @param add       True for addition, false for subtraction
  * @param negate    True if the result shall be prefixed by '-'
- * @param base      The base
- * @param alph      The alphabet
+ * @param system    The number system
  * @param z1        The first number (augend/minuend)
  * @param z2        The second number (addend/subtrahend)
  * @param result    The result buffer
  */
-static void add_sub_unsigned(bool add, bool negate, int base, const char *alph, const char *z1,
+static void add_sub_unsigned(bool add, bool negate, const number_system *system, const char *z1,
                              const char *z2, char *result) {
-    // if base < 0 carry sign is inverted
-    int carry_offset = base < 0 ? -1 : 1;
-
-    unsigned int base_abs = abs(base);
-
-    // populate lookup table (lut[digit] == index of digit in alphabet)
-    unsigned char lut[UCHAR_MAX + 1];
-    generate_lut(lut, base_abs, alph);
+    int base = system->base;
+    unsigned int base_abs = system->base_abs;
+    const digit_tables *tables = &system->tables;
 
     size_t a_len = strlen(z1);
     size_t b_len = strlen(z2);
 
-    const char *a_ms_digit = z1;
-    const char *b_ms_digit = z2;
+    // the result has at most 2 more digits than the longer number, rounded up to whole words
+    size_t length = (max_needed_chars_add_sub(z1, z2) + 7) & ~(size_t) 7;
 
-    // initialize current digit with pointer to last digit
-    const char *current_digit_a = a_ms_digit + a_len - 1;
-    const char *current_digit_b = b_ms_digit + b_len - 1;
+    // digit values (most significant first, with leading zeroes), the result overwrites a
+    uint8_t *a = malloc(2 * length);
+    check_alloc(a, 2 * length, "digit values");
+    uint8_t *b = a + length;
 
-    // write result backwards and reverse at the end
-    char *current_digit_result = result;
+    memset(a, 0, length - a_len);
+    digits_to_values(tables, z1, a_len, a + length - a_len);
+    memset(b, 0, length - b_len);
+    digits_to_values(tables, z2, b_len, b + length - b_len);
 
-    int carry = 0;
+    uint64_t bias = (256 - base_abs) * BYTE_ONES;
+    uint64_t odd_max = (base_abs - 1) * (ODD_DIGITS & BYTE_ONES);
 
-    // add with carry as long as there are digits left in a or b or carry != 0
-    while (current_digit_a >= a_ms_digit || current_digit_b >= b_ms_digit || carry != 0) {
-        char a;
-        char b;
+    bool carry = false;
+    bool m_carry = false;
 
-        // if a or b has no more digits use 0 respectively
-        if (current_digit_a < a_ms_digit) {
-            a = alph[0];
-        } else {
-            a = *current_digit_a;
-        }
+    // least significant word first
+    for (size_t i = length; i > 0; i -= 8) {
+        uint64_t a_word = load_digit_word(a + i - 8);
+        uint64_t b_word = load_digit_word(b + i - 8);
+        uint64_t r_word;
 
-        if (current_digit_b < b_ms_digit) {
-            b = alph[0];
+        if (base > 0) {
+            r_word = add ? add_digit_words(a_word, b_word, bias, &carry)
+                         : sub_digit_words(a_word, b_word, bias, &carry);
         } else {
-            b = *current_digit_b;
-        }
-
-        unsigned char a_idx = lut[(unsigned char) a];
-        unsigned char b_idx = lut[(unsigned char) b];
-
-        // calculate the sum/difference of the indices of a and b + carry
-        long sum_idx = (add ? a_idx + b_idx : a_idx - b_idx) + carry;
-
-        // handle carry by adding/subtracting abs(base) from the result and assign a new carry value
-        if (sum_idx >= base_abs) {
-            // carryAdd
-            *current_digit_result = alph[sum_idx - base_abs];
-            carry = carry_offset;
-        } else if (sum_idx < 0) {
-            // carrySub
-            *current_digit_result = alph[sum_idx + base_abs];
-            carry = -carry_offset;
-        } else {
-            // no carry
-            *current_digit_result = alph[sum_idx];
-            carry = 0;
+            a_word = flip_odd_digits(a_word, odd_max);
+            b_word = flip_odd_digits(b_word, odd_max);
+            if (add) {
+                r_word = add_digit_words(a_word, b_word, bias, &carry);
+                r_word = sub_digit_words(r_word, odd_max, bias, &m_carry);
+            } else {
+                r_word = sub_digit_words(a_word, b_word, bias, &carry);
+                r_word = add_digit_words(r_word, odd_max, bias, &m_carry);
+            }
+            r_word = flip_odd_digits(r_word, odd_max);
         }
 
-        // decrement a and b to the next-most significant digit
-        current_digit_a--;
-        current_digit_b--;
-        // increment result pointer to the next-most significant digit
-        current_digit_result++;
+        store_digit_word(a + i - 8, r_word);
     }
 
     // strip leading zeros
-    while (current_digit_result > (result + 1) && *(current_digit_result - 1) == alph[0]) {
-        current_digit_result--;
+    size_t start = 0;
+    while (start < length - 1 && a[start] == 0) {
+        start++;
     }
 
     // add '-' if result has to be negated
-    if (negate && *(current_digit_result - 1) != alph[0]) {
+    char *current_digit_result = result;
+    if (negate && a[start] != 0) {
         *current_digit_result = '-';
         current_digit_result++;
     }
 
-    // terminate string with NULL byte
-    *current_digit_result = '\0';
+    // write the digits (most significant first) and terminate string with NULL byte
+    values_to_digits(tables, a + start, length - start, current_digit_result);
+    current_digit_result[length - start] = '\0';
 
-    // reverse string
-    size_t len = strlen(result);
-    for (size_t i = 0, j = len - 1; i < j; i++, j--) {
-        char tmp = result[i];
-        result[i] = result[j];
-        result[j] = tmp;
-    }
+    free(a);
 }
 
 /**
  * @brief Compare two unsigned numbers with base > 0
  *
- * @param base      Base of the two numbers
- * @param alph      Alphabet of the numbers
+ * @param system    Number system of the two numbers
  * @param z1        First number
  * @param z2        Second number
  * @return          -1 if first number is smaller, 1 if first number is greater than second and 0 if
  *                  z1 == z2
  */
-static int cmp_unsigned_pos_base(unsigned int base, const char *alph, const char *z1,
-                                 const char *z2) {
+static int cmp_unsigned_pos_base(const number_system *system, const char *z1, const char *z2) {
     size_t z1_len = strlen(z1);
     size_t z2_len = strlen(z2);
 
@@ -138,9 +208,7 @@ static int cmp_unsigned_pos_base(unsigned int base, const char *alph, const char
     } else if (z1_len > z2_len) {
         return 1;
     } else {  // same number of digits
-
-        unsigned char lut[UCHAR_MAX + 1];
-        generate_lut(lut, base, alph);
+        const unsigned char *lut = system->tables.lut;
 
         do {
             if (lut[(unsigned char) *z1] < lut[(unsigned char) *z2]) {
@@ -165,216 +233,189 @@ static int cmp_unsigned_pos_base(unsigned int base, const char *alph, const char
  *
  * @see add_sub_unsigned
  *
- * @param base      The base
- * @param alph      The alphabet
+ * @param system    The number system
  * @param z1        The first number (minuend)
  * @param z2        The second number (subtrahend)
  * @param result    The result buffer
  */
-static void sub_unsigned_to_signed(int base, const char *alph, const char *z1, const char *z2,
+static void sub_unsigned_to_signed(const number_system *system, const char *z1, const char *z2,
                                    char *result) {
-    if (cmp_unsigned_pos_base(base, alph, z1, z2) < 0) {
+    if (cmp_unsigned_pos_base(system, z1, z2) < 0) {
         // -(z2 - z1)
-        add_sub_unsigned(false, true, base, alph, z2, z1, result);
+        add_sub_unsigned(false, true, system, z2, z1, result);
     } else {
         // z1 - z2
-        add_sub_unsigned(false, false, base, alph, z1, z2, result);
+        add_sub_unsigned(false, false, system, z1, z2, result);
     }
 }
 
 /**
- * @brief Multiply an unsigned number by a digit and leftshift the result
+ * @brief Multiply two unsigned numbers
  *
- * This method multiplies z1 by the digit z2.
- * The result is shifted to the left by the specified amount of digits.
- * The NULL terminated result will be written to the given buffer.
+ * This method multiplies z1 and z2 with the long multiplication algorithm on the digit values:
+ * The products of all pairs of digits are accumulated in one 64-bit column sum per digit position
+ * of the result, the carries are normalized once at the end (in negative bases the carry into the
+ * next position changes its sign). Equal factors are squared, which computes every cross product
+ * only once. The NULL terminated result will be written to the given buffer.
+ * If specified the result will be prefixed by a '-' character.
  *
- * @param shift     The amount of digits for the result to be shifted to the left
- * @param base      The base
- * @param alph      The alphabet
+ * @param negate    True if the result shall be prefixed by '-'
+ * @param system    The number system
  * @param z1        The first number (multiplicand)
  * @param z2        The second number (multiplier)
  * @param result    The result buffer
  */
-static void mul_unsigned_and_shift_left(const unsigned int shift, int base, const char *alph,
-                                        const char *z1, const char z2, char *result) {
-    char carry_offset = base < 0 ? -1 : 1;
-
-    unsigned char lut[UCHAR_MAX + 1];
-
-    unsigned int base_abs = abs(base);
-
-    // populate lookup table (lut[digit] == index of digit in alphabet)
-    generate_lut(lut, base_abs, alph);
-
-    size_t a_len = strlen(z1);
-
-    const char *a_ms_digit = z1;
-
-    // initialize current digit with pointer to last digit
-    const char *current_digit_a = a_ms_digit + a_len - 1;
-
-    // write result backwards
-    char *current_digit_result = result;
-
-    char b = z2;
-    unsigned char b_idx = lut[(unsigned char) b];
-
-    int carry = 0;
-
-    // add with carry as long as there is a digit in a and b
-    while (current_digit_a >= a_ms_digit || carry != 0) {
-        char a;
-
-        if (current_digit_a < a_ms_digit) {
-            a = alph[0];
-        } else {
-            a = *current_digit_a;
-        }
-
-        unsigned char a_idx = lut[(unsigned char) a];
+static void mul_unsigned(bool negate, const number_system *system, const char *z1, const char *z2,
+                         char *result) {
+    int base = system->base;
+    unsigned int base_abs = system->base_abs;
+    const digit_tables *tables = &system->tables;
 
-        long prod_idx = a_idx * b_idx + carry;
+    size_t z1_len = strlen(z1);
+    size_t z2_len = strlen(z2);
 
-        if (prod_idx >= base_abs) {
-            // carryAdd
+    // The inner loop runs over the longer factor, so that it is vectorized over as many columns as
+    // possible. Therefore we swap z1 and z2 if z2 < z1
+    if (z2_len < z1_len) {
+        const char *tmp = z1;
+        z1 = z2;
+        z2 = tmp;
+        size_t tmp_len = z1_len;
+        z1_len = z2_len;
+        z2_len = tmp_len;
+    }
 
-            // calculate the resulting digit and carry:
-            // * subtract abs(base) from the result until it is a valid digit
-            // * add the carry offset to 0 equally often
-            carry = 0;
-            while (prod_idx >= base_abs) {
-                prod_idx -= base_abs;
-                carry += carry_offset;
+    // The z1_len + z2_len - 1 digit columns, the carries of the last column need up to 2 more
+    // digits (in negative bases). Everything is stored most significant first.
+    size_t length = z1_len + z2_len + 1;
+    size_t offset = length - (z1_len + z2_len - 1);
+
+    uint8_t *values = malloc(z1_len + z2_len + length);
+    check_alloc(values, z1_len + z2_len + length, "digit values");
+    uint8_t *a = values;
+    uint8_t *b = a + z1_len;
+    uint8_t *digits = b + z2_len;
+
+    uint64_t *columns = calloc(length, sizeof(uint64_t));
+    check_alloc(columns, length * sizeof(uint64_t), "digit columns");
+
+    digits_to_values(tables, z1, z1_len, a);
+    digits_to_values(tables, z2, z2_len, b);
+
+    // a[i] * b[j] belongs to the column offset + i + j. A column sum is at most
+    // z1_len * (base_abs - 1)^2, so it can not overflow.
+    if (z1_len == z2_len && (z1 == z2 || memcmp(z1, z2, z1_len) == 0)) {
+        // squaring: a[i] * a[j] and a[j] * a[i] are equal, so every cross product is computed once
+        // and doubled, the column sums stay the same as above
+        for (size_t i = 0; i < z1_len; i++) {
+            uint64_t digit = a[i];
+            if (digit == 0) continue;
+
+            columns[offset + 2 * i] += digit * digit;
+            uint64_t twice = 2 * digit;
+            uint64_t *column = columns + offset + i;
+            for (size_t j = i + 1; j < z1_len; j++) {
+                column[j] += twice * a[j];
             }
+        }
+    } else {
+        for (size_t i = 0; i < z1_len; i++) {
+            uint64_t digit = a[i];
+            if (digit == 0) continue;
 
-            *current_digit_result = alph[prod_idx];  // 9 * 9 -> 81 -> 1
-        } else if (prod_idx < 0) {
-            // carrySub
-
-            // calculate the resulting digit and carry:
-            // * add abs(base) to the result until it is a valid digit
-            // * subtract the carry offset from 0 equally often
-            carry = 0;
-            while (prod_idx < 0) {
-                prod_idx += base_abs;
-                carry -= carry_offset;
+            uint64_t *column = columns + offset + i;
+            for (size_t j = 0; j < z2_len; j++) {
+                column[j] += digit * b[j];
             }
-
-            *current_digit_result = alph[prod_idx];
-        } else {
-            // no carry
-            *current_digit_result = alph[prod_idx];
-            carry = 0;
         }
-
-        current_digit_a--;
-        current_digit_result++;
     }
 
-    // strip leading zeros
-    while (current_digit_result > (result + 1) && *(current_digit_result - 1) == alph[0]) {
-        current_digit_result--;
-    }
+    // normalize the carries (least significant column first)
+    int64_t carry = 0;
+    for (size_t k = length; k > 0; k--) {
+        int64_t column = (int64_t) columns[k - 1] + carry;
+        int64_t digit = column % (int64_t) base_abs;
+        if (digit < 0) digit += base_abs;
 
-    // terminate string with NULL byte
-    *current_digit_result = '\0';
+        digits[k - 1] = digit;
+        carry = (column - digit) / (int64_t) base_abs;
+        if (base < 0) carry = -carry;
+    }
+    if (carry != 0) {
+        abort_err("The product exceeds its %zu digits.", length);
+    }
 
-    // reverse string
-    size_t len = strlen(result);
-    for (size_t i = 0, j = len - 1; i < j; i++, j--) {
-        char tmp = result[i];
-        result[i] = result[j];
-        result[j] = tmp;
+    // strip leading zeros
+    size_t start = 0;
+    while (start < length - 1 && digits[start] == 0) {
+        start++;
     }
 
-    // shift the result to the left by appending zeros (represented by alph[0])
-    for (size_t i = 0; i < shift; i++) {
-        *current_digit_result = alph[0];
+    // add '-' if result has to be negated
+    char *current_digit_result = result;
+    if (negate && digits[start] != 0) {
+        *current_digit_result = '-';
         current_digit_result++;
     }
 
-    // terminate string with NULL byte
-    *current_digit_result = '\0';
+    // write the digits (most significant first) and terminate string with NULL byte
+    values_to_digits(tables, digits + start, length - start, current_digit_result);
+    current_digit_result[length - start] = '\0';
+
+    free(values);
+    free(columns);
 }
 
 /**
- * @brief Multiply two unsigned numbers
+ * @brief Raise an unsigned number to a power
  *
- * This method multiplies z1 and z2 with the long multiplication algorithm by iterating over the
- * digits of z2. The NULL terminated result will be written to the given buffer. If specified the
+ * This method calculates z^exponent with the left-to-right binary exponentiation
+ * (square-and-multiply) on the digits: Starting with z, the power is squared (see mul_unsigned) for
+ * every bit of the exponent below the most significant one and multiplied by z if the bit is set.
+ * The intermediate powers alternate between the result buffer and a temporary buffer, which one
+ * holds the first power is chosen so that the last one is in the result buffer. If specified the
  * result will be prefixed by a '-' character.
  *
  * @param negate    True if the result shall be prefixed by '-'
- * @param base      The base
- * @param alph      The alphabet
- * @param z1        The first number (multiplicand)
- * @param z2        The second number (multiplier)
+ * @param system    The number system
+ * @param z         The base of the power
+ * @param exponent  The exponent
  * @param result    The result buffer
  */
-static void mul_unsigned(bool negate, int base, const char *alph, const char *z1, const char *z2,
-                         char *result) {
-    size_t buffer_size = max_needed_chars_mul(z1, z2) + 1;
-    char *tmp_result_1 = malloc(buffer_size);
-    check_alloc(tmp_result_1, buffer_size, "temporary result buffer 1");
-
-    char *tmp_result_2 = malloc(buffer_size);
-    check_alloc(tmp_result_2, buffer_size, "temporary result buffer 2");
-
-    char *tmp_result_3 = malloc(buffer_size);
-    check_alloc(tmp_result_3, buffer_size, "temporary result buffer 3");
-
-    // initialize buffer 1 with 0
-    const char zero[2] = {alph[0], '\0'};
-    strcpy(tmp_result_1, zero);
-
-    size_t z1_len = strlen(z1);
-    size_t z2_len = strlen(z2);
+static void pow_unsigned(bool negate, const number_system *system, const char *z,
+                         uint64_t exponent, char *result) {
+    const char one[2] = {system->alph[1], '\0'};
+    if (exponent == 0) {
+        strcpy(result, one);
+        return;
+    }
 
-    // pointer to a
-    const char *a;
-    // pointer to current digit of b (initialized with the least significant digit of b)
-    const char *b;
-    size_t max_shift;
-
-    // It is slightly more efficient to use the smaller factor as the multiplier because of the
-    // accumulated overhead of repeatedly calling mul_unsigned_and_shift_left() and
-    // add_sub_unsigned()
-
-    // Therefore we swap z1 and z2 if z2 > z1
-    if (z2_len <= z1_len) {
-        a = z1;
-        max_shift = z2_len - 1;
-        b = z2 + max_shift;
-    } else {
-        a = z2;
-        max_shift = z1_len - 1;
-        b = z1 + max_shift;
+    // the number of squarings and multiplications (z * 1 normalizes z if there are none)
+    int top = 63 - __builtin_clzll(exponent);
+    int steps = top + __builtin_popcountll(exponent) - 1;
+    if (steps == 0) {
+        mul_unsigned(negate, system, z, one, result);
+        return;
     }
 
-    // iterate over all but the most significant digit from right to left
-    for (size_t i = 0; i < max_shift; i++) {
-        // multiply a with digit, shift and store result in buffer 2
-        mul_unsigned_and_shift_left(i, base, alph, a, *(b - i), tmp_result_2);
+    size_t size = strlen(z) * exponent + 2;
+    char *temp = malloc(size);
+    check_alloc(temp, size, "intermediate power");
 
-        // add buffer 1 and buffer 2 and store result in buffer 3
-        add_sub_unsigned(true, false, base, alph, tmp_result_1, tmp_result_2, tmp_result_3);
+    const char *power = z;
+    for (int bit = top - 1; bit >= 0; bit--) {
+        char *square = --steps % 2 == 0 ? result : temp;
+        mul_unsigned(negate && steps == 0, system, power, power, square);
+        power = square;
 
-        // swap buffer 1 and 3
-        char *tmp = tmp_result_1;
-        tmp_result_1 = tmp_result_3;
-        tmp_result_3 = tmp;
+        if ((exponent >> bit) & 0x1) {
+            char *product = --steps % 2 == 0 ? result : temp;
+            mul_unsigned(negate && steps == 0, system, power, z, product);
+            power = product;
+        }
     }
 
-    // multiply a with the most significant digit, shift and store result in buffer 2
-    mul_unsigned_and_shift_left(max_shift, base, alph, a, *(b - max_shift), tmp_result_2);
-
-    // add buffer 1 and buffer 2, negate if necessary and store result in the result buffer
-    add_sub_unsigned(true, negate, base, alph, tmp_result_1, tmp_result_2, result);
-
-    free(tmp_result_1);
-    free(tmp_result_2);
-    free(tmp_result_3);
+    free(temp);
 }
 
 /**
@@ -404,6 +445,15 @@ static void strip_zeroes(const char **z, char zero) {
 }
 
 void impl_naive(int base, const char *alph, const char *z1, const char *z2, char op, char *result) {
+    const number_system *system = get_number_system(base, alph);
+
+    // the exponent of a power is a single (non-negative) integer
+    uint64_t exponent = 0;
+    exponent_status status = op == '^' ? parse_exponent(system, z2, UINT64_MAX, &exponent)
+                                       : EXPONENT_VALID;
+    if (status == EXPONENT_NEGATIVE) abort_err("The exponent %s is negative!", z2);
+    if (status == EXPONENT_TOO_BIG) abort_err("The exponent %s is too big!", z2);
+
     if (base < 0) {
         strip_zeroes(&z1, *alph);
         strip_zeroes(&z2, *alph);
@@ -413,15 +463,19 @@ void impl_naive(int base, const char *alph, const char *z1, const char *z2, char
         switch (op) {
             case '+':
                 // a + b
-                add_sub_unsigned(true, false, base, alph, z1, z2, result);
+                add_sub_unsigned(true, false, system, z1, z2, result);
                 break;
             case '-':
                 // a - b
-                add_sub_unsigned(false, false, base, alph, z1, z2, result);
+                add_sub_unsigned(false, false, system, z1, z2, result);
                 break;
             case '*':
                 // a * b
-                mul_unsigned(false, base, alph, z1, z2, result);
+                mul_unsigned(false, system, z1, z2, result);
+                break;
+            case '^':
+                // a ^ e
+                pow_unsigned(false, system, z1, exponent, result);
                 break;
             default:
                 // illegal operator
@@ -442,42 +496,46 @@ void impl_naive(int base, const char *alph, const char *z1, const char *z2, char
             case '+':
                 if (z1_pos && z2_pos) {  // +a + +b
                     // a + b
-                    add_sub_unsigned(true, false, base, alph, z1, z2, result);
+                    add_sub_unsigned(true, false, system, z1, z2, result);
                 } else if (z1_pos) {  // +a + -b
                     // a - b
-                    sub_unsigned_to_signed(base, alph, z1, z2, result);
+                    sub_unsigned_to_signed(system, z1, z2, result);
                 } else if (z2_pos) {  // -a + +b
                     // b - a
-                    sub_unsigned_to_signed(base, alph, z2, z1, result);
+                    sub_unsigned_to_signed(system, z2, z1, result);
                 } else {  // -a + -b
                     // -(a + b)
-                    add_sub_unsigned(true, true, base, alph, z1, z2, result);
+                    add_sub_unsigned(true, true, system, z1, z2, result);
                 }
                 break;
             case '-':
                 if (z1_pos && z2_pos) {  // +a - +b
                     // a - b
-                    sub_unsigned_to_signed(base, alph, z1, z2, result);
+                    sub_unsigned_to_signed(system, z1, z2, result);
                 } else if (z1_pos) {  // +a - -b
                     // a + b
-                    add_sub_unsigned(true, false, base, alph, z1, z2, result);
+                    add_sub_unsigned(true, false, system, z1, z2, result);
                 } else if (z2_pos) {  // -a - +b
                     // -(a + b)
-                    add_sub_unsigned(true, true, base, alph, z1, z2, result);
+                    add_sub_unsigned(true, true, system, z1, z2, result);
                 } else {  // -a - -b
                     // b - a
-                    sub_unsigned_to_signed(base, alph, z2, z1, result);
+                    sub_unsigned_to_signed(system, z2, z1, result);
                 }
                 break;
             case '*':
                 if (z1_pos != z2_pos) {  // +a * -b || -a * +b
                     // -(a * b)
-                    mul_unsigned(true, base, alph, z1, z2, result);
+                    mul_unsigned(true, system, z1, z2, result);
                 } else {  // -a * -b || +a * +b
                     // a * b
-                    mul_unsigned(false, base, alph, z1, z2, result);
+                    mul_unsigned(false, system, z1, z2, result);
                 }
                 break;
+            case '^':
+                // odd powers of negative numbers are negative: -(a ^ e)
+                pow_unsigned(!z1_pos && exponent % 2 == 1, system, z1, exponent, result);
+                break;
             default:
                 // illegal operator
                 return;
@@ -519,4 +577,69 @@ static TestResult test_lut(Implementation impl) {
     return tr;
 }
 
-void impl_naive_test(Implementation impl) { test_lut(impl); }
\ No newline at end of file
+typedef struct {
+    int base;
+    const char *alph;
+    const char *z1;
+    char op;
+    const char *z2;
+    const char *expected;
+} Testcase_carry_chains;
+
+static bool test_carry_chains_exec(char *result, Testcase_carry_chains *t) {
+    impl_naive(t->base, t->alph, t->z1, t->z2, t->op, result);
+    return strcmp(result, t->expected) == 0;
+}
+
+/**
+ * Tests carries and borrows that run through whole words of digits (and across word boundaries)
+ * and the carries of big digit columns of products in positive and negative bases.
+ */
+static void test_carry_chains(Implementation impl) {
+    TestResult tr = test_init_impl(impl, "long carry chains (+, -, *)");
+
+    const char *hex = "0123456789ABCDEF";
+
+    Testcase_carry_chains test_cases[] = {
+            {10, hex, "9999999999999999", '+', "1", "10000000000000000"},
+            {10, hex, "10000000000000000", '-', "1", "9999999999999999"},
+            {10, hex, "123456789123456789", '-', "123456789123456789", "0"},
+            {10, hex, "-99999999", '-', "1", "-100000000"},
+            {16, hex, "FFFFFFFFFFFFFFFFFFFFFFFF", '+', "1", "1000000000000000000000000"},
+            {-2, hex, "1", '+', "1", "110"},
+            {-2, hex, "11", '+', "1", "0"},
+            {-2, hex, "0", '-', "1", "11"},
+            {-2, hex, "1010101010101010101", '+', "1010101010101010101", "111111111111111111110"},
+            {-2, hex, "1", '-', "11111111111111111111", "110101010101010101010"},
+            {-10, hex, "9999999999999999", '+', "9999999999999999", "197777777777777778"},
+            {-10, hex, "1", '-', "19", "2"},
+            {-10, hex, "0", '-', "1000000000000000000", "19000000000000000000"},
+            {10, hex, "99999999999999999999", '*', "99999999999999999999",
+             "9999999999999999999800000000000000000001"},
+            {10, hex, "-12345678901234567890", '*', "98765432109876543210",
+             "-1219326311370217952237463801111263526900"},
+            {10, hex, "0", '*', "-5", "0"},
+            {16, hex, "FFFFFFFFFFFFFFFF", '*', "FFFFFFFF", "FFFFFFFEFFFFFFFF00000001"},
+            {-2, hex, "11", '*', "11", "1"},
+            {-2, hex, "110", '*', "111", "11010"},
+            {-10, hex, "19", '*', "19", "1"},
+            {-10, hex, "9999999999", '*', "9999999999", "147158269353063952841"},
+    };
+
+    int count = sizeof(test_cases) / sizeof(test_cases[0]);
+
+    char result[64];
+
+    for (int i = 0; i < count; i++) {
+        test_run_with_env(result, &test_cases[i], (void *) test_carry_chains_exec, &tr,
+                          "%s %c %s with base %i", "got %s", test_cases[i].z1, test_cases[i].op,
+                          test_cases[i].z2, test_cases[i].base, result);
+    }
+
+    test_finalize(tr);
+}
+
+void impl_naive_test(Implementation impl) {
+    test_lut(impl);
+    test_carry_chains(impl);
+}
\ No newline at end of file
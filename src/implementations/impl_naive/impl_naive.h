@@ -20,7 +20,8 @@
  * @param z1        The first operand.  May start with '-' if base is positive. Any following
  * characters must be contained in alph.
  * @param z2        The second operand. Same rules apply as for z1.
- * @param op        The operator.       Must be any of ['+', '-', '*'].
+ * @param op        The operator.       Must be any of ['+', '-', '*', '^'], the exponent of '^'
+ * must not be negative.
  * @param result    The result buffer.  The result will be stored as a NULL terminated string. Must
  * be large enough to be able to accommodate the result.
  */
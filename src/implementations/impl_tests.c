@@ -1,6 +1,7 @@
 #include "impl_tests.h"
 
 #include <ctype.h>
+#include <inttypes.h>
 #include <limits.h>
 #include <math.h>
 #include <stdio.h>
@@ -9,6 +10,10 @@
 
 #include "../test.h"
 #include "../util.h"
+#include "common.h"
+#include "impl_limb/limb_multiplication.h"
+#include "number_system.h"
+#include "thread_pool.h"
 
 struct Env {
     implementation_t impl;
@@ -268,7 +273,22 @@ static void other(Implementation impl) {
                                                                                                                      "PP=_g4-II_Ph_xhhPgP=-yxPgyy"},
             {-3,  "EsK", "EEEsEsEKKKEKKKKKKEKEEEsKsEEsEEKssKK", "s",                                            '*',
                                                                                                                      "sEsEKKKEKKKKKKEKEEEsKsEEsEEKssKK"},
-            {-3,  "EsK", "EEEsEsEKKKEKKKKKKEKEEEsKsEEsEEKssKK", "E",                                            '*', "E"}};
+            {-3,  "EsK", "EEEsEsEKKKEKKKKKKEKEEEsKsEEsEEKssKK", "E",                                            '*', "E"},
+            {10, "0123456789", "-12", "3", '^', "-1728"},
+            {10, "0123456789", "-12", "2", '^', "144"},
+            {10, "0123456789", "-3", "1", '^', "-3"},
+            {10, "0123456789", "007", "2", '^', "49"},
+            {10, "0123456789", "2", "100", '^', "1267650600228229401496703205376"},
+            {10, "0123456789", "0", "0", '^', "1"},
+            {10, "0123456789", "-7", "-0", '^', "1"},
+            {10, "0123456789", "-0", "3", '^', "0"},
+            {16, "0123456789abcdef", "-ff", "5", '^', "-fb09f604ff"},
+            {7, "abcdefg", "c", "bab", '^', "efgbadeaebgfcaggbe"},
+            {-2, "01", "11", "110", '^', "1"},
+            {-10, "0123456789", "19", "3", '^', "19"},
+            {-10, "0123456789", "9081726354453627189", "7", '^',
+             "50934199051747483881796482387587251483849678113793488740315893578638010483703949"
+             "72653076582407397345439877915073748806032332996293309"}};
 
     int n = sizeof(testcases) / sizeof(Testcase);
 
@@ -281,13 +301,72 @@ static void other(Implementation impl) {
     free(res_buf);
 }
 
-static size_t generate_random_alph(char *alph) {
+typedef struct {
+    int base;
+    const char *z;
+    uint64_t max;
+    exponent_status status;
+    uint64_t exponent;  // the expected value (only if it is valid)
+} TestParseExponentCase;
+
+static bool test_parse_exponent_executor(TestParseExponentCase *t) {
+    const char *alph = "0123456789abcdef";
+    uint64_t exponent = 0;
+    exponent_status status =
+            parse_exponent(get_number_system(t->base, alph), t->z, t->max, &exponent);
+    return status == t->status && (status != EXPONENT_VALID || exponent == t->exponent);
+}
+
+/**
+ * Tests that parse_exponent tells negative exponents apart from exponents that are too big.
+ */
+static void test_parse_exponent(void) {
+    TestResult tr = test_init("all", "exponents of powers");
+
+    TestParseExponentCase test_cases[] = {
+            {10, "100", UINT64_MAX, EXPONENT_VALID, 100},
+            {10, "-0", UINT64_MAX, EXPONENT_VALID, 0},
+            {10, "0007", 7, EXPONENT_VALID, 7},
+            {10, "18446744073709551615", UINT64_MAX, EXPONENT_VALID, UINT64_MAX},
+            {10, "18446744073709551616", UINT64_MAX, EXPONENT_TOO_BIG, 0},
+            {10, "99999999999999999999999", UINT64_MAX, EXPONENT_TOO_BIG, 0},
+            {10, "8", 7, EXPONENT_TOO_BIG, 0},
+            {10, "-5", UINT64_MAX, EXPONENT_NEGATIVE, 0},
+            {10, "-99999999999999999999999", UINT64_MAX, EXPONENT_NEGATIVE, 0},
+            {16, "ffffffffffffffff", UINT64_MAX, EXPONENT_VALID, UINT64_MAX},
+            {16, "10000000000000000", UINT64_MAX, EXPONENT_TOO_BIG, 0},
+            {-10, "19", UINT64_MAX, EXPONENT_NEGATIVE, 0},
+            {-10, "0019", UINT64_MAX, EXPONENT_NEGATIVE, 0},
+            {-10, "190", UINT64_MAX, EXPONENT_VALID, 10},
+            {-10, "000", UINT64_MAX, EXPONENT_VALID, 0},
+            {-10, "100000000000000000000000", UINT64_MAX, EXPONENT_NEGATIVE, 0},
+            {-10, "1000000000000000000000000", UINT64_MAX, EXPONENT_TOO_BIG, 0},
+            {-2, "110", 2, EXPONENT_VALID, 2},
+            {-2, "111", 2, EXPONENT_TOO_BIG, 0},
+    };
+
+    int count = sizeof(test_cases) / sizeof(test_cases[0]);
+
+    for (int i = 0; i < count; i++) {
+        test_run(&test_cases[i], (bool (*)(void *)) test_parse_exponent_executor, &tr,
+                 "\"%s\" in base %d (max %" PRIu64 ")", "wrong status or value", test_cases[i].z,
+                 test_cases[i].base, test_cases[i].max);
+    }
+
+    test_finalize(tr);
+}
+
+/**
+ * Generates a random alphabet of the given length (a random length if it is 0) and returns its
+ * length.
+ */
+static size_t generate_random_alph(char *alph, size_t length) {
     char char_str[2] = {'\0', '\0'};
 
     alph[0] = '\0';
 
     size_t i = 0;
-    while (i <= 1 || rand() > RAND_MAX / 10) {
+    while (length == 0 ? i <= 1 || rand() > RAND_MAX / 10 : i < length) {
         unsigned char symbol;
         do {
             symbol = rand() % (UCHAR_MAX + 1);
@@ -350,8 +429,21 @@ static bool test_impls_compare_executor(TestImplsCompareEnv *testcase) {
     return true;
 }
 
-static void test_impls_compare(size_t iterations, size_t max_len, size_t seed, char op) {
-    TestResult tr = test_init("all", "comparing results with random inputs (%c)", op);
+/**
+ * Compares the results of all implementations with random inputs (every fourth product is a
+ * square). The bases are random or +-base_abs if it is not 0. With more than one thread, the limb
+ * implementations split all operations on more than 2 limbs across the threads.
+ */
+static void test_impls_compare(size_t iterations, size_t max_len, size_t seed, char op,
+                               size_t threads, size_t base_abs) {
+    char bases[32] = "";
+    if (base_abs != 0) snprintf(bases, sizeof(bases), ", bases +-%zu", base_abs);
+    TestResult tr = test_init("all", "comparing results with random inputs (%c, %zu threads%s)", op,
+                              threads, bases);
+
+    size_t parallel_threshold = limb_parallel_threshold;
+    if (threads > 1) limb_parallel_threshold = 2;
+    thread_pool_set_threads(threads);
 
     size_t BUF_LEN = max_len + 1;
     size_t RES_BUF_LEN = BUF_LEN * 2;
@@ -380,8 +472,8 @@ static void test_impls_compare(size_t iterations, size_t max_len, size_t seed, c
     srand(seed);
 
     for (size_t i = 0; i < iterations; i++) {
-        size_t base_abs = generate_random_alph(alph_buf);
-        int base = rand() < RAND_MAX / 2 ? -((int) base_abs) : (int) base_abs;
+        size_t alph_length = generate_random_alph(alph_buf, base_abs);
+        int base = rand() < RAND_MAX / 2 ? -((int) alph_length) : (int) alph_length;
         testcase.base = base;
 
         size_t len_1 = 1 + (rand() % max_len);  // [1; max_len]
@@ -389,6 +481,15 @@ static void test_impls_compare(size_t iterations, size_t max_len, size_t seed, c
 
         generate_random_num(alph_buf, base, len_1, true, z1_buf);
         generate_random_num(alph_buf, base, len_2, true, z2_buf);
+        // every fourth product is a square
+        if (op == '*' && i % 4 == 0) strcpy(z2_buf, z1_buf);
+        if (op == '^') {
+            // the power has at most max_len digits: a single digit exponent that is below 8
+            len_1 = 1 + (rand() % (max_len / 8));
+            generate_random_num(alph_buf, base, len_1, true, z1_buf);
+            z2_buf[0] = alph_buf[rand() % (alph_length < 8 ? alph_length : 8)];
+            z2_buf[1] = '\0';
+        }
 
         test_run(&testcase, (bool (*)(void *)) test_impls_compare_executor, &tr,
                  "\"%s\" %c \"%s\" with base %i and alphabet \"%s\"", "%s", z1_buf, op, z2_buf,
@@ -397,6 +498,9 @@ static void test_impls_compare(size_t iterations, size_t max_len, size_t seed, c
 
     test_finalize(tr);
 
+    thread_pool_set_threads(1);
+    limb_parallel_threshold = parallel_threshold;
+
     free(z1_buf);
     free(z2_buf);
     free(alph_buf);
@@ -407,6 +511,173 @@ static void test_impls_compare(size_t iterations, size_t max_len, size_t seed, c
     }
 }
 
+typedef struct {
+    const char *alph;
+    size_t length;
+    // position of a char that is not in the alphabet (length: all chars are digits)
+    size_t invalid_position;
+    char invalid_char;
+} TestDigitTablesCase;
+
+static bool test_digit_tables_executor(TestDigitTablesCase *t) {
+    digit_tables tables;
+    init_digit_tables(&tables, strlen(t->alph), t->alph);
+
+    char *z = malloc(t->length + 1);
+    check_alloc(z, t->length + 1, "");
+    uint8_t *values = malloc(t->length + 1);
+    check_alloc(values, t->length + 1, "");
+
+    for (size_t i = 0; i < t->length; i++) {
+        z[i] = t->alph[rand() % tables.base];
+    }
+    if (t->invalid_position < t->length) z[t->invalid_position] = t->invalid_char;
+    z[t->length] = '\0';
+
+    bool success = find_invalid_digit(&tables, z, t->length) == t->invalid_position;
+
+    // every digit gets its index in the alphabet, the invalid char gets 0
+    digits_to_values(&tables, z, t->length, values);
+    for (size_t i = 0; i < t->length; i++) {
+        uint8_t expected = i == t->invalid_position ? 0 : strchr(t->alph, z[i]) - t->alph;
+        success = success && values[i] == expected;
+    }
+
+    // back to the digits (in-place)
+    if (t->invalid_position < t->length) z[t->invalid_position] = t->alph[0];
+    values[t->length] = '\0';
+    char *digits = (char *) values;
+    values_to_digits(&tables, values, t->length, digits);
+    success = success && strcmp(digits, z) == 0;
+
+    free(z);
+    free(values);
+    return success;
+}
+
+/**
+ * Tests the (SIMD) translation between digits and values with alphabets that are translated by
+ * arithmetic, by shuffles and with the lookup table.
+ */
+static void test_digit_tables(void) {
+    TestResult tr = test_init("all", "translation between digits and values");
+
+    const char *alphabets[] = {
+            "0123456789",
+            "01",
+            "0123456789ABCDEF",
+            "zyxwvutsrqponmlkjihgfedcba",
+            "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz!#$%&()*+,./:;<=>?@[]^_`{|}~",
+            "01234\xB5\xE9",
+    };
+    const size_t lengths[] = {1, 15, 16, 17, 40, 100};
+    const char invalid_chars[] = {'-', ' ', '\xFF'};
+
+    srand(4711);
+
+    for (size_t a = 0; a < sizeof(alphabets) / sizeof(alphabets[0]); a++) {
+        for (size_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++) {
+            size_t length = lengths[l];
+            for (size_t c = 0; c < sizeof(invalid_chars); c++) {
+                size_t positions[] = {length, 0, length / 2, length - 1};
+                for (size_t p = 0; p < sizeof(positions) / sizeof(positions[0]); p++) {
+                    TestDigitTablesCase t = {alphabets[a], length, positions[p], invalid_chars[c]};
+                    test_run(&t, (bool (*)(void *)) test_digit_tables_executor, &tr,
+                             "alphabet \"%s\", %zu digits, '%c' at %zu", "", alphabets[a],
+                             length, invalid_chars[c], positions[p]);
+                }
+            }
+        }
+    }
+
+    test_finalize(tr);
+}
+
+static bool test_number_system_cache_executor(void *unused) {
+    (void) unused;
+
+    char alph[] = "0123456789ABCDEF";
+    number_system *hex = get_number_system(16, alph);
+
+    // the alphabet is copied and compared by value
+    bool success = hex == get_number_system(16, "0123456789ABCDEF");
+    alph[0] = 'x';
+    success = success && hex->alph[0] == '0' && get_number_system(16, alph) != hex;
+
+    // only the first abs(base) chars belong to the alphabet
+    number_system *negadecimal = get_number_system(-10, "0123456789ABCDEF");
+    success = success && negadecimal != hex && negadecimal->base_abs == 10 &&
+              strcmp(negadecimal->alph, "0123456789") == 0;
+    success = success && negadecimal == get_number_system(-10, "0123456789");
+
+    // the oldest number systems are replaced
+    for (int base = 2; base < 2 + NUMBER_SYSTEM_CACHE_SIZE; base++) {
+        get_number_system(base, "0123456789ABCDEF");
+    }
+    number_system *new_hex = get_number_system(16, "0123456789ABCDEF");
+    success = success && new_hex->base == 16 && strcmp(new_hex->alph, "0123456789ABCDEF") == 0;
+
+    return success;
+}
+
+/**
+ * Counts the tasks of a (nested) parallel loop: every task of the outer loop starts an inner loop.
+ */
+typedef struct {
+    size_t inner_count;
+    size_t *counts;  // the number of inner tasks that ran for every outer task
+} thread_pool_counts;
+
+static void count_inner_task(void *context, size_t index) {
+    (void) index;
+    __atomic_fetch_add((size_t *) context, 1, __ATOMIC_RELAXED);
+}
+
+static void count_outer_task(void *context, size_t index) {
+    thread_pool_counts *counts = context;
+    thread_pool_run(counts->inner_count, count_inner_task, &counts->counts[index]);
+}
+
+static bool test_thread_pool_executor(size_t *threads) {
+    thread_pool_set_threads(*threads);
+
+    size_t counts[37] = {0};
+    thread_pool_counts context = {53, counts};
+    thread_pool_run(37, count_outer_task, &context);
+
+    bool success = thread_pool_threads() == (*threads == 0 ? 1 : *threads);
+    for (size_t i = 0; i < 37; i++) {
+        success = success && counts[i] == 53;
+    }
+
+    thread_pool_set_threads(1);
+    return success;
+}
+
+/**
+ * Tests that every task of nested parallel loops runs exactly once.
+ */
+static void test_thread_pool(void) {
+    TestResult tr = test_init("all", "thread pool");
+
+    size_t threads[] = {0, 1, 2, 4, 8};
+    for (size_t i = 0; i < sizeof(threads) / sizeof(threads[0]); i++) {
+        test_run(&threads[i], (bool (*)(void *)) test_thread_pool_executor, &tr,
+                 "nested loops with %zu threads", "", threads[i]);
+    }
+
+    test_finalize(tr);
+}
+
+/**
+ * Tests that number systems are cached by (base, alphabet).
+ */
+static void test_number_system_cache(void) {
+    TestResult tr = test_init("all", "number system cache");
+    test_run(NULL, test_number_system_cache_executor, &tr, "get_number_system", "");
+    test_finalize(tr);
+}
+
 void impl_tests_test(Implementation impl) {
     base_x_pos_neg(100, 8, '+', impl);
     base_x_pos_neg(100, 8, '-', impl);
@@ -426,7 +697,21 @@ void impl_tests_test(Implementation impl) {
 }
 
 void impl_tests_test_all() {
-    test_impls_compare(500, 50, 324235325, '+');
-    test_impls_compare(500, 50, 324235325, '-');
-    test_impls_compare(500, 50, 324235325, '*');
+    test_digit_tables();
+    test_number_system_cache();
+    test_parse_exponent();
+
+    test_thread_pool();
+
+    test_impls_compare(500, 50, 324235325, '+', 1, 0);
+    test_impls_compare(500, 50, 324235325, '-', 1, 0);
+    test_impls_compare(500, 50, 324235325, '*', 1, 0);
+    test_impls_compare(500, 400, 324235325, '^', 1, 0);
+    test_impls_compare(10, 3000, 324235325, '*', 4, 0);
+
+    // the conversions of the bases +-2^k copy bit fields
+    for (size_t base_abs = 2; base_abs <= 64; base_abs *= 2) {
+        test_impls_compare(100, 200, 324235325, '-', 1, base_abs);
+        test_impls_compare(100, 200, 324235325, '*', 1, base_abs);
+    }
 }
@@ -0,0 +1,92 @@
+#include "number_system.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "../util.h"
+
+number_system *create_number_system(int base, const char *alph) {
+    number_system *system = malloc(sizeof(number_system));
+    check_alloc(system, sizeof(number_system), "number system");
+
+    system->base = base;
+    system->base_abs = abs(base);
+
+    system->alph = malloc(system->base_abs + 1);
+    check_alloc(system->alph, system->base_abs + 1, "number system alphabet");
+    memcpy(system->alph, alph, system->base_abs);
+    system->alph[system->base_abs] = '\0';
+
+    init_digit_tables(&system->tables, system->base_abs, system->alph);
+    system->powers = get_shared_limb_power_table(system->base_abs);
+
+    return system;
+}
+
+void delete_number_system(number_system *system) {
+    free(system->alph);
+    free(system);
+}
+
+exponent_status parse_exponent(const number_system *system, const char *z, uint64_t max,
+                               uint64_t *exponent) {
+    bool minus = system->base > 0 && *z == '-';
+    if (minus) z++;
+
+    // the sign is decided by the most significant non-zero digit: in negative bases its weight
+    // base^(length - 1) is negative for an even number of digits
+    while (*z != '\0' && system->tables.lut[(unsigned char) *z] == 0) {
+        z++;
+    }
+    size_t length = strlen(z);
+    if (length > 0 && (minus || (system->base < 0 && length % 2 == 0))) return EXPONENT_NEGATIVE;
+
+    // Horner scheme: in negative bases the values of the prefixes alternate their signs, but their
+    // absolute values never decrease, so the parsing stops as soon as one of them is too big
+    __int128 value = 0;
+    for (; *z != '\0'; z++) {
+        value = value * system->base + system->tables.lut[(unsigned char) *z];
+        if (value > (__int128) max || value < -(__int128) max) return EXPONENT_TOO_BIG;
+    }
+
+    *exponent = (uint64_t) value;
+    return EXPONENT_VALID;
+}
+
+/**
+ * The number systems that were created last by the thread (one cache per thread, so that the lookup
+ * needs no lock, the powers are shared anyway). The oldest entry is replaced when a new one is
+ * needed.
+ */
+static _Thread_local number_system *cache[NUMBER_SYSTEM_CACHE_SIZE];
+static _Thread_local size_t cache_next = 0;
+
+number_system *get_number_system(int base, const char *alph) {
+    unsigned int base_abs = abs(base);
+
+    for (size_t i = 0; i < NUMBER_SYSTEM_CACHE_SIZE; i++) {
+        number_system *system = cache[i];
+        if (system != NULL && system->base == base && memcmp(system->alph, alph, base_abs) == 0) {
+            return system;
+        }
+    }
+
+    if (cache[cache_next] != NULL) {
+        delete_number_system(cache[cache_next]);
+    }
+    number_system *system = create_number_system(base, alph);
+    cache[cache_next] = system;
+    cache_next = (cache_next + 1) % NUMBER_SYSTEM_CACHE_SIZE;
+
+    return system;
+}
+
+void clear_number_system_cache(void) {
+    for (size_t i = 0; i < NUMBER_SYSTEM_CACHE_SIZE; i++) {
+        if (cache[i] != NULL) {
+            delete_number_system(cache[i]);
+            cache[i] = NULL;
+        }
+    }
+    cache_next = 0;
+}
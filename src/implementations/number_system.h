@@ -0,0 +1,75 @@
+#ifndef NUMBER_SYSTEM_H
+#define NUMBER_SYSTEM_H
+
+#include "common.h"
+#include "impl_limb/limb_powers.h"
+
+/**
+ * @brief Everything that only depends on the base and the alphabet of an operation
+ *
+ * The digit tables translate between digits and their values in both directions, the power table
+ * holds the powers of abs(base) for the conversions of the limb implementation. The power table is
+ * shared by all number systems of the same abs(base) in the process: the powers are computed lazily
+ * and are kept until the process exits, so that all operations in the base reuse them.
+ */
+typedef struct number_system {
+    int base;
+    unsigned int base_abs;
+    char *alph;  // copy of the alphabet (abs(base) chars, NULL terminated)
+    digit_tables tables;
+    limb_power_table *powers;  // shared, see get_shared_limb_power_table
+} number_system;
+
+/* number of number systems that are cached per thread */
+#define NUMBER_SYSTEM_CACHE_SIZE 8
+
+/**
+ * @brief Create the context of the number system with the given base and alphabet
+ *
+ * @param base  The base
+ * @param alph  The alphabet (only the first abs(base) chars are used)
+ * @return      The number system, it has to be deleted with delete_number_system
+ */
+number_system *create_number_system(int base, const char *alph);
+
+void delete_number_system(number_system *system);
+
+/* the result of parse_exponent */
+typedef enum exponent_status {
+    EXPONENT_VALID = 0,
+    EXPONENT_NEGATIVE,
+    EXPONENT_TOO_BIG,
+} exponent_status;
+
+/**
+ * @brief Get the value of an exponent
+ *
+ * @param system    The number system of z
+ * @param z         The exponent (only digits of the alphabet), it may start with '-' if the base is
+ *                  positive
+ * @param max       The greatest valid exponent
+ * @param exponent  Set to the value of z (only if it is valid)
+ * @return          EXPONENT_NEGATIVE if z is negative, EXPONENT_TOO_BIG if z is greater than max
+ */
+exponent_status parse_exponent(const number_system *system, const char *z, uint64_t max,
+                               uint64_t *exponent);
+
+/**
+ * @brief Get the (cached) context of the number system with the given base and alphabet
+ *
+ * The last NUMBER_SYSTEM_CACHE_SIZE number systems that were created by the calling thread are
+ * cached. The returned context is owned by the cache and stays valid until the thread creates
+ * NUMBER_SYSTEM_CACHE_SIZE other number systems.
+ *
+ * @param base  The base
+ * @param alph  The alphabet (only the first abs(base) chars are used)
+ * @return      The number system
+ */
+number_system *get_number_system(int base, const char *alph);
+
+/**
+ * @brief Delete all number systems that are cached by the calling thread (before the thread exits)
+ */
+void clear_number_system_cache(void);
+
+#endif
@@ -0,0 +1,119 @@
+#include "thread_pool.h"
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "../implementations.h"
+#include "../util.h"
+
+/*
+ *
+ * This file contains the worker pool that the implementations split big operations with. All loops
+ * that still have unclaimed tasks are on a stack (the latest loop first), the workers and the
+ * waiting callers claim the tasks one at a time.
+ *
+ */
+
+typedef struct task_group {
+    thread_pool_task task;
+    void *context;
+    size_t count;
+    size_t next;     // the next unclaimed task
+    size_t pending;  // the number of unfinished tasks
+    struct task_group *below;
+} task_group;
+
+static pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t work_available = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t group_finished = PTHREAD_COND_INITIALIZER;
+
+static task_group *groups = NULL;
+static pthread_t *workers = NULL;
+static size_t worker_count = 0;
+static bool stopping = false;
+
+/**
+ * Claims the next task of the topmost loop and executes it. The mutex has to be locked, it is
+ * unlocked while the task runs.
+ */
+static void run_next_task(void) {
+    task_group *group = groups;
+    size_t index = group->next++;
+    if (group->next == group->count) groups = group->below;
+
+    pthread_mutex_unlock(&mutex);
+    group->task(group->context, index);
+    pthread_mutex_lock(&mutex);
+
+    if (--group->pending == 0) pthread_cond_broadcast(&group_finished);
+}
+
+static void *worker(void *unused) {
+    (void) unused;
+
+    pthread_mutex_lock(&mutex);
+    while (true) {
+        while (!stopping && groups == NULL) {
+            pthread_cond_wait(&work_available, &mutex);
+        }
+        if (stopping) break;
+        run_next_task();
+    }
+    pthread_mutex_unlock(&mutex);
+
+    release_thread_resources();
+    return NULL;
+}
+
+void thread_pool_set_threads(size_t threads) {
+    pthread_mutex_lock(&mutex);
+    stopping = true;
+    pthread_cond_broadcast(&work_available);
+    pthread_mutex_unlock(&mutex);
+
+    for (size_t i = 0; i < worker_count; i++) {
+        pthread_join(workers[i], NULL);
+    }
+    free(workers);
+    workers = NULL;
+    worker_count = 0;
+    stopping = false;
+
+    if (threads <= 1) return;
+
+    workers = malloc((threads - 1) * sizeof(pthread_t));
+    check_alloc(workers, (threads - 1) * sizeof(pthread_t), "thread pool workers");
+    for (; worker_count < threads - 1; worker_count++) {
+        if (pthread_create(&workers[worker_count], NULL, worker, NULL) != 0) {
+            abort_err("Could not create a thread pool worker.\n");
+        }
+    }
+}
+
+size_t thread_pool_threads(void) { return worker_count + 1; }
+
+void thread_pool_run(size_t count, thread_pool_task task, void *context) {
+    if (worker_count == 0 || count <= 1) {
+        for (size_t i = 0; i < count; i++) {
+            task(context, i);
+        }
+        return;
+    }
+
+    task_group group = {task, context, count, 0, count, NULL};
+
+    pthread_mutex_lock(&mutex);
+    group.below = groups;
+    groups = &group;
+    pthread_cond_broadcast(&work_available);
+
+    while (group.pending > 0) {
+        if (groups != NULL) {
+            run_next_task();
+        } else {
+            pthread_cond_wait(&group_finished, &mutex);
+        }
+    }
+    pthread_mutex_unlock(&mutex);
+}
@@ -0,0 +1,32 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <stddef.h>
+
+/**
+ * @brief A task of a parallel loop
+ *
+ * @param context   The context of the loop
+ * @param index     The index of the task
+ */
+typedef void (*thread_pool_task)(void *context, size_t index);
+
+/**
+ * @brief Set the number of threads that execute the parallel loops (including the calling thread)
+ *
+ * The workers are started (and the old ones are stopped) right away. With 1 thread (the default)
+ * everything runs on the calling thread. Must not be called while a parallel loop runs.
+ */
+void thread_pool_set_threads(size_t threads);
+
+size_t thread_pool_threads(void);
+
+/**
+ * @brief Execute task(context, i) for every i < count in parallel and wait for all of them
+ *
+ * The calling thread executes tasks as well. While it waits, it helps with the tasks of all other
+ * loops, so that the tasks can start (nested) parallel loops themselves.
+ */
+void thread_pool_run(size_t count, thread_pool_task task, void *context);
+
+#endif
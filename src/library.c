@@ -0,0 +1,342 @@
+#include "library.h"
+
+#include <ctype.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "implementations/impl_binary_conversion/arithmetic_helper.h"
+#include "implementations/impl_binary_conversion/big_integer.h"
+#include "implementations/impl_binary_conversion/big_integer_arithmetic.h"
+#include "implementations/impl_binary_conversion/impl_binary_conversion.h"
+#include "implementations/number_system.h"
+#include "test.h"
+#include "util.h"
+
+/**
+ * A number is a big_integer whose length is (about) the number of its used bytes, so that the
+ * operations only allocate as much memory as their results need. The SIMD kernels of the binary
+ * conversion implementation are used for all operations.
+ */
+struct number {
+    big_integer *binary;
+};
+
+static number *create_number(big_integer *binary) {
+    number *value = malloc(sizeof(number));
+    check_alloc(value, sizeof(number), "number");
+    value->binary = binary;
+    return value;
+}
+
+number_system *create_checked_number_system(int base, const char *alph) {
+    // the binary conversion supports the bases in [-128; 128]
+    if ((base <= 1 && base >= -1) || base > 128 || base < -128 || alph == NULL) {
+        return NULL;
+    }
+
+    size_t length = strlen(alph);
+    if (length != (size_t) abs(base)) {
+        return NULL;
+    }
+    for (size_t i = 0; i < length; i++) {
+        if (!isprint((unsigned char) alph[i]) || (base > 0 && alph[i] == '-') ||
+            strchr(alph + i + 1, alph[i]) != NULL) {
+            return NULL;
+        }
+    }
+
+    return create_number_system(base, alph);
+}
+
+number *parse_number(const number_system *system, const char *z) {
+    bool negative = system->base > 0 && *z == '-';
+    if (negative) z++;
+
+    number *value = parse_number_of_length(system, z, strlen(z));
+    if (value != NULL && negative) negate_number(value);
+
+    return value;
+}
+
+number *parse_number_of_length(const number_system *system, const char *z, size_t length) {
+    if (length == 0 || find_invalid_digit(&system->tables, z, length) < length) {
+        return NULL;
+    }
+
+    big_integer *binary = create_big_integer(get_big_integer_min_size(system->base, length), false);
+    convert_number_from_any_base_into_binary(system, z, length, binary, NULL, true);
+
+    return create_number(binary);
+}
+
+number *number_operation(const number *a, const number *b, char op) {
+    uint64_t start = phase_start();
+    big_integer *a_binary = a->binary;
+    big_integer *b_binary = b->binary;
+    big_integer *result;
+
+    switch (op) {
+        case '+':
+        case '-':
+            // the sum/difference has at most one byte more than the bigger operand
+            result = create_big_integer(max(a_binary->used, b_binary->used) + 1, false);
+            copy_big_integer_value_into_another(a_binary, result);
+            if (op == '+') {
+                big_integer_addition(result, b_binary, true);
+            } else {
+                big_integer_subtraction(result, b_binary, true);
+            }
+            break;
+        case '*':
+            result = create_big_integer(a_binary->used + b_binary->used + 1, false);
+            big_integer_multiplication(a_binary, b_binary, result, true);
+            break;
+        default:
+            return NULL;
+    }
+
+    if (big_integer_is_zero(result, true)) {
+        result->sign = false;
+    }
+    count_event(COUNTER_OPERATIONS, 1);
+    phase_end(COUNTER_OPERATION_NS, start);
+
+    return create_number(result);
+}
+
+number *square_number(const number *value) {
+    uint64_t start = phase_start();
+    big_integer *binary = value->binary;
+    big_integer *result = create_big_integer(2 * binary->used + 1, false);
+    big_integer_square(binary, result, true);
+
+    count_event(COUNTER_OPERATIONS, 1);
+    phase_end(COUNTER_OPERATION_NS, start);
+
+    return create_number(result);
+}
+
+number *power_number(const number *value, uint64_t exponent) {
+    // |value| < 256^used, so the power has at most used * exponent bytes
+    size_t used = big_integer_used_bytes(value->binary);
+    if (exponent != 0 && used > (SIZE_MAX - 1) / exponent) return NULL;
+
+    uint64_t start = phase_start();
+    big_integer *result = create_big_integer(used * exponent + 1, false);
+    big_integer *temp = create_big_integer(result->length, false);
+    big_integer_power(value->binary, exponent, result, temp, true);
+    delete_big_integer(temp);
+
+    if (big_integer_is_zero(result, true)) {
+        result->sign = false;
+    }
+    count_event(COUNTER_OPERATIONS, 1);
+    phase_end(COUNTER_OPERATION_NS, start);
+
+    return create_number(result);
+}
+
+void negate_number(number *value) {
+    // zero is never negative
+    if (!big_integer_is_zero(value->binary, true)) {
+        value->binary->sign = !value->binary->sign;
+    }
+}
+
+size_t number_string_size(const number *value, const number_system *system) {
+    // log_|base|(2^bits) digits, one more digit for negative bases, sign and NULL byte
+    size_t bits = big_integer_used_bytes(value->binary) * 8;
+    return (size_t) ((double) bits / log2((double) system->base_abs)) + 4;
+}
+
+bool format_number(const number *value, const number_system *system, char *buffer,
+                   size_t buffer_length) {
+    size_t size = number_string_size(value, system);
+    if (buffer_length < size) {
+        return false;
+    }
+
+    // the conversion to negative bases divides the value
+    big_integer *binary = clone_big_integer(value->binary);
+    convert_big_integer_to_any_base(binary, system, buffer, size, NULL, true);
+    delete_big_integer(binary);
+
+    return true;
+}
+
+void delete_number(number *value) {
+    if (value == NULL) return;
+    delete_big_integer(value->binary);
+    free(value);
+}
+
+/*
+ * =====================================================================
+ * Tests
+ * =====================================================================
+ */
+
+#define LIBRARY_TEST_BUFFER_SIZE 64
+
+typedef struct {
+    int base;
+    const char *alph;
+    // the expression z1 op1 z2 op2 z3 is evaluated from left to right
+    const char *z1;
+    char op1;
+    const char *z2;
+    char op2;
+    const char *z3;
+    const char *expected;
+} Testcase_library;
+
+static bool test_library_executor(char *buffer, Testcase_library *t) {
+    number_system *system = create_checked_number_system(t->base, t->alph);
+    if (system == NULL) return false;
+
+    number *z1 = parse_number(system, t->z1);
+    number *z2 = parse_number(system, t->z2);
+    number *z3 = parse_number(system, t->z3);
+    number *intermediate = number_operation(z1, z2, t->op1);
+    number *result = number_operation(intermediate, z3, t->op2);
+
+    bool success = format_number(result, system, buffer, LIBRARY_TEST_BUFFER_SIZE) &&
+                   strcmp(buffer, t->expected) == 0;
+
+    // the operands are not changed by the operations
+    char operand[LIBRARY_TEST_BUFFER_SIZE];
+    success = success && format_number(z1, system, operand, sizeof(operand)) &&
+              strcmp(operand, t->z1) == 0;
+
+    delete_number(z1);
+    delete_number(z2);
+    delete_number(z3);
+    delete_number(intermediate);
+    delete_number(result);
+    delete_number_system(system);
+
+    return success;
+}
+
+static bool test_library_errors_executor(void *unused) {
+    (void) unused;
+
+    bool success = create_checked_number_system(1, "0") == NULL &&
+                   create_checked_number_system(10, "012345678") == NULL &&
+                   create_checked_number_system(3, "0-1") == NULL &&
+                   create_checked_number_system(-3, "010") == NULL &&
+                   create_checked_number_system(129, "0") == NULL;
+
+    number_system *system = create_checked_number_system(-3, "0-1");
+    success = success && system != NULL && parse_number(system, "") == NULL &&
+              parse_number(system, "012") == NULL;
+
+    number *value = parse_number(system, "-1");
+    success = success && value != NULL && number_operation(value, value, '/') == NULL;
+
+    // the buffer has to be big enough
+    char buffer[2];
+    success = success && !format_number(value, system, buffer, sizeof(buffer));
+
+    delete_number(value);
+    delete_number_system(system);
+
+    return success;
+}
+
+static bool test_library_square_executor(void *unused) {
+    (void) unused;
+
+    number_system *system = create_checked_number_system(10, "0123456789");
+    number *value = parse_number(system, "-123456789123456789");
+    number *copy = parse_number(system, "123456789123456789");
+
+    // squares, equal operands and the same operand in a multiplication have the same result
+    number *squares[] = {square_number(value), number_operation(value, value, '*'),
+                         number_operation(copy, copy, '*')};
+    number *negative = number_operation(value, copy, '*');
+
+    bool success = true;
+    char buffer[LIBRARY_TEST_BUFFER_SIZE];
+    for (size_t i = 0; i < sizeof(squares) / sizeof(squares[0]); i++) {
+        success = success && format_number(squares[i], system, buffer, sizeof(buffer)) &&
+                  strcmp(buffer, "15241578780673678515622620750190521") == 0;
+        delete_number(squares[i]);
+    }
+    success = success && format_number(negative, system, buffer, sizeof(buffer)) &&
+              strcmp(buffer, "-15241578780673678515622620750190521") == 0;
+
+    delete_number(negative);
+    delete_number(copy);
+    delete_number(value);
+    delete_number_system(system);
+
+    return success;
+}
+
+static bool test_library_power_executor(void *unused) {
+    (void) unused;
+
+    number_system *system = create_checked_number_system(-10, "0123456789");
+    // 19 is -1 and 18 is -2 in base -10
+    number *value = parse_number(system, "18");
+    number *minus_one = parse_number(system, "19");
+
+    const char *expected[] = {"1", "18", "4", "12", "196", "48", "144"};
+    bool success = true;
+    char buffer[LIBRARY_TEST_BUFFER_SIZE];
+    for (uint64_t exponent = 0; exponent < sizeof(expected) / sizeof(expected[0]); exponent++) {
+        number *power = power_number(value, exponent);
+        success = success && format_number(power, system, buffer, sizeof(buffer)) &&
+                  strcmp(buffer, expected[exponent]) == 0;
+        delete_number(power);
+    }
+
+    // odd powers of negative numbers are negative
+    number *power = power_number(minus_one, 99);
+    success = success && format_number(power, system, buffer, sizeof(buffer)) &&
+              strcmp(buffer, "19") == 0;
+
+    // the size of the power does not fit into a size_t
+    success = success && power_number(value, UINT64_MAX) == NULL;
+
+    delete_number(power);
+    delete_number(minus_one);
+    delete_number(value);
+    delete_number_system(system);
+
+    return success;
+}
+
+void library_test(void) {
+    TestResult tr = test_init("library", "chained operations on parsed numbers");
+
+    Testcase_library test_cases[] = {
+            {10, "0123456789", "12", '*', "34", '+', "5", "413"},
+            {10, "0123456789", "-12", '*', "34", '-', "-408", "0"},
+            {10, "0123456789", "99999999999999999999", '*', "99999999999999999999", '+', "-1",
+             "9999999999999999999800000000000000000000"},
+            {16, "0123456789abcdef", "-ff", '-', "1", '*', "100", "-10000"},
+            {-2, "01", "11", '+', "1", '*', "110", "0"},
+            {-10, "0123456789", "19", '*', "19", '+', "1", "2"},
+            {7, "abcdefg", "gg", '+', "b", '-', "baa", "a"},
+    };
+
+    int count = sizeof(test_cases) / sizeof(test_cases[0]);
+
+    char buffer[LIBRARY_TEST_BUFFER_SIZE];
+
+    for (int i = 0; i < count; i++) {
+        test_run_with_env(buffer, &test_cases[i], (void *) test_library_executor, &tr,
+                          "(%s %c %s) %c %s with base %i", "got %s", test_cases[i].z1,
+                          test_cases[i].op1, test_cases[i].z2, test_cases[i].op2, test_cases[i].z3,
+                          test_cases[i].base, buffer);
+    }
+
+    test_run(NULL, test_library_errors_executor, &tr, "invalid number systems and numbers", "");
+    test_run(NULL, test_library_square_executor, &tr, "squares of numbers", "");
+    test_run(NULL, test_library_power_executor, &tr, "powers of numbers", "");
+
+    test_finalize(tr);
+}
@@ -0,0 +1,129 @@
+#ifndef LIBRARY_H
+#define LIBRARY_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "implementations/impl_binary_conversion/instrumentation.h"
+
+/**
+ * The library interface (libintegerbase.a): numbers are parsed once into an opaque binary handle,
+ * any number of operations work on the binary values and the results are only formatted on demand.
+ * All numbers are independent of their number system, so they can be formatted in any other one.
+ *
+ * The parsing, operations and formatting count towards the statistics of the binary conversion
+ * backend: set_instrumentation_enabled(true) starts them and get_binary_conversion_stats returns
+ * them (see instrumentation.h).
+ */
+
+/* The base and alphabet of the numbers (see number_system.h) */
+typedef struct number_system number_system;
+
+/* An opaque (binary) number */
+typedef struct number number;
+
+/**
+ * @brief Create the number system with the given base and alphabet
+ *
+ * @param base  The base           base > 1 || base < -1, abs(base) <= 128
+ * @param alph  The alphabet       Printable ASCII characters, len(alph) == abs(base), no duplicate
+ *                                 values and no '-' if base > 0. It is copied.
+ * @return      The number system (delete it with delete_number_system) or NULL if the base or the
+ *              alphabet is invalid
+ */
+number_system *create_checked_number_system(int base, const char *alph);
+
+void delete_number_system(number_system *system);
+
+/**
+ * @brief Parse a number
+ *
+ * @param system    The number system of z
+ * @param z         The number, it may start with '-' if the base is positive
+ * @return          The number (delete it with delete_number) or NULL if z is empty or contains
+ *                  characters that are not in the alphabet
+ */
+number *parse_number(const number_system *system, const char *z);
+
+/**
+ * @brief Parse the given number of digits (without sign)
+ *
+ * @param system    The number system of the digits
+ * @param z         The digits (they do not have to be NULL terminated)
+ * @param length    The number of digits
+ * @return          The number (delete it with delete_number) or NULL if there are no digits or
+ *                  characters that are not in the alphabet
+ */
+number *parse_number_of_length(const number_system *system, const char *z, size_t length);
+
+/**
+ * @brief Calculate a op b
+ *
+ * @param a     The first operand
+ * @param b     The second operand
+ * @param op    The operator ('+', '-' or '*')
+ * @return      The result (delete it with delete_number) or NULL if op is invalid
+ */
+number *number_operation(const number *a, const number *b, char op);
+
+/**
+ * @brief Calculate value * value
+ *
+ * Every cross product of the digits is only computed once, so this is about twice as fast as a
+ * multiplication of two different numbers (number_operation squares equal operands as well).
+ *
+ * @param value The number
+ * @return      The square (delete it with delete_number)
+ */
+number *square_number(const number *value);
+
+/**
+ * @brief Calculate value^exponent
+ *
+ * The power is calculated with square-and-multiply on the binary value (value^0 is 1).
+ *
+ * @param value     The base of the power
+ * @param exponent  The exponent
+ * @return          The power (delete it with delete_number) or NULL if its size does not fit into
+ *                  a size_t
+ */
+number *power_number(const number *value, uint64_t exponent);
+
+/**
+ * @brief Negate a number (in-place)
+ */
+void negate_number(number *value);
+
+/**
+ * @brief Get the size of a buffer that is big enough for the formatted number
+ *
+ * @param value     The number
+ * @param system    The number system in which the number shall be formatted
+ * @return          The buffer size (including the NULL byte)
+ */
+size_t number_string_size(const number *value, const number_system *system);
+
+/**
+ * @brief Format a number
+ *
+ * @param value             The number
+ * @param system            The number system in which the number shall be formatted
+ * @param buffer            The buffer for the NULL terminated string
+ * @param buffer_length     The size of the buffer, at least number_string_size(value, system)
+ * @return                  false if the buffer is too small (nothing is written then)
+ */
+bool format_number(const number *value, const number_system *system, char *buffer,
+                   size_t buffer_length);
+
+/**
+ * @brief Delete a number (NULL is ignored)
+ */
+void delete_number(number *value);
+
+/**
+ * @brief Runs the tests of the library interface
+ */
+void library_test(void);
+
+#endif
@@ -1,4 +1,5 @@
 #include <ctype.h>
+#include <errno.h>
 #include <getopt.h>
 #include <stdarg.h>
 #include <stdbool.h>
@@ -6,40 +7,73 @@
 #include <string.h>
 #include <stdint.h>
 
+#include "batch.h"
 #include "bench.h"
+#include "expression.h"
 #include "implementations.h"
+#include "implementations/impl_binary_conversion/instrumentation.h"
+#include "implementations/number_system.h"
+#include "implementations/thread_pool.h"
+#include "mapped_file.h"
+#include "stress.h"
 #include "test.h"
 #include "util.h"
 
 static char *default_alph = NULL;  // Default (0..9) gets generated if necessary
 static char *result = NULL;
 
+// Operands and result that are mapped from/into files
+static mapped_file operand_files[2];
+static size_t operand_file_count = 0;
+static mapped_file result_file = {NULL, 0, -1};
+
+#define MAX_THREADS 1024  // more threads than this are certainly a typo
+
 // Defining the long_option help
 static struct option long_options[] = {{"help", no_argument, NULL, 'h'},
                                        {NULL, 0,             NULL, 0}};
 
-const char *about_msg = "This program calculates the sum/difference/product of two numbers.\n";
+const char *about_msg =
+        "This program calculates the sum/difference/product/power of two numbers.\n";
 
-/// Format string expects char*, size_t, 8*(char*) (progname, IMPLEMENTATIONS_COUNT - 1, 8*progname)
+/// Format string expects char*, size_t, char*, size_t, 2*(char*), size_t, char*, size_t,
+/// 16*(char*) (progname, IMPLEMENTATIONS_COUNT - 1, progname, IMPLEMENTATIONS_COUNT - 1,
+/// 2*progname, IMPLEMENTATIONS_COUNT - 1, progname, IMPLEMENTATIONS_COUNT - 1, 16*progname)
 static const char *usage_msg =
         "Usage:\n"
-        "  %s [-o (+|-|*)] [-b <base>] [-a <alphabet>] [-V (0-%zu)] [-B[<repetitions>]] z1 z2\n"
+        "  %s [-o (+|-|*|^)] [-b <base>] [-a <alphabet>] [-V (0-%zu)] [-B[<repetitions>]] "
+        "[-j <threads>] [-P] z1 z2\n"
+        "  %s [-o (+|-|*|^)] [-b <base>] [-a <alphabet>] [-V (0-%zu)] [-w <file>] -i <file> [-i "
+        "<file> | z2]\n"
+        "  %s [-b <base>] [-a <alphabet>] -e <expression>\n"
+        "  %s [-b <base>] [-a <alphabet>] [-V (0-%zu)] [-j <threads>] -f <file>\n"
+        "  %s [-o (+|-|*|^)] [-b <base>] [-a <alphabet>] [-V (0-%zu)] [-B<repetitions>] [-J] "
+        "-S[<digits>]\n"
+        "  %s [-o (+|-|*|^)] [-b <base>] [-a <alphabet>] [-B<operations>] [-j <threads>] "
+        "[-s <seed>] -F[<digits>]\n"
         "  %s -t [-V <impl>]\n"
+        "  %s -T\n"
         "  %s -l\n"
         "  %s -h | --help\n"
         "\n"
         "Examples:\n"
         "  %s 100 50\n"
         "  %s -V 1 -o '*' -b 5 24 10\n"
+        "  %s -o '^' 2 100\n"
         "  %s -a abcdefg -b 7 -o - -- -abc dfg\n"
         "  %s -B10 100 50\n"
+        "  %s -e '(12 + 3) * -4 - 5'\n"
+        "  %s -j 4 -f - < operations.txt\n"
+        "  %s -o '*' -i a.txt -i b.txt -w product.txt\n"
+        "  %s -V 4 -o '*' -J -S100000\n"
+        "  %s -j 4 -B500 -F100000\n"
         "  %s -V 0 -t\n";
 
 /// Format string expects size_t char* (IMPLEMENTATIONS_COUNT - 1, progname)
 static const char *help_msg =
         "Arguments:\n"
-        "  z1                  Operand 1 (augend/subtrahend/multiplicand).\n"
-        "  z2                  Operand 2 (addend/minuend/multiplier).\n"
+        "  z1                  Operand 1 (augend/subtrahend/multiplicand/base of the power).\n"
+        "  z2                  Operand 2 (addend/minuend/multiplier/exponent).\n"
         "                      The operands must not contain any characters not contained in the "
         "alphabet.\n"
         "                      If there are negative operands, separate them from all other arguments "
@@ -50,7 +84,19 @@ static const char *help_msg =
         "  -t                  Run tests.\n"
         "                      If no implementation is specified, all implementations will be tested.\n"
         "  -b <base>           The base (|base| > 1). [default: 10]\n"
-        "  -o (+|-|*)          The operator. [default: +]\n"
+        "  -o (+|-|*|^)        The operator. [default: +]\n"
+        "                      The exponent of ^ (power) must not be negative.\n"
+        "  -e <expression>     Evaluate an expression of numbers, +, -, *, parentheses and spaces.\n"
+        "                      The intermediate results stay in binary until the end.\n"
+        "                      The alphabet must not contain any of these characters.\n"
+        "  -i <file>           Read an operand from the file (can be given twice, the positional\n"
+        "                      operands follow). Only the result is printed.\n"
+        "  -w <file>           Write the result into the file instead of printing it.\n"
+        "  -f <file>           Calculate one operation \"z1 op z2\" per line of the file (- for "
+        "stdin).\n"
+        "  -j <threads>        The number of threads (1-1024). [default: 1]\n"
+        "                      With -f, the lines are distributed among the threads, otherwise big\n"
+        "                      multiplications and conversions are split across them.\n"
         "  -a <alphabet>       The alphabet. (mandatory if |base| > 10) [default: \"0123456789\"]\n"
         "                      The length of the alphabet must be equal to |base|.\n"
         "                      The alphabet has to consist of printable ASCII characters\n"
@@ -59,11 +105,31 @@ static const char *help_msg =
         // directly after the option character if present.
         "  -B[<repetitions>]   Measure runtime.\n"
         "                      Repeat the calculation as often as specified. [default: 3]\n"
+        "  -P                  Print the phase timings, allocations and kernel counts of the binary\n"
+        "                      conversion backend (-V 0/1, -e, -f) to stderr.\n"
+        "  -S[<digits>]        Run the benchmark suite on random operands of 10, 30, 100, ... digits\n"
+        "                      up to the given length. [default: 10000000]\n"
+        "                      All implementations, bases (2, 10, 16, 64, -2, -10) and operators\n"
+        "                      are measured unless -V, -b or -o is given. -B sets the maximum number\n"
+        "                      of measurements per length. [default: 20]\n"
+        "                      The results are written as CSV.\n"
+        "  -J                  Write the results of the benchmark suite as JSON.\n"
+        "  -F[<digits>]        Cross-check all implementations on random operations with operands of\n"
+        "                      up to the given length. [default: 10000]\n"
+        "                      Random bases, alphabets and operators are used unless -b or -o is\n"
+        "                      given. -B sets the number of operations [default: 1000], -j the\n"
+        "                      number of threads that calculate them.\n"
+        "  -s <seed>           The seed of the random operations of -F. [default: 1]\n"
+        "  -T                  Measure the crossover lengths of the auto implementation and write\n"
+        "                      them as the header auto_thresholds.h to stdout (see make tune).\n"
         "  -l                  List all implementations and exit.\n";
 
 static void print_usage(const char *progname, FILE *stream) {
-    fprintf(stream, usage_msg, progname, IMPLEMENTATIONS_COUNT - 1, progname, progname, progname,
-            progname, progname, progname, progname, progname);
+    fprintf(stream, usage_msg, progname, IMPLEMENTATIONS_COUNT - 1, progname,
+            IMPLEMENTATIONS_COUNT - 1, progname, progname, IMPLEMENTATIONS_COUNT - 1, progname,
+            IMPLEMENTATIONS_COUNT - 1, progname, progname, progname, progname, progname, progname,
+            progname, progname, progname, progname, progname, progname, progname, progname,
+            progname, progname);
 }
 
 /**
@@ -95,9 +161,27 @@ static void list_impls() {
     }
 }
 
+/**
+ * @brief Print the statistics of the binary conversion backend to stderr if they were collected
+ */
+static void print_statistics(bool statistics) {
+    if (statistics) {
+        binary_conversion_stats stats = get_binary_conversion_stats();
+        print_binary_conversion_stats(&stats, stderr);
+    }
+}
+
 static void cleanup() {
     free(default_alph);
-    free(result);
+    if (result_file.fd != -1) {
+        unmap_file(&result_file);
+    } else if (result_file.data == NULL) {
+        free(result);
+    }
+    for (size_t i = 0; i < operand_file_count; i++) {
+        unmap_file(&operand_files[i]);
+    }
+    thread_pool_set_threads(1);
 }
 
 /**
@@ -202,23 +286,63 @@ static void check_numbers(const char *progname, const char *z1, const char *z2,
     }
 
     // Check if every character of the numbers is in the alphabet
-    for (size_t i = 0; i < len1; i++) {
-        if (strchr(alph, z1[i]) == NULL) {
-            exit_err_msg(progname,
-                         "The first number contains characters that are not in the alphabet: "
-                         "\"%s\" does not contain '%c'.\n",
-                         alph, z1[i]);
-        }
+    const digit_tables *tables = &get_number_system(base, alph)->tables;
+
+    size_t invalid = find_invalid_digit(tables, z1, len1);
+    if (invalid < len1) {
+        exit_err_msg(progname,
+                     "The first number contains characters that are not in the alphabet: "
+                     "\"%s\" does not contain '%c'.\n",
+                     alph, z1[invalid]);
     }
 
-    for (size_t i = 0; i < len2; i++) {
-        if (strchr(alph, z2[i]) == NULL) {
-            exit_err_msg(progname,
-                         "The second number contains characters that are not in the alphabet: "
-                         "\"%s\" does not contain '%c'.\n",
-                         alph, z2[i]);
+    invalid = find_invalid_digit(tables, z2, len2);
+    if (invalid < len2) {
+        exit_err_msg(progname,
+                     "The second number contains characters that are not in the alphabet: "
+                     "\"%s\" does not contain '%c'.\n",
+                     alph, z2[invalid]);
+    }
+}
+
+/**
+ * @brief Evaluate an expression and print its result
+ *
+ * @param progname      The name of the program (argv[0])
+ * @param expression    The expression
+ * @param alph          The (valid) alphabet
+ * @param base          The (valid) base
+ */
+static void evaluate(const char *progname, const char *expression, const char *alph, int base) {
+    for (const char *c = alph; *c != '\0'; c++) {
+        if (is_expression_symbol(*c)) {
+            exit_err_msg(progname, "The alphabet must not contain '%c' in the expression mode.\n",
+                         *c);
         }
     }
+
+    number_system *system = create_checked_number_system(base, alph);
+    if (system == NULL) {
+        exit_err_msg(progname, "Invalid base: %d\n", base);
+    }
+
+    size_t error_position;
+    number *value = evaluate_expression(system, expression, &error_position);
+    if (value == NULL) {
+        delete_number_system(system);
+        exit_err_msg(progname, "Invalid expression at position %zu: \"%s\"\n", error_position,
+                     expression);
+    }
+
+    size_t buffer_size = number_string_size(value, system);
+    result = malloc(buffer_size);
+    check_alloc(result, buffer_size, "result buffer");
+    format_number(value, system, result, buffer_size);
+
+    fprintf(stdout, "%s = %s\n", expression, result);
+
+    delete_number(value);
+    delete_number_system(system);
 }
 
 int main(int argc, char **argv) {
@@ -226,19 +350,33 @@ int main(int argc, char **argv) {
     const char *progname = argv[0];
 
     bool test = false;
+    bool statistics = false;
     bool benchmark = false;
     size_t benchmark_repetitions = 3;  // Default, 3 repetitions for the benchmark tests
+    bool benchmark_repetitions_specified = false;
+    bool suite = false;
+    bench_suite_options suite_options = {10000000, 20, -1, 0, NULL, '\0', false};
+    bool stress = false;
+    stress_test_options stress_options = {1000, 10000, 1, 1, 0, NULL, '\0'};
 
     char operator = '+';  // Default operator: +
     char *alph = NULL;   // Default (0..9) gets generated if necessary
     int base = 10;       // Default base: 10
+    bool operator_specified = false;
+    bool base_specified = false;
+    char *expression = NULL;
+    char *batch_file = NULL;
+    size_t thread_count = 1;
+    char *operand_paths[2];
+    size_t operand_path_count = 0;
+    char *result_path = NULL;
 
     bool implementation_specified =
             false;  // This flag is used for testing because if no impl is specified we test all impls
     size_t implementation = 0;  // Default use the main implementation
 
     int opt;
-    while ((opt = getopt_long(argc, argv, ":V:B::b:a:o:tlh", long_options, NULL)) != -1) {
+    while ((opt = getopt_long(argc, argv, ":V:B::S::F::s:b:a:o:e:f:j:i:w:JPtTlh", long_options, NULL)) != -1) {
         switch (opt) {
             case 'V':
                 implementation_specified = true;
@@ -248,20 +386,75 @@ int main(int argc, char **argv) {
                 benchmark = true;
                 if (optarg != NULL) {
                     benchmark_repetitions = strtoull(optarg, NULL, 10);
+                    benchmark_repetitions_specified = true;
                 }
                 break;
+            case 'S':
+                suite = true;
+                if (optarg != NULL) {
+                    suite_options.max_length = strtoull(optarg, NULL, 10);
+                }
+                break;
+            case 'F':
+                stress = true;
+                if (optarg != NULL) {
+                    stress_options.max_length = strtoull(optarg, NULL, 10);
+                }
+                break;
+            case 's':
+                stress_options.seed = strtoull(optarg, NULL, 10);
+                break;
+            case 'J':
+                suite_options.json = true;
+                break;
+            case 'P':
+                statistics = true;
+                break;
             case 'b':
                 base = (int) strtol(optarg, NULL, 10);
+                base_specified = true;
                 break;
             case 'a':
                 alph = optarg;
                 break;
             case 'o':
                 operator = *optarg;
+                operator_specified = true;
+                break;
+            case 'e':
+                expression = optarg;
+                break;
+            case 'f':
+                batch_file = optarg;
+                break;
+            case 'j': {
+                char *end;
+                errno = 0;
+                unsigned long long threads = strtoull(optarg, &end, 10);
+                // strtoull accepts a sign, so "-1" would wrap around
+                if (!isdigit((unsigned char) *optarg) || *end != '\0' || errno != 0 ||
+                    threads == 0 || threads > MAX_THREADS) {
+                    exit_err_msg(progname, "Invalid number of threads: %s (1-%d)\n", optarg,
+                                 MAX_THREADS);
+                }
+                thread_count = threads;
+                break;
+            }
+            case 'i':
+                if (operand_path_count == 2) {
+                    exit_err_msg(progname, "There can be at most 2 operand files.\n");
+                }
+                operand_paths[operand_path_count++] = optarg;
+                break;
+            case 'w':
+                result_path = optarg;
                 break;
             case 't':
                 test = 1;
                 break;
+            case 'T':
+                bench_tune(stdout);
+                return EXIT_SUCCESS;
             case 'h':
                 print_help(progname);
                 return EXIT_SUCCESS;
@@ -295,7 +488,7 @@ int main(int argc, char **argv) {
     }
 
     // Check if the operator is valid
-    if (!(operator == '+' || operator == '*' || operator == '-')) {
+    if (!(operator == '+' || operator == '*' || operator == '-' || operator == '^')) {
         exit_err_msg(progname, "Invalid operator: '%c'\n", operator);
     }
 
@@ -323,19 +516,104 @@ int main(int argc, char **argv) {
         check_alphabet(progname, alph, base);
     }
 
-    // Read the positional arguments (z1, z2)
-    char *z1;
-    char *z2;
+    set_instrumentation_enabled(statistics);
 
-    if (optind == argc - 2) {
-        z1 = argv[optind];
-        z2 = argv[optind + 1];
-    } else {
-        // incorrect number of positional arguments were passed
-        exit_err_msg(progname, "The program expects 2 operands but %i arguments were passed.\n",
-                     (argc - optind));
+    if (batch_file != NULL) {
+        if (optind != argc) {
+            exit_err_msg(progname, "The batch mode expects no operands but %i were passed.\n",
+                         (argc - optind));
+        }
+
+        FILE *input = strcmp(batch_file, "-") == 0 ? stdin : fopen(batch_file, "r");
+        if (input == NULL) {
+            exit_err_msg(progname, "Could not open the file \"%s\".\n", batch_file);
+        }
+        bool success = run_batch(input, implementations[implementation], base, alph, thread_count);
+        if (input != stdin) fclose(input);
+        print_statistics(statistics);
+
+        cleanup();
+        return success ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    if (stress) {
+        if (optind != argc) {
+            exit_err_msg(progname, "The stress test expects no operands but %i were passed.\n",
+                         (argc - optind));
+        }
+        if (stress_options.max_length == 0) {
+            exit_err_msg(progname, "The stress test needs operands of at least 1 digit.\n");
+        }
+        if (operator_specified) stress_options.op = operator;
+        if (base_specified) {
+            stress_options.base = base;
+            stress_options.alph = alph;
+        }
+        if (benchmark_repetitions_specified) stress_options.operations = benchmark_repetitions;
+        stress_options.threads = thread_count;
+        bool success = stress_test(&stress_options, stdout);
+        cleanup();
+        return success ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    // Big operations are split across the threads
+    thread_pool_set_threads(thread_count);
+
+    if (suite) {
+        if (optind != argc) {
+            exit_err_msg(progname, "The benchmark suite expects no operands but %i were passed.\n",
+                         (argc - optind));
+        }
+        if (operator == '^') {
+            exit_err_msg(progname, "The benchmark suite does not measure powers.\n");
+        }
+        if (suite_options.max_length < 10) {
+            exit_err_msg(progname, "The benchmark suite needs operands of at least 10 digits.\n");
+        }
+        if (implementation_specified) suite_options.implementation = (int) implementation;
+        if (operator_specified) suite_options.op = operator;
+        if (base_specified) {
+            suite_options.base = base;
+            suite_options.alph = alph;
+        }
+        if (benchmark_repetitions_specified) suite_options.repetitions = benchmark_repetitions;
+        bench_suite(&suite_options, stdout);
+        cleanup();
+        return EXIT_SUCCESS;
     }
 
+    if (expression != NULL) {
+        if (optind != argc) {
+            exit_err_msg(progname, "The expression mode expects no operands but %i were passed.\n",
+                         (argc - optind));
+        }
+        evaluate(progname, expression, alph, base);
+        print_statistics(statistics);
+        cleanup();
+        return EXIT_SUCCESS;
+    }
+
+    // Read the operands (z1, z2): the operand files first, then the positional arguments
+    if (operand_path_count + (argc - optind) != 2) {
+        // incorrect number of operands were passed
+        exit_err_msg(progname, "The program expects 2 operands but %i were passed.\n",
+                     (int) operand_path_count + (argc - optind));
+    }
+
+    char *operands[2];
+    for (size_t i = 0; i < operand_path_count; i++) {
+        if (map_operand_file(operand_paths[i], &operand_files[i]) == -1) {
+            exit_err_msg(progname, "Could not read the operand file \"%s\": %s\n",
+                         operand_paths[i], strerror(errno));
+        }
+        operands[operand_file_count++] = operand_files[i].data;
+    }
+    for (size_t i = operand_file_count; i < 2; i++) {
+        operands[i] = argv[optind++];
+    }
+    char *z1 = operands[0];
+    char *z2 = operands[1];
+
     // Check if the numbers are valid
     check_numbers(progname, z1, z2, alph, base);
 
@@ -343,11 +621,33 @@ int main(int argc, char **argv) {
     size_t buffer_size;
     if (operator == '+' || operator == '-') {
         buffer_size = max_needed_chars_add_sub(z1, z2);
-    } else {
+    } else if (operator == '*') {
         buffer_size = max_needed_chars_mul(z1, z2);
+    } else {
+        uint64_t exponent;
+        exponent_status status =
+                parse_exponent(get_number_system(base, alph), z2, UINT64_MAX, &exponent);
+        if (status == EXPONENT_NEGATIVE) {
+            exit_err_msg(progname, "The exponent must not be negative.\n");
+        } else if (status == EXPONENT_TOO_BIG) {
+            exit_err_msg(progname, "The exponent is too big.\n");
+        }
+        buffer_size = max_needed_chars_pow(z1, exponent);
+        if (buffer_size == 0) {
+            exit_err_msg(progname, "The power %s ^ %s is too big.\n", z1, z2);
+        }
     }
 
-    result = malloc(buffer_size + 1);
+    if (result_path != NULL) {
+        // the result is written straight into the file, it is cut off after the result at the end
+        if (map_result_file(result_path, buffer_size + 1, &result_file) == -1) {
+            exit_err_msg(progname, "Could not create the result file \"%s\": %s\n", result_path,
+                         strerror(errno));
+        }
+        result = result_file.data;
+    } else {
+        result = malloc(buffer_size + 1);
+    }
 
     if (result == NULL) {
         fprintf(stderr, "Could not allocate memory for the result buffer.\n");
@@ -368,7 +668,19 @@ int main(int argc, char **argv) {
         implementations[implementation].func(base, alph, z1, z2, operator, result);
     }
 
-    fprintf(stdout, "%s %c %s = %s\n", z1, operator, z2, result);
+    if (result_path != NULL) {
+        if (finish_result_file(&result_file) == -1) {
+            fprintf(stderr, "Could not write the result file \"%s\": %s\n", result_path,
+                    strerror(errno));
+            cleanup();
+            return EXIT_FAILURE;
+        }
+    } else if (operand_file_count > 0) {
+        fprintf(stdout, "%s\n", result);
+    } else {
+        fprintf(stdout, "%s %c %s = %s\n", z1, operator, z2, result);
+    }
+    print_statistics(statistics);
 
     cleanup();
     return EXIT_SUCCESS;
@@ -0,0 +1,92 @@
+// MAP_ANONYMOUS is not part of POSIX
+#define _DEFAULT_SOURCE
+
+#include "mapped_file.h"
+
+#include <ctype.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+int map_operand_file(const char *path, mapped_file *file) {
+    int fd = open(path, O_RDONLY);
+    if (fd == -1) return -1;
+
+    struct stat st;
+    if (fstat(fd, &st) == -1) {
+        close(fd);
+        return -1;
+    }
+    size_t length = st.st_size;
+
+    // the NULL byte is behind the end of the file if it fills its last page: the file is mapped
+    // over an anonymous (zeroed) mapping that is one byte longer
+    file->size = length + 1;
+    file->data = mmap(NULL, file->size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (file->data == MAP_FAILED) {
+        close(fd);
+        return -1;
+    }
+    if (length > 0 && mmap(file->data, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd,
+                           0) == MAP_FAILED) {
+        int error = errno;
+        munmap(file->data, file->size);
+        close(fd);
+        errno = error;
+        return -1;
+    }
+    close(fd);
+    file->fd = -1;
+
+    // the digits are read once from the beginning to the end
+    posix_madvise(file->data, file->size, POSIX_MADV_SEQUENTIAL);
+
+    while (length > 0 && isspace((unsigned char) file->data[length - 1])) {
+        length--;
+    }
+    file->data[length] = '\0';
+
+    return 0;
+}
+
+int map_result_file(const char *path, size_t size, mapped_file *file) {
+    int fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd == -1) return -1;
+
+    char *data = MAP_FAILED;
+    if (ftruncate(fd, size) == 0) {
+        data = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    if (data == MAP_FAILED) {
+        int error = errno;
+        close(fd);
+        errno = error;
+        return -1;
+    }
+
+    file->data = data;
+    file->size = size;
+    file->fd = fd;
+    return 0;
+}
+
+int finish_result_file(mapped_file *file) {
+    size_t length = strnlen(file->data, file->size);
+
+    munmap(file->data, file->size);
+    int result = ftruncate(file->fd, length);
+    int error = errno;
+    close(file->fd);
+    file->fd = -1;
+
+    errno = error;
+    return result;
+}
+
+void unmap_file(mapped_file *file) {
+    munmap(file->data, file->size);
+    if (file->fd != -1) close(file->fd);
+}
@@ -0,0 +1,47 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <stddef.h>
+
+/**
+ * A file that is mapped into memory. The operand files are mapped privately (the changes are not
+ * written back), the result file is mapped shared.
+ */
+typedef struct mapped_file {
+    char *data;
+    size_t size;  // the size of the mapping
+    int fd;       // -1 if the file is closed already
+} mapped_file;
+
+/**
+ * @brief Map an operand file as a NULL terminated string
+ *
+ * The trailing whitespace (e.g. the newline at the end of the file) is cut off. The file is not
+ * copied, only the last page is copied on write to place the NULL byte.
+ *
+ * @param path  The path of the file
+ * @param file  The mapped file (the operand is file->data)
+ * @return      0 if successful, otherwise -1 (errno is set)
+ */
+int map_operand_file(const char *path, mapped_file *file);
+
+/**
+ * @brief Create (or truncate) the result file and map the given number of bytes of it
+ *
+ * @param path  The path of the file
+ * @param size  The maximum size of the result (including the NULL byte)
+ * @param file  The mapped file (the result buffer is file->data)
+ * @return      0 if successful, otherwise -1 (errno is set)
+ */
+int map_result_file(const char *path, size_t size, mapped_file *file);
+
+/**
+ * @brief Unmap the result file and cut it off after the NULL terminated result
+ *
+ * @return  0 if successful, otherwise -1 (errno is set)
+ */
+int finish_result_file(mapped_file *file);
+
+void unmap_file(mapped_file *file);
+
+#endif
@@ -0,0 +1,303 @@
+#include "stress.h"
+
+#include <inttypes.h>
+#include <limits.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "implementations.h"
+#include "util.h"
+
+#define STRESS_MAX_EXPONENT 12
+#define STRESS_PRINT_LENGTH 100  // longer operands of mismatches are not printed
+
+static const char stress_operators[] = {'+', '-', '*', '^'};
+
+/**
+ * The state of the stress test. Every thread has its own times and its own count of input digits,
+ * they are summed up at the end.
+ */
+typedef struct stress {
+    const stress_test_options *options;
+    FILE *out;
+    atomic_size_t next_operation;
+    atomic_size_t mismatches;
+    pthread_mutex_t out_lock;
+    long double *times;  // thread * IMPLEMENTATIONS_COUNT + implementation
+    size_t *digits;
+} stress;
+
+static long double current_time() {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9L;
+}
+
+/**
+ * splitmix64, the operations only depend on the seed and their index
+ */
+static uint64_t next_random(uint64_t *state) {
+    uint64_t z = (*state += 0x9E3779B97F4A7C15);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+    return z ^ (z >> 31);
+}
+
+/**
+ * @brief A random length between 1 and max_length, short and long operands are equally likely
+ */
+static size_t random_length(size_t max_length, uint64_t *state) {
+    unsigned int bits = 64 - __builtin_clzll(max_length);
+    size_t limit = (size_t) 1 << (next_random(state) % bits);
+    size_t length = 1 + next_random(state) % limit;
+    return length < max_length ? length : max_length;
+}
+
+/**
+ * @brief Fill alph with base_abs random printable chars (neither '-' nor ' ')
+ */
+static void random_alph(char *alph, size_t base_abs, uint64_t *state) {
+    char chars[94];
+    size_t count = 0;
+    for (char c = '!'; c <= '~'; c++) {
+        if (c != '-') chars[count++] = c;
+    }
+    // the first base_abs chars of a Fisher-Yates shuffle
+    for (size_t i = 0; i < base_abs; i++) {
+        size_t j = i + next_random(state) % (count - i);
+        char c = chars[i];
+        chars[i] = chars[j];
+        chars[j] = c;
+        alph[i] = chars[i];
+    }
+    alph[base_abs] = '\0';
+}
+
+/**
+ * @brief Fill z with a random number of length digits (mostly without leading zeros)
+ */
+static void random_operand(char *z, size_t length, int base, const char *alph, uint64_t *state) {
+    size_t base_abs = abs(base);
+    if (base > 0 && next_random(state) % 2 == 0) *z++ = '-';
+    for (size_t i = 0; i < length; i++) {
+        z[i] = alph[next_random(state) % base_abs];
+    }
+    if (length > 1 && next_random(state) % 8 != 0 && z[0] == alph[0]) z[0] = alph[1];
+    z[length] = '\0';
+}
+
+/**
+ * @brief Write the (small) value in the base into z
+ */
+static void write_value(uint64_t value, int base, const char *alph, char *z) {
+    char digits[128];
+    size_t count = 0;
+    int64_t n = (int64_t) value;
+    do {
+        int64_t remainder = n % base;
+        n /= base;
+        // the digits of negative bases must not be negative either
+        if (remainder < 0) {
+            remainder += abs(base);
+            n++;
+        }
+        digits[count++] = alph[remainder];
+    } while (n != 0);
+    for (size_t i = 0; i < count; i++) {
+        z[i] = digits[count - 1 - i];
+    }
+    z[count] = '\0';
+}
+
+static void report_mismatch(stress *s, size_t index, int base, const char *alph, const char *z1,
+                            char op, const char *z2, char *const *results) {
+    atomic_fetch_add(&s->mismatches, 1);
+    pthread_mutex_lock(&s->out_lock);
+
+    size_t length_1 = strlen(z1);
+    size_t length_2 = strlen(z2);
+    fprintf(s->out,
+            "Mismatch in operation %zu (seed %" PRIu64 "): %zu digits %c %zu digits in base %d "
+            "(alphabet \"%s\")\n",
+            index, s->options->seed, length_1, op, length_2, base, alph);
+    if (length_1 <= STRESS_PRINT_LENGTH && length_2 <= STRESS_PRINT_LENGTH) {
+        fprintf(s->out, "    \"%s\" %c \"%s\"\n", z1, op, z2);
+        for (size_t i = 0; i < IMPLEMENTATIONS_COUNT; i++) {
+            fprintf(s->out, "    [%s]: \"%s\"\n", implementations[i].name, results[i]);
+        }
+    } else {
+        for (size_t i = 1; i < IMPLEMENTATIONS_COUNT; i++) {
+            if (strcmp(results[0], results[i]) != 0) {
+                fprintf(s->out, "    [%s] differs from [%s]\n", implementations[i].name,
+                        implementations[0].name);
+            }
+        }
+    }
+    fflush(s->out);
+
+    pthread_mutex_unlock(&s->out_lock);
+}
+
+/**
+ * @brief Generate the operation with the given index and calculate it with all implementations
+ */
+static void stress_operation(stress *s, size_t thread, size_t index) {
+    const stress_test_options *options = s->options;
+    uint64_t state = options->seed ^ (index * 0xD1B54A32D192ED03);
+
+    char alph[UCHAR_MAX + 1];
+    int base = options->base;
+    if (base != 0) {
+        strcpy(alph, options->alph);
+    } else {
+        size_t base_abs = 2 + next_random(&state) % 92;
+        random_alph(alph, base_abs, &state);
+        base = next_random(&state) % 2 == 0 ? (int) base_abs : -(int) base_abs;
+    }
+    char op = options->op != '\0' ? options->op : stress_operators[next_random(&state) % 4];
+
+    size_t max_length = options->max_length;
+    uint64_t exponent = 0;
+    if (op == '^') {
+        // the power has at most max_length digits
+        exponent = next_random(&state) % (STRESS_MAX_EXPONENT + 1);
+        max_length = max_length / (exponent > 0 ? exponent : 1);
+        if (max_length == 0) max_length = 1;
+    }
+
+    size_t length_1 = random_length(max_length, &state);
+    size_t length_2 = op == '^' ? 0 : random_length(max_length, &state);
+    char *z1 = malloc(length_1 + 2);
+    check_alloc(z1, length_1 + 2, "stress operand");
+    char *z2 = malloc(op == '^' ? 128 : length_2 + 2);
+    check_alloc(z2, op == '^' ? 128 : length_2 + 2, "stress operand");
+    random_operand(z1, length_1, base, alph, &state);
+    if (op == '^') {
+        write_value(exponent, base, alph, z2);
+    } else {
+        random_operand(z2, length_2, base, alph, &state);
+    }
+
+    size_t result_size;
+    if (op == '+' || op == '-') {
+        result_size = max_needed_chars_add_sub(z1, z2) + 1;
+    } else if (op == '*') {
+        result_size = max_needed_chars_mul(z1, z2) + 1;
+    } else {
+        result_size = max_needed_chars_pow(z1, exponent) + 1;
+    }
+
+    char **results = malloc(IMPLEMENTATIONS_COUNT * sizeof(char *));
+    check_alloc(results, IMPLEMENTATIONS_COUNT * sizeof(char *), "stress results");
+    for (size_t i = 0; i < IMPLEMENTATIONS_COUNT; i++) {
+        results[i] = malloc(result_size);
+        check_alloc(results[i], result_size, "stress result");
+    }
+    for (size_t k = 0; k < IMPLEMENTATIONS_COUNT; k++) {
+        size_t i = (index + k) % IMPLEMENTATIONS_COUNT;
+        // an untimed warm-up call and an order that rotates per operation, otherwise the later
+        // implementations profit from the caches that the earlier ones warmed up
+        implementations[i].func(base, alph, z1, z2, op, results[i]);
+        long double t = current_time();
+        implementations[i].func(base, alph, z1, z2, op, results[i]);
+        s->times[thread * IMPLEMENTATIONS_COUNT + i] += current_time() - t;
+    }
+    s->digits[thread] += length_1 + length_2;
+
+    for (size_t i = 1; i < IMPLEMENTATIONS_COUNT; i++) {
+        if (strcmp(results[0], results[i]) != 0) {
+            report_mismatch(s, index, base, alph, z1, op, z2, results);
+            break;
+        }
+    }
+
+    for (size_t i = 0; i < IMPLEMENTATIONS_COUNT; i++) {
+        free(results[i]);
+    }
+    free(results);
+    free(z2);
+    free(z1);
+}
+
+typedef struct stress_thread {
+    stress *s;
+    size_t index;
+} stress_thread;
+
+static void *stress_worker(void *arg) {
+    stress_thread *t = arg;
+    size_t i;
+    while ((i = atomic_fetch_add(&t->s->next_operation, 1)) < t->s->options->operations) {
+        stress_operation(t->s, t->index, i);
+    }
+
+    release_thread_resources();
+    return NULL;
+}
+
+bool stress_test(const stress_test_options *options, FILE *out) {
+    size_t thread_count = options->threads < 1 ? 1 : options->threads;
+
+    stress s = {options, out, 0, 0, PTHREAD_MUTEX_INITIALIZER, NULL, NULL};
+    s.times = calloc(thread_count * IMPLEMENTATIONS_COUNT, sizeof(long double));
+    check_alloc(s.times, thread_count * IMPLEMENTATIONS_COUNT * sizeof(long double),
+                "stress times");
+    s.digits = calloc(thread_count, sizeof(size_t));
+    check_alloc(s.digits, thread_count * sizeof(size_t), "stress digits");
+
+    stress_thread *threads = malloc(thread_count * sizeof(stress_thread));
+    check_alloc(threads, thread_count * sizeof(stress_thread), "stress threads");
+    pthread_t *workers = malloc(thread_count * sizeof(pthread_t));
+    check_alloc(workers, thread_count * sizeof(pthread_t), "stress workers");
+
+    long double start = current_time();
+    // the main thread calculates operations as well
+    for (size_t i = 0; i < thread_count; i++) {
+        threads[i] = (stress_thread) {&s, i};
+        if (i > 0 && pthread_create(&workers[i], NULL, stress_worker, &threads[i]) != 0) {
+            abort_err("Could not create a stress test thread.\n");
+        }
+    }
+    while (atomic_load(&s.next_operation) < options->operations) {
+        size_t i = atomic_fetch_add(&s.next_operation, 1);
+        if (i < options->operations) stress_operation(&s, 0, i);
+    }
+    for (size_t i = 1; i < thread_count; i++) {
+        pthread_join(workers[i], NULL);
+    }
+    long double total = current_time() - start;
+
+    size_t digits = 0;
+    for (size_t t = 0; t < thread_count; t++) {
+        digits += s.digits[t];
+    }
+    fprintf(out, "%zu operations (%zu digits) with %zu threads in %.3Lf s:\n", options->operations,
+            digits, thread_count, total);
+    for (size_t i = 0; i < IMPLEMENTATIONS_COUNT; i++) {
+        long double time = 0;
+        for (size_t t = 0; t < thread_count; t++) {
+            time += s.times[t * IMPLEMENTATIONS_COUNT + i];
+        }
+        fprintf(out, "    [%s]: %.3Lf s, %.0Lf digits per second\n", implementations[i].name,
+                time, time > 0 ? digits / time : 0);
+    }
+
+    size_t mismatches = atomic_load(&s.mismatches);
+    if (mismatches == 0) {
+        fprintf(out, "All implementations calculated the same results.\n");
+    } else {
+        fprintf(out, "%zu of %zu operations had different results.\n", mismatches,
+                options->operations);
+    }
+
+    pthread_mutex_destroy(&s.out_lock);
+    free(workers);
+    free(threads);
+    free(s.digits);
+    free(s.times);
+
+    return mismatches == 0;
+}
@@ -0,0 +1,39 @@
+#ifndef STRESS_H
+#define STRESS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/**
+ * The parameters of the stress test. A base or operator of 0/'\0' means that random bases or
+ * operators are used.
+ */
+typedef struct stress_test_options {
+    size_t operations;  // the number of random operations
+    size_t max_length;  // the operands have 1 to max_length digits
+    size_t threads;     // the number of threads that calculate the operations (at least 1)
+    uint64_t seed;
+    int base;
+    const char *alph;  // the alphabet of base (only if base is given)
+    char op;
+} stress_test_options;
+
+/**
+ * @brief Cross-checks all implementations on random operations
+ *
+ * Every operation is calculated by all implementations and their results are compared with the
+ * result of the first one. The operations only depend on the seed and their index, so every
+ * mismatch can be reproduced with the same options. The operand lengths are distributed
+ * logarithmically between 1 and max_length digits, random bases have random alphabets. Every
+ * mismatch is reported together with its operands (if they are short enough), at the end the time
+ * and the throughput (input digits per second) of every implementation are written. Every
+ * implementation calculates each operation once untimed before the timed calculation.
+ *
+ * @param options   The parameters of the stress test
+ * @param out       The stream the mismatches and the throughput are written to
+ * @return          true if all implementations calculated the same results
+ */
+bool stress_test(const stress_test_options *options, FILE *out);
+
+#endif
@@ -3,7 +3,9 @@
 #include <stdarg.h>
 #include <stdio.h>
 
+#include "expression.h"
 #include "implementations/impl_tests.h"
+#include "library.h"
 
 static TestResult tr_static = {0, 0, ""};
 
@@ -136,6 +138,8 @@ void test_all_impls() {
     tr_static.title = "all";
 
     impl_tests_test_all();
+    library_test();
+    expression_test();
 
     print_result(tr_static);
 
@@ -1,6 +1,7 @@
 #include "util.h"
 
 #include <stdarg.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -18,10 +19,22 @@ size_t max_chars(const char *a, const char *b) {
     return n_a > n_b ? n_a : n_b;
 }
 
-size_t max_needed_chars_mul(const char *a, const char *b) { return max_chars(a, b) * 2 + 1; }
+size_t max_needed_chars_mul(const char *a, const char *b) {
+    // the product has at most as many digits as both operands together (one more in negative
+    // bases), the signs of the operands leave room for the sign of the product
+    return strlen(a) + strlen(b) + 1;
+}
 
 size_t max_needed_chars_add_sub(const char *a, const char *b) { return max_chars(a, b) + 2; }
 
+size_t max_needed_chars_pow(const char *a, uint64_t exponent) {
+    // a^exponent has at most exponent times as many digits as a (one more in negative bases), the
+    // sign of a leaves room for the sign of the power. The binary value has up to 8 bits per digit.
+    size_t length = strlen(a);
+    if (exponent != 0 && length > (SIZE_MAX / 8 - 1) / exponent) return 0;
+    return length * exponent + 1;
+}
+
 _Noreturn void abort_err(const char *fmt, ...) {
     va_list args;
     va_start(args, fmt);
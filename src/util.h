@@ -2,6 +2,7 @@
 #define UTIL_H
 
 #include <stddef.h>
+#include <stdint.h>
 
 /**
  * Takes two numbers of any (shared) base which may be prefixed by a sign and returns a number of
@@ -23,6 +24,16 @@ size_t max_needed_chars_add_sub(const char *a, const char *b);
  */
 size_t max_needed_chars_mul(const char *a, const char *b);
 
+/**
+ * Takes a number of any base which may be prefixed by a sign and a (non-negative) exponent and
+ * returns a number of chars that is guaranteed to be big enough to accommodate a^exponent
+ *
+ * @param a         The base of the power
+ * @param exponent  The exponent
+ * @return          The number of chars or 0 if a^exponent is too big for this program
+ */
+size_t max_needed_chars_pow(const char *a, uint64_t exponent);
+
 /**
  * @brief Check if allocation was successful, otherwise abort
  *